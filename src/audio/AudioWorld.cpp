@@ -22,6 +22,7 @@
 #include <daedalus/DaedalusGameState.h>
 #include <daedalus/DaedalusVM.h>
 #include <logic/ScriptEngine.h>
+#include <memory/AllocationTracker.h>
 #include <utils/logger.h>
 
 #include "engine/BaseEngine.h"
@@ -84,6 +85,8 @@ namespace World
 #ifdef RE_USE_SOUND
     void AudioWorld::initializeMusic()
     {
+        RE_ALLOCATION_SCOPE(Tag_Audio);
+
         std::string datPath = "/_work/data/Scripts/_compiled/MUSIC.DAT";
         std::string datFile = Utils::getCaseSensitivePath(datPath, m_Engine.getEngineArgs().gameBaseDirectory);
 
@@ -148,6 +151,8 @@ namespace World
 
     void AudioWorld::musicRenderFunction()
     {
+        RE_ALLOCATION_SCOPE(Tag_Audio);
+
         ALenum error;
         std::int16_t buf[RE_MUSIC_BUFFER_LEN];
         for (int i = 0; i < RE_MUSIC_BUFFER_LEN; i++) buf[i] = 0;
@@ -229,6 +234,8 @@ namespace World
 
     Handle::SfxHandle AudioWorld::loadAudioVDF(const VDFS::FileIndex& idx, const std::string& name)
     {
+        RE_ALLOCATION_SCOPE(Tag_Audio);
+
 #ifdef RE_USE_SOUND
         if (!m_Context)
             return Handle::SfxHandle::makeInvalidHandle();
@@ -256,13 +263,12 @@ namespace World
         }
 
         // Load the audio-file from the VDF-archive
-        std::vector<uint8_t> data;
-        idx.getFileData(snd->sfx.file, data);
+        Content::FileView data = m_Engine.getMappedArchives().getFile(idx, snd->sfx.file);
 
         if (data.empty())
             return Handle::SfxHandle::makeInvalidHandle();
 
-        WavReader wav(&data[0], data.size());
+        WavReader wav(data.getData(), data.getSize());
         if (!wav.open() || !wav.read())
             return Handle::SfxHandle::makeInvalidHandle();
 
@@ -312,6 +318,8 @@ namespace World
 
     Utils::Ticket<AudioWorld> AudioWorld::playSound(Handle::SfxHandle h, const Math::float3& position, bool relative, float maxDist)
     {
+        RE_ALLOCATION_SCOPE(Tag_Audio);
+
 #ifdef RE_USE_SOUND
 
         if (!m_Context)
@@ -446,6 +454,8 @@ namespace World
 
     void AudioWorld::createSounds()
     {
+        RE_ALLOCATION_SCOPE(Tag_Audio);
+
         std::string datPath = "/_work/data/Scripts/_compiled/SFX.DAT";
         std::string datFile = Utils::getCaseSensitivePath(datPath, m_Engine.getEngineArgs().gameBaseDirectory);
 
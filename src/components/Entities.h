@@ -160,10 +160,17 @@ namespace Components
          */
         uint32_t m_InstanceDataIndex;
 
+        /**
+         * Whether this is a grid-cell of the world-mesh. These are culled against the draw-distance using their
+         * bounding-sphere, rather than the draw-distance-factor.
+         */
+        bool m_IsWorldMeshCell;
+
         static void init(StaticMeshComponent& c)
         {
             c.m_Color = 0xFFFFFFFF;
             c.m_InstanceDataIndex = (uint32_t)-1;
+            c.m_IsWorldMeshCell = false;
         }
     };
 
@@ -3,6 +3,7 @@
 //
 
 #include "Vob.h"
+#include <cstring>
 #include <components/EntityActions.h>
 #include <engine/World.h>
 #include <logic/Controller.h>
@@ -90,10 +91,45 @@ void ::Vob::broadcastTransformChange(VobInformation& vob)
         vob.visual->onTransformChanged();
 }
 
+namespace
+{
+    enum class EVisualKind
+    {
+        None,
+        StaticMesh,
+        Model,
+        Pfx
+    };
+
+    /**
+     * @param visual Case-folded name of the visual
+     * @return What kind of visual-controller to use for the given visual, judged by its file-extension
+     */
+    EVisualKind getVisualKind(const std::string& visual)
+    {
+        size_t dot = visual.rfind('.');
+        if (dot == std::string::npos)
+            return EVisualKind::None;
+
+        const char* ext = visual.c_str() + dot + 1;
+
+        if (!strcmp(ext, "3DS") || !strcmp(ext, "MMB") || !strcmp(ext, "MMS") || !strcmp(ext, "MDMS"))
+            return EVisualKind::StaticMesh;
+
+        if (!strcmp(ext, "MDM") || !strcmp(ext, "MDL") || !strcmp(ext, "MDS") || !strcmp(ext, "ASC"))
+            return EVisualKind::Model;
+
+        if (!strcmp(ext, "PFX"))
+            return EVisualKind::Pfx;
+
+        return EVisualKind::None;
+    }
+}
+
 void ::Vob::setVisual(VobInformation& vob, const std::string& _visual)
 {
-    std::string visual = _visual;
-    std::transform(visual.begin(), visual.end(), visual.begin(), ::toupper);
+    // Visual-names are interned, so they are only case-folded once per world
+    const std::string& visual = vob.world->getNameTable().getName(vob.world->getNameTable().intern(_visual));
 
     // Don't set twice
     if (vob.visual && vob.visual->getName() == visual)
@@ -108,31 +144,29 @@ void ::Vob::setVisual(VobInformation& vob, const std::string& _visual)
     vob.visual = nullptr;
 
     // Check type of visual
-    if (visual.find(".3DS") != std::string::npos || visual.find(".MMB") != std::string::npos || visual.find(".MMS") != std::string::npos || visual.find(".MDMS") != std::string::npos)
+    Logic::VisualController* ld = nullptr;
+    switch (getVisualKind(visual))
     {
-        Logic::VisualController* ld = new Logic::StaticMeshVisual(*vob.world, vob.entity);
-        if (ld->load(visual))
-            (*ppVisual) = ld;
-        else
-            delete ld;
-    }
-    else if (visual.find(".MDM") != std::string::npos || visual.find(".MDL") != std::string::npos || visual.find(".MDS") != std::string::npos || visual.find(".ASC") != std::string::npos)
-    {
-        Logic::VisualController* ld = new Logic::ModelVisual(*vob.world, vob.entity);
-        if (ld->load(visual))
-        {
-            (*ppVisual) = ld;
-        }
-        else
-            delete ld;
+        case EVisualKind::StaticMesh:
+            ld = new Logic::StaticMeshVisual(*vob.world, vob.entity);
+            break;
+
+        case EVisualKind::Model:
+            ld = new Logic::ModelVisual(*vob.world, vob.entity);
+            break;
+
+        case EVisualKind::Pfx:
+            ld = new Logic::PfxVisual(*vob.world, vob.entity);
+            break;
+
+        case EVisualKind::None:
+            break;
     }
-    else if (visual.find(".PFX") != std::string::npos)
+
+    if (ld)
     {
-        Logic::VisualController* ld = new Logic::PfxVisual(*vob.world, vob.entity);
         if (ld->load(visual))
-        {
             (*ppVisual) = ld;
-        }
         else
             delete ld;
     }
@@ -411,15 +411,7 @@ int ::VobTypes::MOB_GetItemCount(VobTypes::MobVobInformation mob, const std::str
 
 Handle::EntityHandle VobTypes::MOB_GetByName(World::WorldInstance& world, const std::string& name)
 {
-    for (Handle::EntityHandle e : world.getScriptEngine().getWorldMobs())
-    {
-        MobVobInformation mob = VobTypes::asMobVob(world, e);
-
-        if (mob.isValid() && mob.mobController->getFocusName() == name)
-            return e;
-    }
-
-    return Handle::EntityHandle::makeInvalidHandle();
+    return world.getScriptEngine().findWorldMob(name);
 }
 
 void VobTypes::Wld_RemoveNpc(World::WorldInstance& world, Handle::EntityHandle npc)
@@ -431,7 +423,7 @@ void VobTypes::Wld_RemoveNpc(World::WorldInstance& world, Handle::EntityHandle n
     {
         world.getScriptEngine().setPlayerEntity(Handle::EntityHandle::makeInvalidHandle());
         auto invalidHandle = Daedalus::GameState::NpcHandle();
-        world.getScriptEngine().setInstanceNPC("hero", invalidHandle);
+        world.getScriptEngine().setInstanceNPC(world.getScriptEngine().getCommonSymbols().hero, invalidHandle);
     }
 
     world.getScriptEngine().unregisterNpc(npc);
@@ -2,6 +2,7 @@
 #include <ZenLib/zenload/zCMaterial.h>
 #include <engine/BaseEngine.h>
 #include <engine/World.h>
+#include <utils/EngineLog.h>
 #include <utils/logger.h>
 #include <vdfs/fileIndex.h>
 #include <zenload/modelAnimationParser.h>
@@ -10,6 +11,7 @@
 
 #include "content/AnimationLibrary.h"
 #include <content/AnimationAllocator.h>
+#include <content/AssetCache.h>
 
 using namespace Animations;
 using namespace VDFS;
@@ -45,6 +47,11 @@ namespace Animations
 
     bool AnimationLibrary::loadAnimations()
     {
+        // Animations are shared between all worlds, only the first one has to load them
+        Content::AssetCache& assetCache = m_World.getEngine()->getAssetCache();
+        if (assetCache.areAnimationsLoaded())
+            return true;
+
         // both .MDS and .MSB, where .MDS has precedence
         std::map<std::string, bool> msb_loaded;  // true = is MDS
 
@@ -89,6 +96,7 @@ namespace Animations
                 continue;
         }
 
+        assetCache.setAnimationsLoaded();
         return true;
     }
 
@@ -222,7 +230,7 @@ namespace Animations
 
     bool AnimationLibrary::loadModelScript(const std::string& file_name, ModelScriptParser& p)
     {
-        LogInfo() << "load model script " << file_name;
+        RE_LOG_DEBUG(Content) << "load model script " << file_name;
 
         size_t name_end = file_name.rfind('.');
         std::string name = file_name.substr(0, name_end);
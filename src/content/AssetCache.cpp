@@ -0,0 +1,244 @@
+#include "AssetCache.h"
+#include <utils/logger.h>
+
+using namespace Content;
+
+AssetCache::AssetCache(Engine::BaseEngine& engine)
+    : m_TextureAllocator(engine)
+    , m_StaticMeshAllocator(engine)
+    , m_SkeletalMeshAllocator(engine)
+    , m_AnimationsLoaded(false)
+    , m_NumFreedLastCollection(0)
+{
+}
+
+AssetCache::~AssetCache()
+{
+}
+
+template <typename H>
+void AssetCache::addReference(RefCounts<H>& refs, H h)
+{
+    refs[h]++;
+}
+
+template <typename H>
+void AssetCache::releaseReference(RefCounts<H>& refs, H h)
+{
+    auto it = refs.find(h);
+    if (it != refs.end() && it->second > 0)
+        it->second--;
+}
+
+template <typename H, typename F>
+size_t AssetCache::collect(RefCounts<H>& refs, F freeAsset)
+{
+    size_t numFreed = 0;
+    for (auto it = refs.begin(); it != refs.end();)
+    {
+        if (it->second == 0)
+        {
+            freeAsset(it->first);
+            it = refs.erase(it);
+            numFreed++;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    return numFreed;
+}
+
+void AssetCache::addTextureReference(Handle::TextureHandle h)
+{
+    std::lock_guard<std::mutex> guard(m_RefsMutex);
+    addReference(m_TextureRefs, h);
+}
+
+void AssetCache::releaseTextureReference(Handle::TextureHandle h)
+{
+    std::lock_guard<std::mutex> guard(m_RefsMutex);
+    releaseReference(m_TextureRefs, h);
+}
+
+void AssetCache::addStaticMeshReference(Handle::MeshHandle h)
+{
+    std::lock_guard<std::mutex> guard(m_RefsMutex);
+    addReference(m_StaticMeshRefs, h);
+}
+
+void AssetCache::releaseStaticMeshReference(Handle::MeshHandle h)
+{
+    std::lock_guard<std::mutex> guard(m_RefsMutex);
+    releaseReference(m_StaticMeshRefs, h);
+}
+
+void AssetCache::addSkeletalMeshReference(Handle::MeshHandle h)
+{
+    std::lock_guard<std::mutex> guard(m_RefsMutex);
+    addReference(m_SkeletalMeshRefs, h);
+}
+
+void AssetCache::releaseSkeletalMeshReference(Handle::MeshHandle h)
+{
+    std::lock_guard<std::mutex> guard(m_RefsMutex);
+    releaseReference(m_SkeletalMeshRefs, h);
+}
+
+void AssetCache::collectGarbage()
+{
+    std::lock_guard<std::mutex> guard(m_RefsMutex);
+
+    size_t numTextures = collect(m_TextureRefs, [this](Handle::TextureHandle h) {
+        m_TextureAllocator.removeTexture(h);
+    });
+
+    size_t numStaticMeshes = collect(m_StaticMeshRefs, [this](Handle::MeshHandle h) {
+        m_StaticMeshAllocator.removeMesh(h);
+    });
+
+    size_t numSkeletalMeshes = collect(m_SkeletalMeshRefs, [this](Handle::MeshHandle h) {
+        m_SkeletalMeshAllocator.removeMesh(h);
+    });
+
+    m_NumFreedLastCollection = numTextures + numStaticMeshes + numSkeletalMeshes;
+
+    LogInfo() << "Asset-cache: Freed " << numTextures << " textures, " << numStaticMeshes << " static meshes and "
+              << numSkeletalMeshes << " skeletal meshes no longer used by any world";
+}
+
+AssetCache::Stats AssetCache::getStats()
+{
+    std::lock_guard<std::mutex> guard(m_RefsMutex);
+
+    Stats s;
+    s.numTextures = m_TextureRefs.size();
+    s.numStaticMeshes = m_StaticMeshRefs.size();
+    s.numSkeletalMeshes = m_SkeletalMeshRefs.size();
+    s.numFreedLastCollection = m_NumFreedLastCollection;
+
+    auto countUnreferenced = [&](const auto& refs) {
+        for (const auto& r : refs)
+            if (r.second == 0)
+                s.numUnreferenced++;
+    };
+
+    countUnreferenced(m_TextureRefs);
+    countUnreferenced(m_StaticMeshRefs);
+    countUnreferenced(m_SkeletalMeshRefs);
+
+    return s;
+}
+
+SharedTextureAllocator::SharedTextureAllocator(AssetCache& cache)
+    : m_Cache(cache)
+{
+}
+
+SharedTextureAllocator::~SharedTextureAllocator()
+{
+    for (Handle::TextureHandle h : m_Referenced)
+        m_Cache.releaseTextureReference(h);
+}
+
+Handle::TextureHandle SharedTextureAllocator::acquire(Handle::TextureHandle h)
+{
+    if (h.isValid() && m_Referenced.insert(h).second)
+        m_Cache.addTextureReference(h);
+
+    return h;
+}
+
+Handle::TextureHandle SharedTextureAllocator::loadTextureDDS(const std::vector<uint8_t>& data, const std::string& name)
+{
+    return acquire(m_Cache.getTextureAllocator().loadTextureDDS(data, name));
+}
+
+Handle::TextureHandle SharedTextureAllocator::loadTextureRGBA8(const std::vector<uint8_t>& data, uint16_t width, uint16_t height, const std::string& name)
+{
+    return acquire(m_Cache.getTextureAllocator().loadTextureRGBA8(data, width, height, name));
+}
+
+Handle::TextureHandle SharedTextureAllocator::loadTextureVDF(const VDFS::FileIndex& idx, const std::string& name)
+{
+    return acquire(m_Cache.getTextureAllocator().loadTextureVDF(idx, name));
+}
+
+Handle::TextureHandle SharedTextureAllocator::loadTextureVDF(const std::string& name)
+{
+    return acquire(m_Cache.getTextureAllocator().loadTextureVDF(name));
+}
+
+SharedStaticMeshAllocator::SharedStaticMeshAllocator(AssetCache& cache)
+    : m_Cache(cache)
+{
+}
+
+SharedStaticMeshAllocator::~SharedStaticMeshAllocator()
+{
+    for (Handle::MeshHandle h : m_Referenced)
+        m_Cache.releaseStaticMeshReference(h);
+}
+
+Handle::MeshHandle SharedStaticMeshAllocator::acquire(Handle::MeshHandle h)
+{
+    if (h.isValid() && m_Referenced.insert(h).second)
+        m_Cache.addStaticMeshReference(h);
+
+    return h;
+}
+
+Handle::MeshHandle SharedStaticMeshAllocator::loadMeshVDF(const VDFS::FileIndex& idx, const std::string& name)
+{
+    return acquire(m_Cache.getStaticMeshAllocator().loadMeshVDF(idx, name));
+}
+
+Handle::MeshHandle SharedStaticMeshAllocator::loadMeshVDF(const std::string& name)
+{
+    return acquire(m_Cache.getStaticMeshAllocator().loadMeshVDF(name));
+}
+
+Handle::MeshHandle SharedStaticMeshAllocator::loadFromPacked(const ZenLoad::PackedMesh& packed, const std::string& name)
+{
+    return acquire(m_Cache.getStaticMeshAllocator().loadFromPacked(packed, name));
+}
+
+Handle::MeshHandle SharedStaticMeshAllocator::loadFromPackedSubmeshCells(const ZenLoad::PackedMesh& packed,
+                                                                         size_t submesh,
+                                                                         float cellSize,
+                                                                         std::vector<Utils::BBox3D>& cellBoxes,
+                                                                         const std::string& name)
+{
+    return acquire(m_Cache.getStaticMeshAllocator().loadFromPackedSubmeshCells(packed, submesh, cellSize, cellBoxes, name));
+}
+
+SharedSkeletalMeshAllocator::SharedSkeletalMeshAllocator(AssetCache& cache)
+    : m_Cache(cache)
+{
+}
+
+SharedSkeletalMeshAllocator::~SharedSkeletalMeshAllocator()
+{
+    for (Handle::MeshHandle h : m_Referenced)
+        m_Cache.releaseSkeletalMeshReference(h);
+}
+
+Handle::MeshHandle SharedSkeletalMeshAllocator::acquire(Handle::MeshHandle h)
+{
+    if (h.isValid() && m_Referenced.insert(h).second)
+        m_Cache.addSkeletalMeshReference(h);
+
+    return h;
+}
+
+Handle::MeshHandle SharedSkeletalMeshAllocator::loadMeshVDF(const VDFS::FileIndex& idx, const std::string& name)
+{
+    return acquire(m_Cache.getSkeletalMeshAllocator().loadMeshVDF(idx, name));
+}
+
+Handle::MeshHandle SharedSkeletalMeshAllocator::loadMeshVDF(const std::string& name)
+{
+    return acquire(m_Cache.getSkeletalMeshAllocator().loadMeshVDF(name));
+}
@@ -0,0 +1,191 @@
+#pragma once
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+#include <content/AnimationAllocator.h>
+#include <content/SkeletalMeshAllocator.h>
+#include <content/StaticMeshAllocator.h>
+#include <content/Texture.h>
+#include <handle/HandleDef.h>
+
+namespace Engine
+{
+    class BaseEngine;
+}
+
+namespace Content
+{
+    /**
+     * Engine-wide storage for textures, meshes and animations, shared by all worlds. Worlds access it through
+     * the Shared*Allocator-classes below, which count a reference for every asset the world has loaded.
+     *
+     * Assets no longer referenced by any world are not freed right away, but kept until collectGarbage() is called.
+     * That way, a world being switched to can pick up everything it shares with the world that was just left.
+     */
+    class AssetCache
+    {
+    public:
+        struct Stats
+        {
+            size_t numTextures = 0;
+            size_t numStaticMeshes = 0;
+            size_t numSkeletalMeshes = 0;
+
+            // Assets currently not referenced by any world, which will be freed on the next collection
+            size_t numUnreferenced = 0;
+
+            // Assets freed by the last collection
+            size_t numFreedLastCollection = 0;
+        };
+
+        AssetCache(Engine::BaseEngine& engine);
+        ~AssetCache();
+
+        Textures::TextureAllocator& getTextureAllocator() { return m_TextureAllocator; }
+        Meshes::StaticMeshAllocator& getStaticMeshAllocator() { return m_StaticMeshAllocator; }
+        Meshes::SkeletalMeshAllocator& getSkeletalMeshAllocator() { return m_SkeletalMeshAllocator; }
+        Animations::AnimationAllocator& getAnimationAllocator() { return m_AnimationAllocator; }
+        Animations::AnimationDataAllocator& getAnimationDataAllocator() { return m_AnimationDataAllocator; }
+
+        /**
+         * Animations don't depend on the world, all of them are loaded at once and kept for the lifetime of the engine
+         */
+        bool areAnimationsLoaded() const { return m_AnimationsLoaded; }
+        void setAnimationsLoaded() { m_AnimationsLoaded = true; }
+
+        /**
+         * Reference counting. Safe to call from any thread.
+         */
+        void addTextureReference(Handle::TextureHandle h);
+        void releaseTextureReference(Handle::TextureHandle h);
+        void addStaticMeshReference(Handle::MeshHandle h);
+        void releaseStaticMeshReference(Handle::MeshHandle h);
+        void addSkeletalMeshReference(Handle::MeshHandle h);
+        void releaseSkeletalMeshReference(Handle::MeshHandle h);
+
+        /**
+         * Frees all assets which are not referenced by any world anymore.
+         * Needs to run on the main-thread, while no world is loading.
+         */
+        void collectGarbage();
+
+        Stats getStats();
+
+    private:
+        template <typename H>
+        using RefCounts = std::map<H, uint32_t>;
+
+        template <typename H>
+        static void addReference(RefCounts<H>& refs, H h);
+
+        template <typename H>
+        static void releaseReference(RefCounts<H>& refs, H h);
+
+        /**
+         * Removes all entries with a count of 0 and passes their handles to the given function
+         * @return Number of removed entries
+         */
+        template <typename H, typename F>
+        static size_t collect(RefCounts<H>& refs, F freeAsset);
+
+        Textures::TextureAllocator m_TextureAllocator;
+        Meshes::StaticMeshAllocator m_StaticMeshAllocator;
+        Meshes::SkeletalMeshAllocator m_SkeletalMeshAllocator;
+        Animations::AnimationAllocator m_AnimationAllocator;
+        Animations::AnimationDataAllocator m_AnimationDataAllocator;
+        bool m_AnimationsLoaded;
+
+        /**
+         * Number of worlds referencing each loaded asset. Assets with a count of 0 are waiting for collection.
+         */
+        RefCounts<Handle::TextureHandle> m_TextureRefs;
+        RefCounts<Handle::MeshHandle> m_StaticMeshRefs;
+        RefCounts<Handle::MeshHandle> m_SkeletalMeshRefs;
+        std::mutex m_RefsMutex;
+
+        size_t m_NumFreedLastCollection;
+    };
+
+    /**
+     * A world's access to the shared texture-allocator. Remembers every texture the world has loaded and
+     * releases them once the world is gone.
+     */
+    class SharedTextureAllocator
+    {
+    public:
+        SharedTextureAllocator(AssetCache& cache);
+        ~SharedTextureAllocator();
+
+        Handle::TextureHandle loadTextureDDS(const std::vector<uint8_t>& data, const std::string& name = "");
+        Handle::TextureHandle loadTextureRGBA8(const std::vector<uint8_t>& data, uint16_t width, uint16_t height, const std::string& name = "");
+        Handle::TextureHandle loadTextureVDF(const VDFS::FileIndex& idx, const std::string& name);
+        Handle::TextureHandle loadTextureVDF(const std::string& name);
+
+        Textures::Texture& getTexture(Handle::TextureHandle h) { return m_Cache.getTextureAllocator().getTexture(h); }
+        size_t getEstimatedGPUMemoryConsumption() { return m_Cache.getTextureAllocator().getEstimatedGPUMemoryConsumption(); }
+
+    private:
+        Handle::TextureHandle acquire(Handle::TextureHandle h);
+
+        AssetCache& m_Cache;
+        std::set<Handle::TextureHandle> m_Referenced;
+    };
+
+    /**
+     * A world's access to the shared static-mesh-allocator, see SharedTextureAllocator
+     */
+    class SharedStaticMeshAllocator
+    {
+    public:
+        SharedStaticMeshAllocator(AssetCache& cache);
+        ~SharedStaticMeshAllocator();
+
+        Handle::MeshHandle loadMeshVDF(const VDFS::FileIndex& idx, const std::string& name);
+        Handle::MeshHandle loadMeshVDF(const std::string& name);
+        Handle::MeshHandle loadFromPacked(const ZenLoad::PackedMesh& packed, const std::string& name = "");
+        Handle::MeshHandle loadFromPackedSubmeshCells(const ZenLoad::PackedMesh& packed,
+                                                      size_t submesh,
+                                                      float cellSize,
+                                                      std::vector<Utils::BBox3D>& cellBoxes,
+                                                      const std::string& name = "");
+
+        Meshes::WorldStaticMesh& getMesh(Handle::MeshHandle h) { return m_Cache.getStaticMeshAllocator().getMesh(h); }
+        size_t getEstimatedGPUMemoryConsumption() { return m_Cache.getStaticMeshAllocator().getEstimatedGPUMemoryConsumption(); }
+        void getLargestContentInformation(size_t& size, std::string& name) { m_Cache.getStaticMeshAllocator().getLargestContentInformation(size, name); }
+
+    private:
+        Handle::MeshHandle acquire(Handle::MeshHandle h);
+
+        AssetCache& m_Cache;
+        std::set<Handle::MeshHandle> m_Referenced;
+    };
+
+    /**
+     * A world's access to the shared skeletal-mesh-allocator, see SharedTextureAllocator
+     */
+    class SharedSkeletalMeshAllocator
+    {
+    public:
+        SharedSkeletalMeshAllocator(AssetCache& cache);
+        ~SharedSkeletalMeshAllocator();
+
+        Handle::MeshHandle loadMeshVDF(const VDFS::FileIndex& idx, const std::string& name);
+        Handle::MeshHandle loadMeshVDF(const std::string& name);
+
+        Meshes::WorldSkeletalMesh& getMesh(Handle::MeshHandle h) { return m_Cache.getSkeletalMeshAllocator().getMesh(h); }
+        const Utils::BBox3D& getMeshBBox3d(Handle::MeshHandle h) { return m_Cache.getSkeletalMeshAllocator().getMeshBBox3d(h); }
+        float getMeshBoundingSphereRadius(Handle::MeshHandle h) { return m_Cache.getSkeletalMeshAllocator().getMeshBoundingSphereRadius(h); }
+        bool isLoaded(Handle::MeshHandle h) { return m_Cache.getSkeletalMeshAllocator().isLoaded(h); }
+        const ZenLoad::zCModelMeshLib& getMeshLib(Handle::MeshHandle h) { return m_Cache.getSkeletalMeshAllocator().getMeshLib(h); }
+        size_t getEstimatedGPUMemoryConsumption() { return m_Cache.getSkeletalMeshAllocator().getEstimatedGPUMemoryConsumption(); }
+        void getLargestContentInformation(size_t& size, std::string& name) { m_Cache.getSkeletalMeshAllocator().getLargestContentInformation(size, name); }
+
+    private:
+        Handle::MeshHandle acquire(Handle::MeshHandle h);
+
+        AssetCache& m_Cache;
+        std::set<Handle::MeshHandle> m_Referenced;
+    };
+}
@@ -0,0 +1,230 @@
+#include "BakeCache.h"
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include <utils/Utils.h>
+#include <utils/logger.h>
+#include <vdfs/fileIndex.h>
+
+using namespace Content;
+
+namespace
+{
+    const uint32_t BAKE_MAGIC = 0x454B4142;  // "BAKE"
+
+    /**
+     * Bump whenever the layout of a payload or the processing done before baking changes
+     */
+    const uint32_t BAKE_VERSION = 1;
+
+    /**
+     * Start of every entry-file. Followed by the name of the source-file and the payload.
+     */
+    struct EntryHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t kind;
+        uint32_t sourceFileLength;
+        uint64_t archiveFingerprint;
+        uint64_t sourceHash;
+        uint64_t payloadSize;
+    };
+}
+
+BakeCache::BakeCache()
+    : m_ArchiveFingerprint(0)
+{
+}
+
+bool BakeCache::init(const std::string& directory, uint64_t archiveFingerprint)
+{
+    if (!Utils::mkdir(directory))
+    {
+        LogWarn() << "Bake-cache: Could not create directory " << directory << ", cache disabled";
+        return false;
+    }
+
+    m_Directory = directory;
+    m_ArchiveFingerprint = archiveFingerprint;
+
+    LogInfo() << "Bake-cache: Using " << directory;
+    return true;
+}
+
+std::string BakeCache::getEntryPath(EKind kind, const std::string& sourceFile) const
+{
+    char name[32];
+    snprintf(name, sizeof(name), "%u_%016llx.bake", static_cast<unsigned>(kind),
+             static_cast<unsigned long long>(hashString(Utils::uppered(sourceFile))));
+
+    return m_Directory + "/" + name;
+}
+
+bool BakeCache::find(EKind kind, const std::string& sourceFile, const VDFS::FileIndex& idx, Entry& entry)
+{
+    return find(kind, sourceFile, [&]() { return hashSourceFile(idx, sourceFile); }, entry);
+}
+
+bool BakeCache::find(EKind kind, const std::string& sourceFile, uint64_t sourceHash, Entry& entry)
+{
+    return find(kind, sourceFile, [sourceHash]() { return sourceHash; }, entry);
+}
+
+bool BakeCache::find(EKind kind, const std::string& sourceFile, const std::function<uint64_t()>& sourceHash, Entry& entry)
+{
+    if (!isEnabled())
+        return false;
+
+    if (!entry.m_File.open(getEntryPath(kind, sourceFile)))
+        return false;
+
+    const uint8_t* data = entry.m_File.getData();
+    size_t size = entry.m_File.getSize();
+
+    EntryHeader header;
+    if (size < sizeof(header))
+    {
+        entry.m_File.close();
+        return false;
+    }
+
+    memcpy(&header, data, sizeof(header));
+
+    std::string key = Utils::uppered(sourceFile);
+    bool valid = header.magic == BAKE_MAGIC
+                 && header.version == BAKE_VERSION
+                 && header.kind == static_cast<uint32_t>(kind)
+                 && header.sourceFileLength == key.size()
+                 && size == sizeof(header) + header.sourceFileLength + header.payloadSize
+                 && memcmp(data + sizeof(header), key.data(), key.size()) == 0;
+
+    if (!valid)
+    {
+        entry.m_File.close();
+        return false;
+    }
+
+    entry.m_Payload = data + sizeof(header) + header.sourceFileLength;
+    entry.m_PayloadSize = static_cast<size_t>(header.payloadSize);
+
+    if (header.archiveFingerprint != m_ArchiveFingerprint)
+    {
+        // Archives have changed, check whether this entry is still what the source would produce
+        uint64_t hash = sourceHash();
+        if (hash == 0 || hash != header.sourceHash)
+        {
+            entry.m_File.close();
+            return false;
+        }
+
+        // Still valid, tag it with the current archives so the next lookup can skip the check
+        store(kind, sourceFile, hash, std::vector<uint8_t>(entry.m_Payload, entry.m_Payload + entry.m_PayloadSize));
+    }
+
+    return true;
+}
+
+bool BakeCache::store(EKind kind, const std::string& sourceFile, uint64_t sourceHash, const std::vector<uint8_t>& payload)
+{
+    if (!isEnabled() || sourceHash == 0)
+        return false;
+
+    std::string key = Utils::uppered(sourceFile);
+
+    EntryHeader header;
+    header.magic = BAKE_MAGIC;
+    header.version = BAKE_VERSION;
+    header.kind = static_cast<uint32_t>(kind);
+    header.sourceFileLength = static_cast<uint32_t>(key.size());
+    header.archiveFingerprint = m_ArchiveFingerprint;
+    header.sourceHash = sourceHash;
+    header.payloadSize = payload.size();
+
+    // Write to a temporary file first, so readers never see half-written entries
+    std::string path = getEntryPath(kind, sourceFile);
+    std::string tmpPath = path + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+
+    {
+        std::ofstream f(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!f.is_open())
+            return false;
+
+        f.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        f.write(key.data(), key.size());
+        f.write(reinterpret_cast<const char*>(payload.data()), payload.size());
+
+        if (!f.good())
+        {
+            f.close();
+            std::remove(tmpPath.c_str());
+            return false;
+        }
+    }
+
+#ifdef _WIN32
+    // Windows won't rename onto an existing file
+    std::remove(path.c_str());
+#endif
+
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0)
+    {
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+bool BakeCache::store(EKind kind, const std::string& sourceFile, const VDFS::FileIndex& idx, const std::vector<uint8_t>& payload)
+{
+    if (!isEnabled())
+        return false;
+
+    return store(kind, sourceFile, hashSourceFile(idx, sourceFile), payload);
+}
+
+uint64_t BakeCache::hashData(const uint8_t* data, size_t size, uint64_t seed)
+{
+    uint64_t h = seed;
+    for (size_t i = 0; i < size; i++)
+    {
+        h ^= data[i];
+        h *= 1099511628211ULL;
+    }
+
+    return h;
+}
+
+uint64_t BakeCache::hashString(const std::string& s, uint64_t seed)
+{
+    return hashData(reinterpret_cast<const uint8_t*>(s.data()), s.size(), seed);
+}
+
+uint64_t BakeCache::hashSourceFile(const VDFS::FileIndex& idx, const std::string& sourceFile)
+{
+    std::vector<uint8_t> data;
+    idx.getFileData(sourceFile, data);
+
+    if (data.empty())
+        return 0;
+
+    return hashData(data.data(), data.size());
+}
+
+uint64_t BakeCache::makeArchiveFingerprint(const std::vector<std::string>& archives)
+{
+    uint64_t h = hashString(std::to_string(BAKE_VERSION));
+    for (const std::string& a : archives)
+    {
+        int64_t modTime = static_cast<int64_t>(VDFS::FileIndex::getLastModTime(a));
+        uint64_t size = Utils::getFileSize(a);
+
+        h = hashString(a, h);
+        h = hashData(reinterpret_cast<const uint8_t*>(&modTime), sizeof(modTime), h);
+        h = hashData(reinterpret_cast<const uint8_t*>(&size), sizeof(size), h);
+    }
+
+    return h;
+}
@@ -0,0 +1,225 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include <utils/MappedFile.h>
+
+namespace VDFS
+{
+    class FileIndex;
+}
+
+namespace Content
+{
+    /**
+     * On-disk cache for assets which are expensive to process after they have been read from the archives,
+     * like decoded textures or meshes with generated levels of detail. Every entry is a single file, which is
+     * memory-mapped when read.
+     *
+     * Entries are tagged with a fingerprint of the loaded archives and a hash of the source-file they were made from.
+     * While the archives are unchanged, entries are used without touching the source at all. Otherwise, the source
+     * is hashed and the entry is only used if it matches.
+     */
+    class BakeCache
+    {
+    public:
+        enum class EKind : uint32_t
+        {
+            Texture = 1,
+            StaticMesh = 2,
+            CollisionMesh = 3
+        };
+
+        /**
+         * Builds the binary payload of an entry. Only for plain data and containers of plain data.
+         */
+        class Writer
+        {
+        public:
+            template <typename T>
+            void write(const T& v)
+            {
+                const uint8_t* p = reinterpret_cast<const uint8_t*>(&v);
+                m_Data.insert(m_Data.end(), p, p + sizeof(T));
+            }
+
+            template <typename T>
+            void writeVector(const std::vector<T>& v)
+            {
+                write<uint32_t>(static_cast<uint32_t>(v.size()));
+                const uint8_t* p = reinterpret_cast<const uint8_t*>(v.data());
+                m_Data.insert(m_Data.end(), p, p + v.size() * sizeof(T));
+            }
+
+            void writeString(const std::string& s)
+            {
+                write<uint32_t>(static_cast<uint32_t>(s.size()));
+                m_Data.insert(m_Data.end(), s.begin(), s.end());
+            }
+
+            const std::vector<uint8_t>& getData() const { return m_Data; }
+
+        private:
+            std::vector<uint8_t> m_Data;
+        };
+
+        /**
+         * Reads a payload built by Writer. Once a read went past the end, all further reads fail.
+         */
+        class Reader
+        {
+        public:
+            Reader(const uint8_t* data, size_t size)
+                : m_Ptr(data)
+                , m_End(data + size)
+            {
+            }
+
+            template <typename T>
+            bool read(T& v)
+            {
+                if (!canRead(sizeof(T)))
+                    return false;
+
+                memcpy(&v, m_Ptr, sizeof(T));
+                m_Ptr += sizeof(T);
+                return true;
+            }
+
+            template <typename T>
+            bool readVector(std::vector<T>& v)
+            {
+                uint32_t n;
+                if (!read(n) || !canRead(size_t(n) * sizeof(T)))
+                    return false;
+
+                v.resize(n);
+                memcpy(v.data(), m_Ptr, size_t(n) * sizeof(T));
+                m_Ptr += size_t(n) * sizeof(T);
+                return true;
+            }
+
+            bool readString(std::string& s)
+            {
+                uint32_t n;
+                if (!read(n) || !canRead(n))
+                    return false;
+
+                s.assign(reinterpret_cast<const char*>(m_Ptr), n);
+                m_Ptr += n;
+                return true;
+            }
+
+            /**
+             * @return Pointer to the unread rest of the payload
+             */
+            const uint8_t* getRemaining(size_t& size) const
+            {
+                size = m_End - m_Ptr;
+                return m_Ptr;
+            }
+
+        private:
+            bool canRead(size_t n)
+            {
+                if (!m_Ptr || size_t(m_End - m_Ptr) < n)
+                {
+                    m_Ptr = nullptr;
+                    m_End = nullptr;
+                    return false;
+                }
+
+                return true;
+            }
+
+            const uint8_t* m_Ptr;
+            const uint8_t* m_End;
+        };
+
+        /**
+         * Mapped entry. The payload stays valid as long as this object lives.
+         */
+        class Entry
+        {
+        public:
+            bool isValid() const { return m_File.isOpen(); }
+            Reader getReader() const { return Reader(m_Payload, m_PayloadSize); }
+
+        private:
+            friend class BakeCache;
+
+            Utils::MappedFile m_File;
+            const uint8_t* m_Payload = nullptr;
+            size_t m_PayloadSize = 0;
+        };
+
+        BakeCache();
+
+        /**
+         * Enables the cache
+         * @param directory Where to store the entries. Created if it doesn't exist.
+         * @param archiveFingerprint Identifies the set of loaded archives, see makeArchiveFingerprint()
+         * @return false, if the directory could not be created. The cache stays disabled then.
+         */
+        bool init(const std::string& directory, uint64_t archiveFingerprint);
+
+        bool isEnabled() const { return !m_Directory.empty(); }
+
+        /**
+         * Looks up an entry
+         * @param sourceFile File in the archives the entry was made from
+         * @param idx Archives to hash the source-file from, in case the archives have changed since the entry was made
+         * @param entry Output. Valid, if an up-to-date entry was found.
+         * @return Whether an up-to-date entry was found
+         */
+        bool find(EKind kind, const std::string& sourceFile, const VDFS::FileIndex& idx, Entry& entry);
+
+        /**
+         * Like above, but validates the entry against the given hash of the source-data instead of
+         * reading the source from the archives
+         */
+        bool find(EKind kind, const std::string& sourceFile, uint64_t sourceHash, Entry& entry);
+
+        /**
+         * Writes an entry, replacing any existing one. Safe to call from multiple threads.
+         * @param sourceHash Hash of the source-data, see hashData()
+         */
+        bool store(EKind kind, const std::string& sourceFile, uint64_t sourceHash, const std::vector<uint8_t>& payload);
+
+        /**
+         * Convenience-version of store(), which hashes the source-file from the given archives
+         */
+        bool store(EKind kind, const std::string& sourceFile, const VDFS::FileIndex& idx, const std::vector<uint8_t>& payload);
+
+        /**
+         * 64-bit FNV-1a
+         */
+        static uint64_t hashData(const uint8_t* data, size_t size, uint64_t seed = 14695981039346656037ULL);
+        static uint64_t hashString(const std::string& s, uint64_t seed = 14695981039346656037ULL);
+
+        /**
+         * @return Hash of the given file inside the archives, 0 if it doesn't exist
+         */
+        static uint64_t hashSourceFile(const VDFS::FileIndex& idx, const std::string& sourceFile);
+
+        /**
+         * Combines paths and modification-times of the given archives into one value
+         */
+        static uint64_t makeArchiveFingerprint(const std::vector<std::string>& archives);
+
+    private:
+        /**
+         * Maps the entry and checks its header
+         * @param sourceHash Function to get the hash of the source-data, only called if the archives have changed
+         */
+        bool find(EKind kind, const std::string& sourceFile, const std::function<uint64_t()>& sourceHash, Entry& entry);
+
+        std::string getEntryPath(EKind kind, const std::string& sourceFile) const;
+
+        std::string m_Directory;
+        uint64_t m_ArchiveFingerprint;
+    };
+}
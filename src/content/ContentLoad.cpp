@@ -4,6 +4,7 @@
 
 #include "ContentLoad.h"
 #include <engine/World.h>
+#include <content/AssetCache.h>
 #include <components/EntityActions.h>
 
 Handle::EntityHandle Content::Wrap::createEntity(World::WorldInstance& world, Components::ComponentMask mask)
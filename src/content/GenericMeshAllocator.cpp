@@ -55,6 +55,10 @@ Handle::MeshHandle GenericMeshAllocator::loadMeshVDF(const VDFS::FileIndex& idx,
 
     if (vname.find(".MRM") != std::string::npos)
     {
+        Handle::MeshHandle baked = loadBaked(*m_pVDFSIndex, vname, name);
+        if (baked.isValid())
+            return baked;
+
         // Try to load the mesh
         ZenLoad::zCProgMeshProto zmsh(vname, *m_pVDFSIndex);
 
@@ -64,6 +68,11 @@ Handle::MeshHandle GenericMeshAllocator::loadMeshVDF(const VDFS::FileIndex& idx,
 
         // Pack the mesh
         zmsh.packMesh(packed, 1.0f / 100.0f);
+
+        Handle::MeshHandle h = loadFromPackedProgMesh(packed, name);
+        storeBaked(*m_pVDFSIndex, vname, h);
+
+        return h;
     }
     else if (vname.find(".MMB") != std::string::npos)
     {
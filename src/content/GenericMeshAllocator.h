@@ -41,7 +41,24 @@ namespace Meshes
          */
         virtual Handle::MeshHandle loadFromPacked(const ZenLoad::PackedMesh& packed, const std::string& name = "") = 0;
 
+        /**
+         * Like loadFromPacked, but for meshes loaded from progressive meshes (.MRM). Allocators which support
+         * levels of detail can generate them here.
+         */
+        virtual Handle::MeshHandle loadFromPackedProgMesh(const ZenLoad::PackedMesh& packed, const std::string& name = "") { return loadFromPacked(packed, name); }
+
     protected:
+        /**
+         * Lets allocators load an already processed version of the given source-file, e.g. from the bake-cache
+         * @return Invalid handle, if there is none
+         */
+        virtual Handle::MeshHandle loadBaked(const VDFS::FileIndex& idx, const std::string& sourceFile, const std::string& name) { return Handle::MeshHandle::makeInvalidHandle(); }
+
+        /**
+         * Called after the given source-file was loaded the slow way, so allocators can store a processed version
+         */
+        virtual void storeBaked(const VDFS::FileIndex& idx, const std::string& sourceFile, Handle::MeshHandle h) {}
+
         /**
          * @brief Textures by their set names. Note: If names are doubled, only the last loaded texture
          *		  can be found here
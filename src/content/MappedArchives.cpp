@@ -0,0 +1,221 @@
+#include "MappedArchives.h"
+#include <cstring>
+#include <utils/MappedFile.h>
+#include <utils/Utils.h>
+#include <utils/logger.h>
+#include <vdfs/fileIndex.h>
+
+using namespace Content;
+
+namespace
+{
+    /**
+     * Directory-entry of a VDF-archive
+     */
+    struct VDFEntry
+    {
+        char name[64];
+        uint32_t offset;
+        uint32_t size;
+        uint32_t type;
+        uint32_t attributes;
+    };
+
+    const uint32_t VDF_ENTRY_DIRECTORY = 0x80000000;
+    const size_t VDF_HEADER_COMMENT_SIZE = 256;
+    const size_t VDF_HEADER_SIGNATURE_SIZE = 16;
+    const size_t VDF_HEADER_SIZE = VDF_HEADER_COMMENT_SIZE + VDF_HEADER_SIGNATURE_SIZE + 6 * sizeof(uint32_t);
+
+    const uint32_t ZIP_END_OF_CENTRAL_DIR = 0x06054b50;
+    const uint32_t ZIP_CENTRAL_DIR_ENTRY = 0x02014b50;
+    const size_t ZIP_END_OF_CENTRAL_DIR_SIZE = 22;
+    const size_t ZIP_CENTRAL_DIR_ENTRY_SIZE = 46;
+
+    template <typename T>
+    T readAt(const uint8_t* data, size_t offset)
+    {
+        T v;
+        memcpy(&v, data + offset, sizeof(T));
+        return v;
+    }
+}
+
+MappedArchives::MappedArchives()
+    : m_pIndex(nullptr)
+    , m_NumMappedFiles(0)
+    , m_MountFailed(false)
+{
+}
+
+MappedArchives::~MappedArchives()
+{
+}
+
+bool MappedArchives::mount(const std::string& archive)
+{
+    // Once an archive couldn't be read, we don't know which files it overrides anymore, so everything
+    // after it has to go through the file-index
+    if (m_MountFailed)
+        return false;
+
+    auto file = std::make_shared<Utils::MappedFile>();
+    if (!file->open(archive))
+    {
+        LogWarn() << "Could not map archive " << archive << ", its files will be copied";
+        m_MountFailed = true;
+        return false;
+    }
+
+    uint32_t idx = static_cast<uint32_t>(m_Archives.size());
+    m_Archives.push_back(file);
+
+    std::string ext = Utils::uppered(Utils::splitExtension(archive).second);
+    bool ok = ext == ".ZIP" ? parseZIP(idx) : parseVDF(idx);
+
+    if (!ok)
+    {
+        // Nothing of this archive will be viewed, don't keep it mapped
+        m_Archives.back().reset();
+        LogWarn() << "Could not read the directory of archive " << archive << ", its files will be copied";
+        m_MountFailed = true;
+    }
+
+    return ok;
+}
+
+bool MappedArchives::parseVDF(uint32_t archive)
+{
+    const uint8_t* data = m_Archives[archive]->getData();
+    size_t size = m_Archives[archive]->getSize();
+
+    if (size < VDF_HEADER_SIZE || memcmp(data + VDF_HEADER_COMMENT_SIZE, "PSVDSC_V2.00", 12) != 0)
+        return false;
+
+    size_t fields = VDF_HEADER_COMMENT_SIZE + VDF_HEADER_SIGNATURE_SIZE;
+    uint32_t numEntries = readAt<uint32_t>(data, fields);
+    uint32_t rootOffset = readAt<uint32_t>(data, fields + 4 * sizeof(uint32_t));
+
+    if (rootOffset > size || (size - rootOffset) / sizeof(VDFEntry) < numEntries)
+        return false;
+
+    for (uint32_t i = 0; i < numEntries; i++)
+    {
+        VDFEntry e = readAt<VDFEntry>(data, rootOffset + i * sizeof(VDFEntry));
+
+        if ((e.type & VDF_ENTRY_DIRECTORY) != 0)
+            continue;
+
+        // Names are padded with spaces
+        std::string name(e.name, strnlen(e.name, sizeof(e.name)));
+        name.erase(name.find_last_not_of(' ') + 1);
+
+        if (name.empty() || uint64_t(e.offset) + e.size > size)
+            continue;
+
+        addFile(Utils::uppered(name), {archive, e.offset, e.size});
+    }
+
+    return true;
+}
+
+bool MappedArchives::parseZIP(uint32_t archive)
+{
+    const uint8_t* data = m_Archives[archive]->getData();
+    size_t size = m_Archives[archive]->getSize();
+
+    if (size < ZIP_END_OF_CENTRAL_DIR_SIZE)
+        return false;
+
+    // The end-of-central-directory record is followed by a comment of up to 64k
+    size_t eocd = size - ZIP_END_OF_CENTRAL_DIR_SIZE;
+    size_t searchEnd = eocd > 0xFFFF ? eocd - 0xFFFF : 0;
+    while (readAt<uint32_t>(data, eocd) != ZIP_END_OF_CENTRAL_DIR)
+    {
+        if (eocd == searchEnd)
+            return false;
+
+        eocd--;
+    }
+
+    uint16_t numEntries = readAt<uint16_t>(data, eocd + 10);
+    size_t pos = readAt<uint32_t>(data, eocd + 16);
+
+    // Files in zips are usually compressed, so they are only registered here to keep the priority
+    // between archives intact. Reading them goes through the file-index.
+    for (uint16_t i = 0; i < numEntries; i++)
+    {
+        if (pos + ZIP_CENTRAL_DIR_ENTRY_SIZE > size || readAt<uint32_t>(data, pos) != ZIP_CENTRAL_DIR_ENTRY)
+            return false;
+
+        uint16_t nameLength = readAt<uint16_t>(data, pos + 28);
+        uint16_t extraLength = readAt<uint16_t>(data, pos + 30);
+        uint16_t commentLength = readAt<uint16_t>(data, pos + 32);
+
+        if (pos + ZIP_CENTRAL_DIR_ENTRY_SIZE + nameLength > size)
+            return false;
+
+        std::string path(reinterpret_cast<const char*>(data + pos + ZIP_CENTRAL_DIR_ENTRY_SIZE), nameLength);
+        size_t slash = path.find_last_of("/\\");
+        std::string name = slash == std::string::npos ? path : path.substr(slash + 1);
+
+        if (!name.empty())
+            addFile(Utils::uppered(name), {Location::NOT_MAPPED, 0, 0});
+
+        pos += ZIP_CENTRAL_DIR_ENTRY_SIZE + nameLength + extraLength + commentLength;
+    }
+
+    // Nothing to view in place
+    m_Archives[archive].reset();
+
+    return true;
+}
+
+void MappedArchives::addFile(const std::string& name, const Location& location)
+{
+    if (m_Files.emplace(name, location).second && location.archive != Location::NOT_MAPPED)
+        m_NumMappedFiles++;
+}
+
+bool MappedArchives::getMappedSize(const std::string& name, size_t& size) const
+{
+    auto it = m_Files.find(Utils::uppered(name));
+    if (it == m_Files.end() || it->second.archive == Location::NOT_MAPPED || !m_Archives[it->second.archive])
+        return false;
+
+    size = static_cast<size_t>(it->second.size);
+    return true;
+}
+
+FileView MappedArchives::getFile(const VDFS::FileIndex& idx, const std::string& name) const
+{
+    FileView view;
+
+    if (&idx == m_pIndex)
+    {
+        auto it = m_Files.find(Utils::uppered(name));
+        if (it != m_Files.end() && it->second.archive != Location::NOT_MAPPED && m_Archives[it->second.archive])
+        {
+            const std::shared_ptr<Utils::MappedFile>& file = m_Archives[it->second.archive];
+
+            view.m_Data = file->getData() + it->second.offset;
+            view.m_Size = static_cast<size_t>(it->second.size);
+            view.m_IsMapped = true;
+            view.m_Token = file;
+
+            return view;
+        }
+    }
+
+    // Not in a mapped archive, copy it out
+    auto copy = std::make_shared<std::vector<uint8_t>>();
+    idx.getFileData(name, *copy);
+
+    if (copy->empty())
+        return view;
+
+    view.m_Data = copy->data();
+    view.m_Size = copy->size();
+    view.m_Token = copy;
+
+    return view;
+}
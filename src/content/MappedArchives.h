@@ -0,0 +1,131 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Utils
+{
+    class MappedFile;
+}
+
+namespace VDFS
+{
+    class FileIndex;
+}
+
+namespace Content
+{
+    /**
+     * Read-only view of a file inside the archives. Keeps the memory it points to alive, so it can be passed around
+     * and outlive the object it was obtained from.
+     */
+    class FileView
+    {
+    public:
+        const uint8_t* getData() const { return m_Data; }
+        size_t getSize() const { return m_Size; }
+        bool empty() const { return m_Size == 0; }
+
+        /**
+         * @return Whether this points directly into a mapped archive, rather than a copy of the file
+         */
+        bool isMapped() const { return m_IsMapped; }
+
+    private:
+        friend class MappedArchives;
+
+        const uint8_t* m_Data = nullptr;
+        size_t m_Size = 0;
+        bool m_IsMapped = false;
+
+        /**
+         * Whatever owns the memory: A mapped archive or a copied buffer
+         */
+        std::shared_ptr<const void> m_Token;
+    };
+
+    /**
+     * Keeps the archives of a VDFS::FileIndex mapped into memory, so files stored uncompressed inside them can be
+     * read in place instead of copying them out using getFileData().
+     *
+     * Archives must be mounted in the same order as they were loaded into the index, so the same file wins
+     * if multiple archives contain it. Files which can't be viewed directly (compressed files, unknown archive
+     * formats) are read through the index.
+     */
+    class MappedArchives
+    {
+    public:
+        MappedArchives();
+        ~MappedArchives();
+
+        /**
+         * @param index Index the archives are loaded into
+         */
+        void setFileIndex(const VDFS::FileIndex& index) { m_pIndex = &index; }
+
+        /**
+         * Maps the given archive and indexes the files inside. Call after loading it into the file-index.
+         * @return false, if the archive could not be mapped or parsed. Its files will be copied from the index then,
+         *         as will the files of all archives mounted after it.
+         */
+        bool mount(const std::string& archive);
+
+        /**
+         * Gets the given file
+         * @param idx Index to read the file from. Only files of the index set by setFileIndex() are viewed in place,
+         *            everything else is copied from the given index.
+         * @param name Name of the file
+         * @return View of the file. Empty if it doesn't exist.
+         */
+        FileView getFile(const VDFS::FileIndex& idx, const std::string& name) const;
+
+        /**
+         * Gets the size of a file without reading it. Only works for files which can be viewed in place.
+         * @param name Name of the file
+         * @param size Receives the size of the file
+         * @return false, if the file isn't inside a mapped archive
+         */
+        bool getMappedSize(const std::string& name, size_t& size) const;
+
+        /**
+         * @return Number of files which can be viewed in place
+         */
+        size_t getNumMappedFiles() const { return m_NumMappedFiles; }
+
+    private:
+        /**
+         * Where a file is stored. Files with an invalid archive-index have to be copied from the file-index.
+         */
+        struct Location
+        {
+            enum : uint32_t
+            {
+                NOT_MAPPED = UINT32_MAX
+            };
+
+            uint32_t archive;
+            uint64_t offset;
+            uint64_t size;
+        };
+
+        bool parseVDF(uint32_t archive);
+        bool parseZIP(uint32_t archive);
+
+        /**
+         * Registers a file, unless an earlier archive already contained it
+         */
+        void addFile(const std::string& name, const Location& location);
+
+        const VDFS::FileIndex* m_pIndex;
+        std::vector<std::shared_ptr<Utils::MappedFile>> m_Archives;
+        std::unordered_map<std::string, Location> m_Files;
+        size_t m_NumMappedFiles;
+
+        /**
+         * Whether an earlier archive could not be mounted
+         */
+        bool m_MountFailed;
+    };
+}
@@ -15,6 +15,7 @@ bgfx::ShaderHandle Shader::loadShader(const char* basePath, const char* _name)
             break;
 
         case bgfx::RendererType::OpenGL:
+        case bgfx::RendererType::Noop:  // Nothing gets compiled, any valid shader-binary will do
             shaderPath = "shaders/glsl/";
             break;
 
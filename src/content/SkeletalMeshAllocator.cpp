@@ -1,4 +1,5 @@
 #include "SkeletalMeshAllocator.h"
+#include <algorithm>
 #include "VertexTypes.h"
 #include <bgfx/bgfx.h>
 #include <engine/BaseEngine.h>
@@ -161,6 +162,34 @@ Handle::MeshHandle SkeletalMeshAllocator::loadFromPacked(const ZenLoad::PackedSk
     return h;
 }
 
+void SkeletalMeshAllocator::removeMesh(Handle::MeshHandle h)
+{
+    SkelMesh& skelMesh = m_Allocator.getElement(h);
+    WorldSkeletalMesh& mesh = skelMesh.mesh;
+
+    if (skelMesh.loaded)
+    {
+        if (bgfx::isValid(mesh.m_VertexBufferHandle))
+            bgfx::destroy(mesh.m_VertexBufferHandle);
+
+        if (bgfx::isValid(mesh.m_IndexBufferHandle))
+            bgfx::destroy(mesh.m_IndexBufferHandle);
+
+        size_t contentBytes = mesh.m_Vertices.size() * sizeof(WorldSkeletalMeshVertex) + mesh.m_Indices.size() * sizeof(WorldSkeletalMeshIndex);
+        m_EstimatedGPUBytes -= std::min(m_EstimatedGPUBytes, contentBytes);
+    }
+
+    // Only forget the name if it doesn't belong to a newer mesh already
+    auto it = m_MeshesByName.find(skelMesh.name);
+    if (it != m_MeshesByName.end() && it->second == h)
+        m_MeshesByName.erase(it);
+
+    m_Allocator.removeObject(h);
+
+    // The last element was moved into the freed slot, clear its old location to free the vertex-data
+    m_Allocator.getElements()[m_Allocator.getNumObtainedElements()] = SkelMesh();
+}
+
 bool SkeletalMeshAllocator::finalizeLoad(Handle::MeshHandle h)
 {
     WorldSkeletalMesh& mesh = m_Allocator.getElement(h).mesh;
@@ -40,6 +40,13 @@ namespace Meshes
         float getMeshBoundingSphereRadius(Handle::MeshHandle h) { return m_Allocator.getElement(h).boundingSphereRadius; }
         bool isLoaded(Handle::MeshHandle h) { return m_Allocator.getElement(h).loaded; }
         const ZenLoad::zCModelMeshLib& getMeshLib(Handle::MeshHandle h) { return m_Allocator.getElement(h).lib; }
+
+        /**
+         * Frees the given mesh and its GPU-buffers. Needs to run on the main-thread.
+         * The handle is invalid afterwards.
+         */
+        void removeMesh(Handle::MeshHandle h);
+
         /**
          * @return Rough estimation about how much memory the loaded textures need on the GPU in bytes
          */
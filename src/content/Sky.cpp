@@ -12,10 +12,11 @@
 #include <entry/input.h>
 #include <utils/Utils.h>
 #include <utils/cli.h>
+#include <utils/EngineLog.h>
 #include <utils/logger.h>
 #include <engine/WorldMesh.h>
 #include <ZenLib/zenload/zCProgMeshProto.h>
-#include <content/StaticMeshAllocator.h>
+#include <content/AssetCache.h>
 
 using namespace Content;
 
@@ -148,7 +149,7 @@ void Sky::interpolate()
     setupPlaneMeshTexturesForCurrentTime();
 }
 
-void Sky::initSkyState(World::WorldInstance& world, ESkyPresetType type, Sky::SkyState& s, Textures::TextureAllocator& texAlloc)
+void Sky::initSkyState(World::WorldInstance& world, ESkyPresetType type, Sky::SkyState& s, Content::SharedTextureAllocator& texAlloc)
 {
     Math::float3 skyColor_g1 = Math::float3(114, 93, 82) / 255.0f;    // G1
     Math::float3 skyColor_g2 = Math::float3(120, 140, 180) / 255.0f;  // G2
@@ -447,7 +448,7 @@ bool Sky::loadSkyTextureOfLayer(size_t skyStateIdx, size_t layerIdx, const std::
     if(layerIdx >= m_SkyStates[skyStateIdx].layers.size())
         return false;
 
-    Textures::TextureAllocator& textureAllocator = m_World.getTextureAllocator();
+    Content::SharedTextureAllocator& textureAllocator = m_World.getTextureAllocator();
 
     std::string texNameBase = m_SkyStates[skyStateIdx].layers[layerIdx].textureNameBase;
     std::string texNameWorld = insertWorldNameIntoSkyTextureBase(texNameBase, worldname);
@@ -466,11 +467,11 @@ bool Sky::loadSkyTextureOfLayer(size_t skyStateIdx, size_t layerIdx, const std::
             return false;
         }else
         {
-            LogInfo() << "Loaded sky texture (Base): " << texNameBase << ", couldn't find custom texture for world " << worldname << " (Tried " << texNameWorld << ")";
+            RE_LOG_DEBUG(Content) << "Loaded sky texture (Base): " << texNameBase << ", couldn't find custom texture for world " << worldname << " (Tried " << texNameWorld << ")";
         }
     } else
     {
-        LogInfo() << "Loaded sky texture (world-dependent): " << texNameWorld;
+        RE_LOG_DEBUG(Content) << "Loaded sky texture (world-dependent): " << texNameWorld;
     }
 
     m_SkyStates[skyStateIdx].layers[layerIdx].texture = layerTexture;
@@ -5,6 +5,11 @@
 #include <math/mathlib.h>
 #include <array>
 
+namespace Content
+{
+    class SharedTextureAllocator;
+}
+
 namespace World
 {
     class WorldInstance;
@@ -89,7 +94,7 @@ namespace Content
          * @param s state to fill with values
          * @param texAlloc Texture allocator to take the data from
          */
-        static void initSkyState(World::WorldInstance& world, ESkyPresetType type, SkyState& s, Textures::TextureAllocator& texAlloc);
+        static void initSkyState(World::WorldInstance& world, ESkyPresetType type, SkyState& s, Content::SharedTextureAllocator& texAlloc);
 
         /**
          * Fills the m_SkyStates with their preset values
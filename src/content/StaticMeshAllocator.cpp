@@ -1,6 +1,13 @@
 #include "StaticMeshAllocator.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <memory>
+#include <tuple>
+#include <unordered_map>
 #include "VertexTypes.h"
 #include <bgfx/bgfx.h>
+#include <content/BakeCache.h>
 #include <engine/BaseEngine.h>
 #include <utils/logger.h>
 #include <vdfs/fileIndex.h>
@@ -9,6 +16,164 @@
 
 using namespace Meshes;
 
+namespace
+{
+    /**
+     * Levels of detail to generate: Grid-resolution along the largest extent of the mesh and the
+     * screen-size (see WorldStaticMeshLod) below which the level is used
+     */
+    const struct
+    {
+        float gridResolution;
+        float maxScreenSize;
+    } LOD_LEVELS[] = {{24.0f, 0.05f}, {10.0f, 0.02f}};
+
+    /**
+     * Meshes with fewer triangles are not worth simplifying
+     */
+    const size_t LOD_MIN_TRIANGLES = 64;
+
+    /**
+     * Simplifies the given triangles by snapping every vertex to the vertex closest to the center of its grid-cell.
+     * Triangles which collapse are dropped.
+     */
+    void clusterTriangles(const std::vector<WorldStaticMeshVertex>& vertices,
+                          const WorldStaticMeshIndex* indices,
+                          size_t numIndices,
+                          const Utils::BBox3D& bbox,
+                          float cellSize,
+                          std::vector<WorldStaticMeshIndex>& out)
+    {
+        struct Cluster
+        {
+            Math::float3 sum = Math::float3(0, 0, 0);
+            uint32_t count = 0;
+            WorldStaticMeshIndex best = 0;
+            float bestDistance2 = FLT_MAX;
+        };
+
+        auto getCellKey = [&](const Math::float3& p) {
+            uint64_t x = (uint64_t)std::max(0.0f, (p.x - bbox.min.x) / cellSize) & 0x1FFFFF;
+            uint64_t y = (uint64_t)std::max(0.0f, (p.y - bbox.min.y) / cellSize) & 0x1FFFFF;
+            uint64_t z = (uint64_t)std::max(0.0f, (p.z - bbox.min.z) / cellSize) & 0x1FFFFF;
+            return x | (y << 21) | (z << 42);
+        };
+
+        std::unordered_map<uint64_t, Cluster> clusters;
+        for (size_t i = 0; i < numIndices; i++)
+        {
+            Cluster& c = clusters[getCellKey(vertices[indices[i]].Position)];
+            c.sum += vertices[indices[i]].Position;
+            c.count++;
+        }
+
+        for (size_t i = 0; i < numIndices; i++)
+        {
+            const Math::float3& p = vertices[indices[i]].Position;
+            Cluster& c = clusters[getCellKey(p)];
+
+            float distance2 = (p - c.sum * (1.0f / c.count)).lengthSquared();
+            if (distance2 < c.bestDistance2)
+            {
+                c.bestDistance2 = distance2;
+                c.best = indices[i];
+            }
+        }
+
+        for (size_t i = 0; i + 2 < numIndices; i += 3)
+        {
+            WorldStaticMeshIndex a = clusters[getCellKey(vertices[indices[i + 0]].Position)].best;
+            WorldStaticMeshIndex b = clusters[getCellKey(vertices[indices[i + 1]].Position)].best;
+            WorldStaticMeshIndex c = clusters[getCellKey(vertices[indices[i + 2]].Position)].best;
+
+            if (a == b || b == c || a == c)
+                continue;
+
+            out.push_back(a);
+            out.push_back(b);
+            out.push_back(c);
+        }
+    }
+
+    /**
+     * Bake-cache payload of a static mesh
+     */
+    void writeMesh(const WorldStaticMesh& mesh, Content::BakeCache::Writer& w)
+    {
+        w.write(mesh.bBox3D);
+        w.write(mesh.boundingSphereRadius);
+        w.writeVector(mesh.mesh.m_Vertices);
+        w.writeVector(mesh.mesh.m_Indices);
+        w.writeVector(mesh.mesh.m_SubmeshStarts);
+
+        w.write<uint32_t>(static_cast<uint32_t>(mesh.mesh.m_SubmeshMaterials.size()));
+        for (const Materials::TexturedMaterial& m : mesh.mesh.m_SubmeshMaterials)
+        {
+            w.writeString(m.m_TextureName);
+            w.write<uint8_t>(m.m_NoCollision ? 1 : 0);
+        }
+
+        w.write<uint32_t>(static_cast<uint32_t>(mesh.mesh.m_SubmeshMaterialNames.size()));
+        for (const std::string& n : mesh.mesh.m_SubmeshMaterialNames)
+            w.writeString(n);
+
+        w.write<uint32_t>(static_cast<uint32_t>(mesh.lods.size()));
+        for (const WorldStaticMeshLod& lod : mesh.lods)
+        {
+            w.write(lod.maxScreenSize);
+            w.writeVector(lod.submeshes);
+        }
+    }
+
+    bool readMesh(Content::BakeCache::Reader& r, WorldStaticMesh& mesh)
+    {
+        if (!r.read(mesh.bBox3D)
+            || !r.read(mesh.boundingSphereRadius)
+            || !r.readVector(mesh.mesh.m_Vertices)
+            || !r.readVector(mesh.mesh.m_Indices)
+            || !r.readVector(mesh.mesh.m_SubmeshStarts))
+            return false;
+
+        uint32_t numMaterials;
+        if (!r.read(numMaterials))
+            return false;
+
+        mesh.mesh.m_SubmeshMaterials.resize(numMaterials);
+        for (Materials::TexturedMaterial& m : mesh.mesh.m_SubmeshMaterials)
+        {
+            uint8_t noCollision;
+            if (!r.readString(m.m_TextureName) || !r.read(noCollision))
+                return false;
+
+            m.m_NoCollision = noCollision != 0;
+        }
+
+        uint32_t numNames;
+        if (!r.read(numNames))
+            return false;
+
+        mesh.mesh.m_SubmeshMaterialNames.resize(numNames);
+        for (std::string& n : mesh.mesh.m_SubmeshMaterialNames)
+        {
+            if (!r.readString(n))
+                return false;
+        }
+
+        uint32_t numLods;
+        if (!r.read(numLods))
+            return false;
+
+        mesh.lods.resize(numLods);
+        for (WorldStaticMeshLod& lod : mesh.lods)
+        {
+            if (!r.read(lod.maxScreenSize) || !r.readVector(lod.submeshes))
+                return false;
+        }
+
+        return true;
+    }
+}
+
 StaticMeshAllocator::StaticMeshAllocator(Engine::BaseEngine& engine)
     : GenericMeshAllocator(&engine.getVDFSIndex())
     , m_Engine(engine)
@@ -75,7 +240,11 @@ Handle::MeshHandle StaticMeshAllocator::loadFromPackedSubmesh(const ZenLoad::Pac
     return h;
 }
 
-Handle::MeshHandle StaticMeshAllocator::loadFromPackedTriList(const ZenLoad::PackedMesh& packed, const std::string& name, bool triangles)
+Handle::MeshHandle StaticMeshAllocator::loadFromPackedSubmeshCells(const ZenLoad::PackedMesh& packed,
+                                                                   size_t submesh,
+                                                                   float cellSize,
+                                                                   std::vector<Utils::BBox3D>& cellBoxes,
+                                                                   const std::string& name)
 {
     // Create mesh instance
     Handle::MeshHandle h = m_Allocator.createObject();
@@ -83,6 +252,111 @@ Handle::MeshHandle StaticMeshAllocator::loadFromPackedTriList(const ZenLoad::Pac
     mesh.loaded = false;
     mesh.name = name;
 
+    auto& m = packed.subMeshes[submesh];
+    mesh.init();
+
+    auto getPosition = [&](size_t index) {
+        const auto& p = packed.vertices[m.indices[index]].Position;
+        return Math::float3(p.x, p.y, p.z);
+    };
+
+    // Sort triangles into cells by their centroid. Cells are kept in a map so the output is deterministic.
+    std::map<std::tuple<int, int, int>, std::vector<size_t>> trianglesByCell;
+    for (size_t t = 0; t + 2 < m.indices.size(); t += 3)
+    {
+        Math::float3 centroid = (getPosition(t + 0) + getPosition(t + 1) + getPosition(t + 2)) * (1.0f / 3.0f);
+
+        std::tuple<int, int, int> cell(0, 0, 0);
+        if (cellSize > 0.0f)
+        {
+            cell = std::make_tuple((int)std::floor(centroid.x / cellSize),
+                                   (int)std::floor(centroid.y / cellSize),
+                                   (int)std::floor(centroid.z / cellSize));
+        }
+
+        trianglesByCell[cell].push_back(t);
+    }
+
+    mesh.mesh.m_Vertices.reserve(m.indices.size());
+    mesh.bBox3D.min = Math::float3(FLT_MAX, FLT_MAX, FLT_MAX);
+    mesh.bBox3D.max = Math::float3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+
+    for (const auto& cell : trianglesByCell)
+    {
+        Utils::BBox3D box = {Math::float3(FLT_MAX, FLT_MAX, FLT_MAX), Math::float3(-FLT_MAX, -FLT_MAX, -FLT_MAX)};
+        for (size_t t : cell.second)
+        {
+            for (size_t j = 0; j < 3; j++)
+            {
+                Math::float3 p = getPosition(t + j);
+                box.min = Math::float3(std::min(box.min.x, p.x), std::min(box.min.y, p.y), std::min(box.min.z, p.z));
+                box.max = Math::float3(std::max(box.max.x, p.x), std::max(box.max.y, p.y), std::max(box.max.z, p.z));
+            }
+        }
+
+        Math::float3 center = box.min * 0.5f + box.max * 0.5f;
+
+        size_t start = mesh.mesh.m_Vertices.size();
+        for (size_t t : cell.second)
+        {
+            for (size_t j = 0; j < 3; j++)
+            {
+                mesh.mesh.m_Vertices.push_back(Meshes::vertexCast<WorldStaticMeshVertex>(packed.vertices[m.indices[t + j]]));
+                mesh.mesh.m_Vertices.back().Position -= center;
+            }
+        }
+
+        mesh.mesh.m_SubmeshStarts.push_back({static_cast<WorldStaticMeshIndex>(start),
+                                             static_cast<WorldStaticMeshIndex>(mesh.mesh.m_Vertices.size() - start)});
+
+        mesh.mesh.m_SubmeshMaterials.emplace_back();
+        mesh.mesh.m_SubmeshMaterials.back().m_TextureName = m.material.texture;
+        mesh.mesh.m_SubmeshMaterials.back().m_NoCollision = m.material.noCollDet;
+        mesh.mesh.m_SubmeshMaterials.back().m_MatGroup = (ZenLoad::MaterialGroup)m.material.matGroup;
+        mesh.mesh.m_SubmeshMaterialNames.push_back(m.material.texture);
+
+        cellBoxes.push_back(box);
+
+        mesh.bBox3D.min = Math::float3(std::min(mesh.bBox3D.min.x, box.min.x), std::min(mesh.bBox3D.min.y, box.min.y), std::min(mesh.bBox3D.min.z, box.min.z));
+        mesh.bBox3D.max = Math::float3(std::max(mesh.bBox3D.max.x, box.max.x), std::max(mesh.bBox3D.max.y, box.max.y), std::max(mesh.bBox3D.max.z, box.max.z));
+    }
+
+    mesh.boundingSphereRadius = (mesh.bBox3D.max - mesh.bBox3D.min).length() * 0.5f;
+
+    mesh.mesh.m_IndexBufferHandle.idx = bgfx::kInvalidHandle;
+    mesh.mesh.m_VertexBufferHandle.idx = bgfx::kInvalidHandle;
+
+    m_Engine.getJobManager().executeInMainThread<void>([this, h](Engine::BaseEngine* pEngine) {
+        finalizeLoad(h);
+    });
+
+    m_MeshesByName[name] = h;
+
+    return h;
+}
+
+Handle::MeshHandle StaticMeshAllocator::loadFromPackedTriList(const ZenLoad::PackedMesh& packed, const std::string& name, bool triangles, bool generateLods)
+{
+    // Create mesh instance
+    Handle::MeshHandle h = m_Allocator.createObject();
+    WorldStaticMesh& mesh = m_Allocator.getElement(h);
+    buildFromPacked(mesh, packed, name, triangles, generateLods);
+
+    m_Engine.getJobManager().executeInMainThread<void>([this, h](Engine::BaseEngine* pEngine) {
+        bgfx::frame();  // Flush the pipeline to prevent an overflow
+        finalizeLoad(h);
+    });
+
+    m_MeshesByName[name] = h;
+
+    return h;
+}
+
+void StaticMeshAllocator::buildFromPacked(WorldStaticMesh& mesh, const ZenLoad::PackedMesh& packed, const std::string& name, bool triangles, bool generateLods)
+{
+    mesh.loaded = false;
+    mesh.name = name;
+
     mesh.init();
 
     mesh.bBox3D.min = packed.bbox[0].v;
@@ -145,6 +419,34 @@ Handle::MeshHandle StaticMeshAllocator::loadFromPackedTriList(const ZenLoad::Pac
         }
     }
 
+    if (generateLods && !triangles)
+        this->generateLods(mesh);
+
+    mesh.mesh.m_IndexBufferHandle.idx = bgfx::kInvalidHandle;
+    mesh.mesh.m_VertexBufferHandle.idx = bgfx::kInvalidHandle;
+}
+
+Handle::MeshHandle StaticMeshAllocator::loadBaked(const VDFS::FileIndex& idx, const std::string& sourceFile, const std::string& name)
+{
+    Content::BakeCache::Entry entry;
+    if (!m_Engine.getBakeCache().find(Content::BakeCache::EKind::StaticMesh, sourceFile, idx, entry))
+        return Handle::MeshHandle::makeInvalidHandle();
+
+    Handle::MeshHandle h = m_Allocator.createObject();
+    WorldStaticMesh& mesh = m_Allocator.getElement(h);
+    mesh.loaded = false;
+    mesh.name = name;
+
+    mesh.init();
+
+    Content::BakeCache::Reader r = entry.getReader();
+    if (!readMesh(r, mesh))
+    {
+        LogWarn() << "Bake-cache: Entry for " << sourceFile << " is broken, loading from archives";
+        removeMesh(h);
+        return Handle::MeshHandle::makeInvalidHandle();
+    }
+
     mesh.mesh.m_IndexBufferHandle.idx = bgfx::kInvalidHandle;
     mesh.mesh.m_VertexBufferHandle.idx = bgfx::kInvalidHandle;
 
@@ -158,6 +460,116 @@ Handle::MeshHandle StaticMeshAllocator::loadFromPackedTriList(const ZenLoad::Pac
     return h;
 }
 
+void StaticMeshAllocator::storeBaked(const VDFS::FileIndex& idx, const std::string& sourceFile, Handle::MeshHandle h)
+{
+    Content::BakeCache& bakeCache = m_Engine.getBakeCache();
+    if (!bakeCache.isEnabled() || !h.isValid())
+        return;
+
+    Content::BakeCache::Writer w;
+    writeMesh(m_Allocator.getElement(h), w);
+
+    bakeCache.store(Content::BakeCache::EKind::StaticMesh, sourceFile, idx, w.getData());
+}
+
+bool StaticMeshAllocator::bakeMeshVDF(const VDFS::FileIndex& idx, const std::string& sourceFile)
+{
+    // Already up to date?
+    Content::BakeCache::Entry entry;
+    if (m_Engine.getBakeCache().find(Content::BakeCache::EKind::StaticMesh, sourceFile, idx, entry))
+        return true;
+
+    ZenLoad::zCProgMeshProto zmsh(sourceFile, idx);
+    if (zmsh.getNumSubmeshes() == 0)
+        return false;
+
+    ZenLoad::PackedMesh packed;
+    zmsh.packMesh(packed, 1.0f / 100.0f);
+
+    // Built like a loaded .MRM, but never put into the allocator
+    std::unique_ptr<WorldStaticMesh> mesh = std::make_unique<WorldStaticMesh>();
+    buildFromPacked(*mesh, packed, sourceFile, false, true);
+
+    Content::BakeCache::Writer w;
+    writeMesh(*mesh, w);
+
+    return m_Engine.getBakeCache().store(Content::BakeCache::EKind::StaticMesh, sourceFile, idx, w.getData());
+}
+
+void StaticMeshAllocator::generateLods(WorldStaticMesh& mesh)
+{
+    if (mesh.mesh.m_Indices.size() / 3 < LOD_MIN_TRIANGLES)
+        return;
+
+    Math::float3 extent = mesh.bBox3D.max - mesh.bBox3D.min;
+    float largestExtent = std::max(extent.x, std::max(extent.y, extent.z));
+    if (largestExtent <= 0.0f)
+        return;
+
+    size_t numIndicesBefore = mesh.mesh.m_Indices.size();
+    for (const auto& level : LOD_LEVELS)
+    {
+        WorldStaticMeshLod lod;
+        lod.maxScreenSize = level.maxScreenSize;
+
+        size_t numLodIndices = 0;
+        for (const Meshes::SubmeshVxInfo& submesh : mesh.mesh.m_SubmeshStarts)
+        {
+            std::vector<WorldStaticMeshIndex> simplified;
+            clusterTriangles(mesh.mesh.m_Vertices,
+                             mesh.mesh.m_Indices.data() + submesh.m_StartIndex,
+                             submesh.m_NumIndices,
+                             mesh.bBox3D,
+                             largestExtent / level.gridResolution,
+                             simplified);
+
+            lod.submeshes.push_back({static_cast<WorldStaticMeshIndex>(mesh.mesh.m_Indices.size()),
+                                     static_cast<WorldStaticMeshIndex>(simplified.size())});
+
+            mesh.mesh.m_Indices.insert(mesh.mesh.m_Indices.end(), simplified.begin(), simplified.end());
+            numLodIndices += simplified.size();
+        }
+
+        // Not worth a level of its own, coarser levels won't do much better
+        if (numLodIndices * 4 > numIndicesBefore * 3)
+        {
+            mesh.mesh.m_Indices.resize(lod.submeshes.front().m_StartIndex);
+            break;
+        }
+
+        mesh.lods.push_back(lod);
+        numIndicesBefore = numLodIndices;
+    }
+}
+
+void StaticMeshAllocator::removeMesh(Handle::MeshHandle h)
+{
+    WorldStaticMesh& mesh = m_Allocator.getElement(h);
+
+    if (mesh.loaded)
+    {
+        if (bgfx::isValid(mesh.mesh.m_VertexBufferHandle))
+            bgfx::destroy(mesh.mesh.m_VertexBufferHandle);
+
+        if (bgfx::isValid(mesh.mesh.m_IndexBufferHandle))
+            bgfx::destroy(mesh.mesh.m_IndexBufferHandle);
+
+        size_t contentBytes = mesh.mesh.m_Vertices.size() * sizeof(WorldStaticMeshVertex)
+                            + mesh.mesh.m_Indices.size() * sizeof(WorldStaticMeshIndex);
+        m_EstimatedGPUBytes -= std::min(m_EstimatedGPUBytes, contentBytes);
+    }
+
+    // Only forget the name if it doesn't belong to a newer mesh already
+    auto it = m_MeshesByName.find(mesh.name);
+    if (it != m_MeshesByName.end() && it->second == h)
+        m_MeshesByName.erase(it);
+
+    m_Allocator.removeObject(h);
+
+    // The last element was moved into the freed slot, clear its old location to free the vertex-data
+    m_Allocator.getElements()[m_Allocator.getNumObtainedElements()] = WorldStaticMesh();
+}
+
 bool StaticMeshAllocator::finalizeLoad(Handle::MeshHandle h)
 {
     WorldStaticMesh& mesh = m_Allocator.getElement(h);
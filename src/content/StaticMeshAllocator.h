@@ -20,11 +20,29 @@ namespace Meshes
     typedef uint32_t WorldStaticMeshIndex;
     typedef LevelMesh::StaticLevelMesh<WorldStaticMeshVertex, WorldStaticMeshIndex> WorldStaticMeshData;
 
+    /**
+     * Simplified version of a mesh
+     */
+    struct WorldStaticMeshLod
+    {
+        /**
+         * This level is used once the bounding-sphere-radius of the mesh divided by its distance to the camera
+         * goes below this value
+         */
+        float maxScreenSize;
+
+        /**
+         * Index-ranges replacing the ones of the full-resolution submeshes
+         */
+        std::vector<Meshes::SubmeshVxInfo> submeshes;
+    };
+
     struct WorldStaticMesh : public Handle::HandleTypeDescriptor<Handle::MeshHandle>
     {
         void init()
         {
             instanceDataBufferIndex = (uint32_t)-1;
+            lods.clear();
         }
 
         WorldStaticMeshData mesh;
@@ -32,6 +50,12 @@ namespace Meshes
         Utils::BBox3D bBox3D;
         float boundingSphereRadius;
 
+        /**
+         * Levels of detail, from fine to coarse. Their indices are stored in the same index-buffer, behind
+         * the ones of the full-resolution mesh. Empty if none were generated.
+         */
+        std::vector<WorldStaticMeshLod> lods;
+
         // Slot where the instance-buffer for meshes of these kind is. Needs to be initialized manually.
         uint32_t instanceDataBufferIndex;
         bool loaded;
@@ -58,14 +82,43 @@ namespace Meshes
          * @param Whether the vertices are already triangles and we do not need to use an index buffer
          * @return Handle to the mesh from this allocator
          */
-        Handle::MeshHandle loadFromPackedTriList(const ZenLoad::PackedMesh& packed, const std::string& name = "", bool triangles = false);
+        Handle::MeshHandle loadFromPackedTriList(const ZenLoad::PackedMesh& packed, const std::string& name = "", bool triangles = false, bool generateLods = false);
         Handle::MeshHandle loadFromPacked(const ZenLoad::PackedMesh& packed, const std::string& name = "") override { return loadFromPackedTriList(packed, name, false); }
+        Handle::MeshHandle loadFromPackedProgMesh(const ZenLoad::PackedMesh& packed, const std::string& name = "") override { return loadFromPackedTriList(packed, name, false, true); }
         Handle::MeshHandle loadFromPackedSubmesh(const ZenLoad::PackedMesh& packed, size_t submesh, const std::string& name = "");
 
+        /**
+         * Like loadFromPackedSubmesh, but splits the triangles of the submesh into cells of a regular grid, so they
+         * can be culled separately. Every non-empty cell becomes its own submesh of the created mesh.
+         * The vertices of a cell are stored relative to the center of its bounding-box, so the cell can be
+         * placed and culled like any other object.
+         * @param cellSize Edge-length of a grid-cell. Values <= 0 put all triangles into a single cell.
+         * @param cellBoxes Output: World-space bounding-box of every created submesh
+         */
+        Handle::MeshHandle loadFromPackedSubmeshCells(const ZenLoad::PackedMesh& packed,
+                                                      size_t submesh,
+                                                      float cellSize,
+                                                      std::vector<Utils::BBox3D>& cellBoxes,
+                                                      const std::string& name = "");
+
+        /**
+         * Processes the given .MRM-file like loadMeshVDF would and puts the result into the bake-cache,
+         * without loading it
+         * @return false, if the mesh could not be loaded or stored
+         */
+        bool bakeMeshVDF(const VDFS::FileIndex& idx, const std::string& sourceFile);
+
         /**
          * @brief Returns the texture of the given handle
          */
         WorldStaticMesh& getMesh(Handle::MeshHandle h) { return m_Allocator.getElement(h); }
+
+        /**
+         * Frees the given mesh and its GPU-buffers. Needs to run on the main-thread.
+         * The handle is invalid afterwards.
+         */
+        void removeMesh(Handle::MeshHandle h);
+
         /**
          * @return Rough estimation about how much memory the loaded textures need on the GPU in bytes
          */
@@ -84,6 +137,20 @@ namespace Meshes
          */
         bool finalizeLoad(Handle::MeshHandle h);
 
+        /**
+         * Fills the given mesh from the packed data. See loadFromPackedTriList.
+         */
+        void buildFromPacked(WorldStaticMesh& mesh, const ZenLoad::PackedMesh& packed, const std::string& name, bool triangles, bool generateLods);
+
+        Handle::MeshHandle loadBaked(const VDFS::FileIndex& idx, const std::string& sourceFile, const std::string& name) override;
+        void storeBaked(const VDFS::FileIndex& idx, const std::string& sourceFile, Handle::MeshHandle h) override;
+
+        /**
+         * Generates simplified versions of all submeshes of the given mesh by vertex-clustering and appends
+         * their indices to the index-buffer. Must be done before the mesh is finalized.
+         */
+        void generateLods(WorldStaticMesh& mesh);
+
         /**
          * Data allocator
          */
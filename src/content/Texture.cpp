@@ -1,6 +1,9 @@
 #include "Texture.h"
+#include <algorithm>
 #include <bgfx/bgfx.h>
+#include <content/BakeCache.h>
 #include <engine/BaseEngine.h>
+#include <utils/EngineLog.h>
 #include <utils/logger.h>
 #include <vdfs/fileIndex.h>
 #include <zenload/ztex2dds.h>
@@ -23,13 +26,14 @@ TextureAllocator::~TextureAllocator()
     for (size_t i = 0; i < m_Allocator.getNumObtainedElements(); i++)
     {
         bgfx::TextureHandle h = m_Allocator.getElements()[i].m_TextureHandle;
-        bgfx::destroy(h);
+        if (bgfx::isValid(h))
+            bgfx::destroy(h);
     }
 
     m_EstimatedGPUBytes = 0;
 }
 
-Handle::TextureHandle TextureAllocator::loadTextureDDS(const std::vector<uint8_t>& data, const std::string& name)
+Handle::TextureHandle TextureAllocator::loadTextureDDS(std::vector<uint8_t> data, const std::string& name)
 {
     // Check if this was already loaded
     auto it = m_TexturesByName.find(name);
@@ -39,12 +43,12 @@ Handle::TextureHandle TextureAllocator::loadTextureDDS(const std::vector<uint8_t
     // Make wrapper-object
     Handle::TextureHandle h = m_Allocator.createObject();
 
+    ZenLoad::DDSURFACEDESC2 desc = ZenLoad::getSurfaceDesc(data);
+
     m_Allocator.getElement(h).textureFormat = bgfx::TextureFormat::Unknown;
-    m_Allocator.getElement(h).imageData = data;
-    //m_Allocator.getElement(h).m_TextureHandle = bth;
+    m_Allocator.getElement(h).imageData = std::move(data);
+    m_Allocator.getElement(h).m_TextureHandle.idx = bgfx::kInvalidHandle;
     m_Allocator.getElement(h).m_TextureName = name;
-
-    ZenLoad::DDSURFACEDESC2 desc = ZenLoad::getSurfaceDesc(data);
     m_Allocator.getElement(h).m_Width = desc.dwWidth;
     m_Allocator.getElement(h).m_Height = desc.dwHeight;
 
@@ -60,7 +64,7 @@ Handle::TextureHandle TextureAllocator::loadTextureDDS(const std::vector<uint8_t
     return h;
 }
 
-Handle::TextureHandle TextureAllocator::loadTextureRGBA8(const std::vector<uint8_t>& data, uint16_t width, uint16_t height, const std::string& name)
+Handle::TextureHandle TextureAllocator::loadTextureRGBA8(std::vector<uint8_t> data, uint16_t width, uint16_t height, const std::string& name)
 {
     // Check if this was already loaded
     auto it = m_TexturesByName.find(name);
@@ -72,14 +76,13 @@ Handle::TextureHandle TextureAllocator::loadTextureRGBA8(const std::vector<uint8
     //void* out = stbi_load_from_memory( data.data(), data.size(), (int*)&width, (int*)&height, &comp, 4);
 
     // Try to load the texture first, so we don't have to clean up if this fails
-    //TODO: Avoid the second copy here
 
     // Make wrapper-object
     Handle::TextureHandle h = m_Allocator.createObject();
 
     m_Allocator.getElement(h).textureFormat = bgfx::TextureFormat::RGBA8;
-    m_Allocator.getElement(h).imageData = data;
-    //m_Allocator.getElement(h).m_TextureHandle = bth;
+    m_Allocator.getElement(h).imageData = std::move(data);
+    m_Allocator.getElement(h).m_TextureHandle.idx = bgfx::kInvalidHandle;
     m_Allocator.getElement(h).m_TextureName = name;
     m_Allocator.getElement(h).m_Width = width;
     m_Allocator.getElement(h).m_Height = height;
@@ -103,6 +106,37 @@ Handle::TextureHandle TextureAllocator::loadTextureVDF(const VDFS::FileIndex& id
     if (it != m_TexturesByName.end())
         return (*it).second;
 
+    std::vector<uint8_t> data;
+    bool asDDS;
+    uint16_t width, height;
+    if (!loadTextureData(idx, name, data, asDDS, width, height))
+        return Handle::TextureHandle::makeInvalidHandle();
+
+    Handle::TextureHandle h;
+    if (asDDS)
+    {
+        // Proceed to load as usual dds-file and the input-name
+        h = loadTextureDDS(std::move(data), name);
+    }
+    else
+    {
+        h = loadTextureRGBA8(std::move(data), width, height, name);
+    }
+
+    m_Engine.getJobManager().executeInMainThread<void>([this, h](Engine::BaseEngine* pEngine) {
+        finalizeLoad(h);
+    });
+
+    return h;
+}
+
+bool TextureAllocator::loadTextureData(const VDFS::FileIndex& idx,
+                                       const std::string& name,
+                                       std::vector<uint8_t>& data,
+                                       bool& asDDS,
+                                       uint16_t& width,
+                                       uint16_t& height)
+{
     std::string vname = name;
     std::vector<uint8_t> ztex;
     std::vector<uint8_t> dds;
@@ -117,21 +151,42 @@ Handle::TextureHandle TextureAllocator::loadTextureVDF(const VDFS::FileIndex& id
         vname += "-C.TEX";
     }
 
+    // Already decoded during an earlier run?
+    Content::BakeCache& bakeCache = m_Engine.getBakeCache();
+    Content::BakeCache::Entry entry;
+    if (bakeCache.find(Content::BakeCache::EKind::Texture, vname, idx, entry))
+    {
+        Content::BakeCache::Reader r = entry.getReader();
+
+        uint8_t ddsFlag;
+        if (r.read(ddsFlag) && r.read(width) && r.read(height) && r.readVector(data))
+        {
+            asDDS = ddsFlag != 0;
+            return true;
+        }
+    }
+
     // Load from archive
-    bool asDDS = true;
-    idx.getFileData(vname, ztex);
+    asDDS = true;
+    Content::FileView file = m_Engine.getMappedArchives().getFile(idx, vname);
 
     // No compiled version? Try again as TGA
-    if (ztex.empty())
+    if (file.empty())
     {
         vname = name;
-        idx.getFileData(vname, ztex);
+        file = m_Engine.getMappedArchives().getFile(idx, vname);
         asDDS = false;
     }
 
     // Failed?
-    if (ztex.empty())
-        return Handle::TextureHandle::makeInvalidHandle();
+    if (file.empty())
+        return false;
+
+    uint64_t sourceHash = bakeCache.isEnabled() ? Content::BakeCache::hashData(file.getData(), file.getSize()) : 0;
+
+    // This is the only copy made of the file, as the result of the decoding is moved into the texture
+    ztex.assign(file.getData(), file.getData() + file.getSize());
+    file = Content::FileView();
 
     if (asDDS)
     {
@@ -142,7 +197,7 @@ Handle::TextureHandle TextureAllocator::loadTextureVDF(const VDFS::FileIndex& id
 #if EMSCRIPTEN
     if (asDDS)
     {
-        LogInfo() << "Converting DDS to RGBA8 for: " << name;
+        RE_LOG_DEBUG(Content) << "Converting DDS to RGBA8 for: " << name;
         // Android doesn't support DDS for the most part
         ztex.clear();
         ZenLoad::convertDDSToRGBA8(dds, ztex);
@@ -150,23 +205,33 @@ Handle::TextureHandle TextureAllocator::loadTextureVDF(const VDFS::FileIndex& id
     }
 #endif
 
-    Handle::TextureHandle h;
-    if (asDDS)
-    {
-        // Proceed to load as usual dds-file and the input-name
-        h = loadTextureDDS(dds, name);
-    }
-    else
+    ZenLoad::DDSURFACEDESC2 desc = ZenLoad::getSurfaceDesc(dds);
+    width = (uint16_t)desc.dwWidth;
+    height = (uint16_t)desc.dwHeight;
+
+    data = asDDS ? std::move(dds) : std::move(ztex);
+
+    if (bakeCache.isEnabled())
     {
-        ZenLoad::DDSURFACEDESC2 desc = ZenLoad::getSurfaceDesc(dds);
-        h = loadTextureRGBA8(ztex, (uint16_t)desc.dwWidth, (uint16_t)desc.dwHeight, name);
+        Content::BakeCache::Writer w;
+        w.write<uint8_t>(asDDS ? 1 : 0);
+        w.write(width);
+        w.write(height);
+        w.writeVector(data);
+
+        bakeCache.store(Content::BakeCache::EKind::Texture, vname, sourceHash, w.getData());
     }
 
-    m_Engine.getJobManager().executeInMainThread<void>([this, h](Engine::BaseEngine* pEngine) {
-        finalizeLoad(h);
-    });
+    return true;
+}
 
-    return h;
+bool TextureAllocator::bakeTextureVDF(const VDFS::FileIndex& idx, const std::string& name)
+{
+    std::vector<uint8_t> data;
+    bool asDDS;
+    uint16_t width, height;
+
+    return loadTextureData(idx, name, data, asDDS, width, height);
 }
 
 Handle::TextureHandle TextureAllocator::loadTextureVDF(const std::string& name)
@@ -174,6 +239,27 @@ Handle::TextureHandle TextureAllocator::loadTextureVDF(const std::string& name)
     return loadTextureVDF(m_Engine.getVDFSIndex(), name);
 }
 
+void TextureAllocator::removeTexture(Handle::TextureHandle h)
+{
+    Texture& tx = m_Allocator.getElement(h);
+
+    if (bgfx::isValid(tx.m_TextureHandle))
+    {
+        bgfx::destroy(tx.m_TextureHandle);
+        m_EstimatedGPUBytes -= std::min(m_EstimatedGPUBytes, tx.imageData.size());
+    }
+
+    // Only forget the name if it doesn't belong to a newer texture already
+    auto it = m_TexturesByName.find(tx.m_TextureName);
+    if (it != m_TexturesByName.end() && it->second == h)
+        m_TexturesByName.erase(it);
+
+    m_Allocator.removeObject(h);
+
+    // The last element was moved into the freed slot, clear its old location to free the image-data
+    m_Allocator.getElements()[m_Allocator.getNumObtainedElements()] = Texture();
+}
+
 bool TextureAllocator::finalizeLoad(Handle::TextureHandle h)
 {
     Texture& tx = m_Allocator.getElement(h);
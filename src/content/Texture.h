@@ -40,8 +40,8 @@ namespace Textures
         /**
          * @brief Loads a texture from the given DDS-Data
          */
-        Handle::TextureHandle loadTextureDDS(const std::vector<uint8_t>& data, const std::string& name = "");
-        Handle::TextureHandle loadTextureRGBA8(const std::vector<uint8_t>& data, uint16_t width, uint16_t height, const std::string& name = "");
+        Handle::TextureHandle loadTextureDDS(std::vector<uint8_t> data, const std::string& name = "");
+        Handle::TextureHandle loadTextureRGBA8(std::vector<uint8_t> data, uint16_t width, uint16_t height, const std::string& name = "");
 
         /**
          * @brief Loads a ZTEX-texture from the given or stored VDFS-FileIndex
@@ -49,10 +49,23 @@ namespace Textures
         Handle::TextureHandle loadTextureVDF(const VDFS::FileIndex& idx, const std::string& name);
         Handle::TextureHandle loadTextureVDF(const std::string& name);
 
+        /**
+         * Decodes the given texture into the bake-cache, without loading it
+         * @return false, if the texture does not exist
+         */
+        bool bakeTextureVDF(const VDFS::FileIndex& idx, const std::string& name);
+
         /**
          * @brief Returns the texture of the given handle
          */
         Texture& getTexture(Handle::TextureHandle h) { return m_Allocator.getElement(h); }
+
+        /**
+         * Frees the given texture and its GPU-resources. Needs to run on the main-thread.
+         * The handle is invalid afterwards.
+         */
+        void removeTexture(Handle::TextureHandle h);
+
         /**
          * @return Rough estimation about how much memory the loaded textures need on the GPU in bytes
          */
@@ -65,6 +78,18 @@ namespace Textures
          */
         bool finalizeLoad(Handle::TextureHandle h);
 
+        /**
+         * Reads the given texture from the bake-cache, or from the archives and decodes it
+         * @param data Output: DDS-file or raw RGBA8-data, depending on asDDS
+         * @return false, if the texture does not exist
+         */
+        bool loadTextureData(const VDFS::FileIndex& idx,
+                             const std::string& name,
+                             std::vector<uint8_t>& data,
+                             bool& asDDS,
+                             uint16_t& width,
+                             uint16_t& height);
+
         /**
          * @brief Textures by their set names. Note: If names are doubled, only the last loaded texture
          *		  can be found here
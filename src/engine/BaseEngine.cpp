@@ -1,12 +1,18 @@
 #include "BaseEngine.h"
+#include <algorithm>
 #include <fstream>
 #include "World.h"
 #include "audio/AudioEngine.h"
+#include <content/AssetCache.h>
 #include <bx/commandline.h>
+#include <bx/timer.h>
 #include <components/EntityActions.h>
 #include <components/Vob.h>
 #include <components/VobClasses.h>
 #include <logic/PlayerController.h>
+#include <logic/messages/MessagePool.h>
+#include <memory/AllocationTracker.h>
+#include <memory/FrameArena.h>
 #include <render/WorldRender.h>
 #include <ui/Hud.h>
 #include <ui/LoadingScreen.h>
@@ -37,6 +43,30 @@ namespace Flags
     Cli::Flag sndDevice("snd", "sound-device", 1, "OpenAL sound device", {""}, "Sound");
 
     Cli::Flag noTextureFiltering("nf", "disable-filtering", 0, "Disables texture filtering");
+
+    Cli::Flag bakeCacheDirectory("", "bake-cache", 1, "Directory to keep processed textures and meshes in, to speed up loading. Empty to disable.", {""}, "Data");
+    Cli::Flag bakeAssets("", "bake-assets", 0, "Processes all textures and meshes into the bake-cache before starting. Needs --bake-cache.");
+}
+
+namespace
+{
+    /**
+     * Sorts the given archives by modification-time, newest first. Looks at every file only once.
+     */
+    void sortNewestFirst(std::list<std::string>& archives)
+    {
+        std::vector<std::pair<int64_t, std::string>> byTime;
+        for (const std::string& s : archives)
+            byTime.emplace_back(static_cast<int64_t>(VDFS::FileIndex::getLastModTime(s)), s);
+
+        std::stable_sort(byTime.begin(), byTime.end(), [](const std::pair<int64_t, std::string>& lhs, const std::pair<int64_t, std::string>& rhs) {
+            return lhs.first > rhs.first;
+        });
+
+        archives.clear();
+        for (auto& a : byTime)
+            archives.push_back(std::move(a.second));
+    }
 }
 
 BaseEngine::BaseEngine()
@@ -51,6 +81,9 @@ BaseEngine::BaseEngine()
 
     m_BasicGameType = Daedalus::GameType::GT_Gothic2;
     m_Paused = false;
+
+    m_AssetCache = std::make_unique<Content::AssetCache>(*this);
+
     // allocate and init default session
     resetSession();
 }
@@ -90,6 +123,13 @@ void BaseEngine::initEngine(int argc, char** argv)
 
     loadArchives();
 
+    std::string bakeCacheDirectory = Flags::bakeCacheDirectory.getParam(0);
+    if (!bakeCacheDirectory.empty())
+        m_BakeCache.init(bakeCacheDirectory, Content::BakeCache::makeArchiveFingerprint(m_LoadedArchives));
+
+    if (Flags::bakeAssets.isSet())
+        bakeAssets();
+
     if (m_Args.startupZEN.empty() || !m_FileIndex.hasFile(m_Args.startupZEN))
     {
         // Try Gothic 1
@@ -126,6 +166,10 @@ void BaseEngine::initEngine(int argc, char** argv)
 void BaseEngine::frameUpdate(double dt, uint16_t width, uint16_t height)
 {
     onFrameUpdate(dt * getGameClock().getGameEngineSpeedFactor(), width, height);
+
+    Logic::EventMessages::MessagePools::endFrame();
+    Memory::FrameArena::endFrame();
+    Memory::AllocationTracker::endFrame();
 }
 
 void BaseEngine::loadArchives()
@@ -134,36 +178,84 @@ void BaseEngine::loadArchives()
     if (!m_Args.modfile.empty())
     {
         LogInfo() << "Reading Mod-File from Commandline: " << m_Args.modfile;
-        m_FileIndex.loadVDF(m_Args.modfile);
+        m_LoadedArchives.push_back(m_Args.modfile);
     }
 
     // Load mod archives
     std::list<std::string> modArchives = Utils::getFilesInDirectory(m_Args.gameBaseDirectory + "/Data", "mod", false);
-    modArchives.sort([](const std::string &lhs, const std::string &rhs)
-    { return VDFS::FileIndex::getLastModTime(lhs) > VDFS::FileIndex::getLastModTime(rhs); });
+    sortNewestFirst(modArchives);
     LogInfo() << "Loading MOD-Archives: " << modArchives;
-    if (!modArchives.empty())
-        for (std::string& s : modArchives)
-            m_FileIndex.loadVDF(s);
+    m_LoadedArchives.insert(m_LoadedArchives.end(), modArchives.begin(), modArchives.end());
 
     // Load zip archives
     std::list<std::string> zipArchives = Utils::getFilesInDirectory(m_Args.gameBaseDirectory + "/Data", "zip", false);
-    zipArchives.sort([](const std::string &lhs, const std::string &rhs)
-    { return VDFS::FileIndex::getLastModTime(lhs) > VDFS::FileIndex::getLastModTime(rhs); });
+    sortNewestFirst(zipArchives);
     LogInfo() << "Loading ZIP-Archives: " << zipArchives;
-    if (!zipArchives.empty())
-        for (std::string& s : zipArchives)
-            m_FileIndex.loadVDF(s);
+    m_LoadedArchives.insert(m_LoadedArchives.end(), zipArchives.begin(), zipArchives.end());
 
     // Load vdf archives
     std::list<std::string> vdfArchives = Utils::getFilesInDirectory(m_Args.gameBaseDirectory + "/Data", "vdf");
-    vdfArchives.sort([](const std::string &lhs, const std::string &rhs)
-    { return VDFS::FileIndex::getLastModTime(lhs) > VDFS::FileIndex::getLastModTime(rhs); });
+    sortNewestFirst(vdfArchives);
     LogInfo() << "Loading VDF-Archives: " << vdfArchives;
-    for (std::string& s : vdfArchives)
+    m_LoadedArchives.insert(m_LoadedArchives.end(), vdfArchives.begin(), vdfArchives.end());
+
+    int64_t start = bx::getHPCounter();
+
+    for (const std::string& s : m_LoadedArchives)
         m_FileIndex.loadVDF(s);
 
     m_FileIndex.finalizeLoad();
+
+    // Map all archives in the same order, so files can be read from them without copying
+    m_MappedArchives.setFileIndex(m_FileIndex);
+    for (const std::string& s : m_LoadedArchives)
+        m_MappedArchives.mount(s);
+
+    LogInfo() << "Loaded " << m_LoadedArchives.size() << " archives in "
+              << (bx::getHPCounter() - start) * 1000.0 / bx::getHPFrequency() << "ms, "
+              << m_MappedArchives.getNumMappedFiles() << " files can be read in place";
+}
+
+void BaseEngine::bakeAssets()
+{
+    if (!m_BakeCache.isEnabled())
+    {
+        LogWarn() << "Can't bake assets without a bake-cache, use --bake-cache to set one";
+        return;
+    }
+
+    LogInfo() << "Baking assets...";
+
+    int64_t start = bx::getHPCounter();
+    size_t numTextures = 0, numMeshes = 0, numFailed = 0;
+
+    for (std::string file : m_FileIndex.getKnownFiles())
+    {
+        Utils::upper(file);
+
+        const std::string compiledTexture = "-C.TEX";
+        if (file.size() > compiledTexture.size()
+            && file.compare(file.size() - compiledTexture.size(), compiledTexture.size(), compiledTexture) == 0)
+        {
+            // Textures are requested by the name of their uncompiled version
+            std::string name = file.substr(0, file.size() - compiledTexture.size()) + ".TGA";
+
+            if (m_AssetCache->getTextureAllocator().bakeTextureVDF(m_FileIndex, name))
+                numTextures++;
+            else
+                numFailed++;
+        }
+        else if (Utils::splitExtension(file).second == ".MRM")
+        {
+            if (m_AssetCache->getStaticMeshAllocator().bakeMeshVDF(m_FileIndex, file))
+                numMeshes++;
+            else
+                numFailed++;
+        }
+    }
+
+    LogInfo() << "Baked " << numTextures << " textures and " << numMeshes << " meshes in "
+              << (bx::getHPCounter() - start) / double(bx::getHPFrequency()) << "s (" << numFailed << " failed)";
 }
 
 void BaseEngine::onWorldCreated(Handle::WorldHandle world)
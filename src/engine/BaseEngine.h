@@ -3,6 +3,8 @@
 #include "World.h"
 #include "JobManager.h"
 #include <bx/commandline.h>
+#include <content/BakeCache.h>
+#include <content/MappedArchives.h>
 #include <engine/GameClock.h>
 #include <engine/GameSession.h>
 #include <engine/World.h>
@@ -24,6 +26,11 @@ namespace Audio
     class AudioEngine;
 }
 
+namespace Content
+{
+    class AssetCache;
+}
+
 namespace Engine
 {
     class GameSession;
@@ -74,6 +81,23 @@ namespace Engine
          * @return Main VDF-Archive
          */
         VDFS::FileIndex& getVDFSIndex() { return m_FileIndex; }
+
+        /**
+         * @return On-disk cache for processed textures, meshes and collision-data
+         */
+        Content::BakeCache& getBakeCache() { return m_BakeCache; }
+
+        /**
+         * @return Memory-mapped view of the archives in the main VDF-Archive, to read files without copying them
+         */
+        const Content::MappedArchives& getMappedArchives() { return m_MappedArchives; }
+
+        /**
+         * Reads a file from the main VDF-Archive, in place if possible
+         * @return View of the file, empty if it doesn't exist
+         */
+        Content::FileView getFileView(const std::string& name) { return m_MappedArchives.getFile(m_FileIndex, name); }
+
         /**
          * Returns the world-instance of the given handle.
          * Note: Do not save this pointer somewhere! It may change!
@@ -136,6 +160,11 @@ namespace Engine
          * @return Allocator for always present textures
          */
         Textures::TextureAllocator& getEngineTextureAlloc() { return m_EngineTextureAlloc; }
+
+        /**
+         * @return Textures, meshes and animations shared between all worlds
+         */
+        Content::AssetCache& getAssetCache() { return *m_AssetCache; }
         /**
          * @return data-access to the main world
          */
@@ -191,6 +220,11 @@ namespace Engine
          */
         virtual void loadArchives();
 
+        /**
+         * Processes all textures and meshes found in the archives into the bake-cache
+         */
+        void bakeAssets();
+
         /**
          * Enum with values for Gothic I and Gothic II
          */
@@ -201,6 +235,26 @@ namespace Engine
          */
         VDFS::FileIndex m_FileIndex;
 
+        /**
+         * Paths of all archives loaded into m_FileIndex, in load-order
+         */
+        std::vector<std::string> m_LoadedArchives;
+
+        /**
+         * The archives of m_FileIndex, mapped into memory
+         */
+        Content::MappedArchives m_MappedArchives;
+
+        /**
+         * Processed assets from earlier runs
+         */
+        Content::BakeCache m_BakeCache;
+
+        /**
+         * Assets shared between worlds. Must outlive the session, since the worlds release their assets on destruction.
+         */
+        std::unique_ptr<Content::AssetCache> m_AssetCache;
+
         /**
          * Game session, stores information that should be reset on starting a new game/loading
          * unique_ptr is used, because we can't overwrite the session itself,
@@ -0,0 +1,274 @@
+#include "Benchmark.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <bgfx/bgfx.h>
+#include <bx/platform.h>
+#include <bx/timer.h>
+#include <engine/GameEngine.h>
+#include <engine/World.h>
+#include <logic/CameraController.h>
+#include <ui/Hud.h>
+#include <ui/LoadingScreen.h>
+#include <utils/cli.h>
+#include <utils/logger.h>
+
+#if BX_PLATFORM_WINDOWS
+#include <windows.h>
+#include <psapi.h>
+#ifdef _MSC_VER
+#pragma comment(lib, "psapi.lib")
+#endif
+#elif !BX_PLATFORM_EMSCRIPTEN
+#include <sys/resource.h>
+#endif
+
+using namespace Engine;
+using json = nlohmann::json;
+
+namespace Flags
+{
+    Cli::Flag benchmark("", "benchmark", 1, "Plays the camera-path stored in the given file (see 'savekf'-command) on the startup-world and writes a performance-report afterwards", {""});
+    Cli::Flag benchmarkReport("", "benchmark-report", 1, "File the benchmark-report is written to", {"benchmark.json"});
+    Cli::Flag benchmarkTimestep("", "benchmark-timestep", 1, "Fixed timestep in seconds to use while benchmarking", {"0.0166667"});
+    Cli::Flag benchmarkWarmup("", "benchmark-warmup", 1, "Number of frames to skip before measuring, after the world was loaded", {"30"});
+}
+
+namespace
+{
+    /**
+     * @return Peak resident memory of this process in bytes, 0 if unknown
+     */
+    size_t getPeakMemoryUsage()
+    {
+#if BX_PLATFORM_WINDOWS
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            return counters.PeakWorkingSetSize;
+
+        return 0;
+#elif BX_PLATFORM_EMSCRIPTEN
+        return 0;
+#else
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+            return 0;
+
+#if BX_PLATFORM_OSX
+        return (size_t)usage.ru_maxrss;  // Bytes on OSX
+#else
+        return (size_t)usage.ru_maxrss * 1024;  // Kilobytes everywhere else
+#endif
+#endif
+    }
+
+    /**
+     * @return Nearest-rank percentile of the given, sorted values
+     */
+    template <typename T>
+    T percentile(const std::vector<T>& sorted, double p)
+    {
+        size_t rank = (size_t)std::ceil(p / 100.0 * sorted.size());
+        return sorted[std::min(sorted.size() - 1, rank > 0 ? rank - 1 : 0)];
+    }
+
+    template <typename T>
+    json summarize(std::vector<T> values)
+    {
+        std::sort(values.begin(), values.end());
+
+        double sum = 0.0;
+        for (T v : values)
+            sum += v;
+
+        return {{"min", values.front()},
+                {"mean", sum / values.size()},
+                {"p50", percentile(values, 50)},
+                {"p90", percentile(values, 90)},
+                {"p95", percentile(values, 95)},
+                {"p99", percentile(values, 99)},
+                {"max", values.back()}};
+    }
+}
+
+Benchmark::Benchmark(GameEngine& engine)
+    : m_Engine(engine)
+    , m_State(EState::WaitingForWorld)
+    , m_KeyframeDuration(1.0f)
+    , m_Timestep(1.0f / 60.0f)
+    , m_NumWarmupFrames(0)
+    , m_NumFramesWaited(0)
+    , m_StartTime(bx::getHPCounter())
+    , m_LastFrameEnd(0)
+    , m_WorldLoadTimeMs(0.0)
+{
+}
+
+bool Benchmark::isRequested()
+{
+    return Flags::benchmark.isSet();
+}
+
+bool Benchmark::init()
+{
+    const std::string pathFile = Flags::benchmark.getParam(0);
+    m_ReportFile = Flags::benchmarkReport.getParam(0);
+    m_Timestep = (float)atof(Flags::benchmarkTimestep.getParam(0).c_str());
+    m_NumWarmupFrames = (size_t)std::max(0, atoi(Flags::benchmarkWarmup.getParam(0).c_str()));
+
+    if (m_Timestep <= 0.0f)
+    {
+        LogError() << "Benchmark: Invalid timestep: " << Flags::benchmarkTimestep.getParam(0);
+        return false;
+    }
+
+    std::ifstream f(pathFile);
+    if (!f.is_open())
+    {
+        LogError() << "Benchmark: Failed to open camera-path: " << pathFile;
+        return false;
+    }
+
+    std::stringstream pathData;
+    pathData << f.rdbuf();
+
+    try
+    {
+        m_CameraPath = json::parse(pathData);
+    }
+    catch (const std::exception& e)
+    {
+        LogError() << "Benchmark: Failed to parse camera-path " << pathFile << ": " << e.what();
+        return false;
+    }
+
+    if (m_CameraPath.count("duration"))
+        m_KeyframeDuration = m_CameraPath["duration"].get<float>();
+
+    LogInfo() << "Benchmark: Using camera-path " << pathFile << " with a timestep of " << m_Timestep << "s";
+    return true;
+}
+
+bool Benchmark::startCameraPath()
+{
+    Logic::CameraController* camera = m_Engine.getMainWorld().get().getCameraController();
+    if (!camera || !camera->importKeyframes(m_CameraPath))
+        return false;
+
+    camera->playKeyframes(m_KeyframeDuration);
+    return true;
+}
+
+bool Benchmark::onFrameEnd()
+{
+    const int64_t now = bx::getHPCounter();
+    const double frameTimeMs = (now - m_LastFrameEnd) * 1000.0 / double(bx::getHPFrequency());
+    m_LastFrameEnd = now;
+
+    switch (m_State)
+    {
+        case EState::WaitingForWorld:
+            // The loading-screen gets hidden once the world has been fully registered
+            if (m_Engine.getMainWorld().isValid() && m_Engine.getHud().getLoadingScreen().isHidden())
+            {
+                m_WorldLoadTimeMs = (now - m_StartTime) * 1000.0 / double(bx::getHPFrequency());
+                m_State = EState::Warmup;
+            }
+            break;
+
+        case EState::Warmup:
+            if (m_NumFramesWaited++ < m_NumWarmupFrames)
+                break;
+
+            if (!startCameraPath())
+            {
+                LogError() << "Benchmark: Failed to start the camera-path, aborting";
+                m_State = EState::Done;
+                return true;
+            }
+
+            m_State = EState::Running;
+            break;
+
+        case EState::Running:
+        {
+            World::WorldInstance& world = m_Engine.getMainWorld().get();
+            const Render::FrameStats& stats = m_Engine.getDefaultRenderSystem().getFrameStats();
+
+            size_t numStateChanges = stats.numProgramChanges + stats.numTextureChanges + stats.numMeshChanges + stats.numRenderStateChanges;
+
+            m_Samples.push_back({frameTimeMs, stats.numDrawcalls, stats.numTriangles, stats.numWorldTrianglesCulled,
+                                 stats.numTrianglesSavedByLod, numStateChanges, world.getNumEntitiesUpdated()});
+
+            if (!world.getCameraController()->isPlayingKeyframes())
+            {
+                writeReport();
+                m_State = EState::Done;
+                return true;
+            }
+        }
+        break;
+
+        case EState::Done:
+            return true;
+    }
+
+    return false;
+}
+
+void Benchmark::writeReport()
+{
+    if (m_Samples.empty())
+    {
+        LogError() << "Benchmark: No frames were recorded";
+        return;
+    }
+
+    World::WorldInstance& world = m_Engine.getMainWorld().get();
+
+    std::vector<double> frameTimes;
+    std::vector<size_t> drawcalls, triangles, worldTrianglesCulled, trianglesSavedByLod, stateChanges, entities;
+    for (const FrameSample& s : m_Samples)
+    {
+        frameTimes.push_back(s.frameTimeMs);
+        drawcalls.push_back(s.numDrawcalls);
+        triangles.push_back(s.numTriangles);
+        worldTrianglesCulled.push_back(s.numWorldTrianglesCulled);
+        trianglesSavedByLod.push_back(s.numTrianglesSavedByLod);
+        stateChanges.push_back(s.numStateChanges);
+        entities.push_back(s.numEntitiesUpdated);
+    }
+
+    json stages = json::object();
+    for (const auto& stage : world.getLoadStageTimes())
+        stages[stage.first] = stage.second;
+
+    json report;
+    report["world"] = world.getZenFile();
+    report["renderer"] = bgfx::getRendererName(bgfx::getRendererType());
+    report["timestep"] = m_Timestep;
+    report["numFrames"] = m_Samples.size();
+    report["frameTimeMs"] = summarize(frameTimes);
+    report["drawcalls"] = summarize(drawcalls);
+    report["triangles"] = summarize(triangles);
+    report["worldTrianglesCulled"] = summarize(worldTrianglesCulled);
+    report["trianglesSavedByLod"] = summarize(trianglesSavedByLod);
+    report["stateChanges"] = summarize(stateChanges);
+    report["entitiesUpdated"] = summarize(entities);
+    report["loadTimeMs"] = {{"total", m_WorldLoadTimeMs}, {"stages", stages}};
+    report["peakMemoryBytes"] = getPeakMemoryUsage();
+
+    std::ofstream f(m_ReportFile);
+    if (!f.is_open())
+    {
+        LogError() << "Benchmark: Failed to open " << m_ReportFile << " for writing";
+        return;
+    }
+
+    f << report.dump(4);
+
+    LogInfo() << "Benchmark: " << m_Samples.size() << " frames, mean frametime "
+              << report["frameTimeMs"]["mean"].get<double>() << "ms, p99 "
+              << report["frameTimeMs"]["p99"].get<double>() << "ms. Report written to " << m_ReportFile;
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <json.hpp>
+
+namespace Engine
+{
+    class GameEngine;
+
+    /**
+     * Reproducible performance-measurement: Waits for the startup-world to be loaded, plays a recorded
+     * camera-path using a fixed timestep and writes a machine-readable report once the path is done.
+     *
+     * Activated by passing --benchmark <path.json>. Camera-paths can be recorded ingame using
+     * the 'kf' and 'savekf' console-commands.
+     */
+    class Benchmark
+    {
+    public:
+        Benchmark(GameEngine& engine);
+
+        /**
+         * @return Whether a benchmark was requested on the commandline
+         */
+        static bool isRequested();
+
+        /**
+         * Loads the camera-path given on the commandline
+         * @return false, if the path could not be loaded
+         */
+        bool init();
+
+        /**
+         * @return Fixed timestep in seconds to use instead of the real frametime
+         */
+        float getTimestep() const { return m_Timestep; }
+
+        /**
+         * To be called once per frame, after the frame has been submitted
+         * @return true once the benchmark is done and the report has been written
+         */
+        bool onFrameEnd();
+
+    private:
+
+        enum class EState
+        {
+            WaitingForWorld,
+            Warmup,
+            Running,
+            Done
+        };
+
+        /**
+         * Measurements of a single frame
+         */
+        struct FrameSample
+        {
+            double frameTimeMs;
+            size_t numDrawcalls;
+            size_t numTriangles;
+            size_t numWorldTrianglesCulled;
+            size_t numTrianglesSavedByLod;
+            size_t numStateChanges;
+            size_t numEntitiesUpdated;
+        };
+
+        /**
+         * Sets the camera-path on the main world and starts playing it
+         * @return false, if the world has no camera to move
+         */
+        bool startCameraPath();
+
+        /**
+         * Writes all collected samples to the report-file
+         */
+        void writeReport();
+
+        GameEngine& m_Engine;
+        EState m_State;
+
+        /**
+         * Camera-path to play, as exported by CameraController::exportKeyframes
+         */
+        nlohmann::json m_CameraPath;
+        float m_KeyframeDuration;
+
+        float m_Timestep;
+        size_t m_NumWarmupFrames;
+        size_t m_NumFramesWaited;
+        std::string m_ReportFile;
+
+        int64_t m_StartTime;
+        int64_t m_LastFrameEnd;
+        double m_WorldLoadTimeMs;
+
+        std::vector<FrameSample> m_Samples;
+    };
+}
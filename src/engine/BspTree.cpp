@@ -1,6 +1,7 @@
 #include "BspTree.h"
 #include <debugdraw/debugdraw.h>
 #include <engine/World.h>
+#include <utils/EngineLog.h>
 #include <utils/logger.h>
 #include <logic/ScriptEngine.h>
 
@@ -18,9 +19,9 @@ NodeIndex BspTree::addEntity(Handle::EntityHandle entity)
     // FIXME: Use actual BBox, but the vobs haven't got them initialized yet
     Utils::BBox3D bbox = {position - Math::float3(1, 1, 1), position + Math::float3(1, 1, 1)};
 
-    std::vector<NodeIndex> nodes = findLeafOf(bbox);
+    Memory::FrameVector<NodeIndex> nodes = findLeafOf(bbox);
 
-    LogInfo() << "Nodes: " << nodes;
+    RE_LOG_DEBUG(World) << "Nodes: " << nodes.size();
 
     if (nodes.empty())
         return INVALID_NODE;
@@ -31,9 +32,14 @@ NodeIndex BspTree::addEntity(Handle::EntityHandle entity)
 
 NodeIndex BspTree::findLeafOf(const Math::float3& position)
 {
-    std::function<NodeIndex(NodeIndex)> rec = [&](NodeIndex n) -> NodeIndex {
+    ddSetTransform(nullptr);
+    ddSetColor(0xFF0000FF);
+    assert(!m_Nodes.empty());
 
-        LogInfo() << "Traversed to: " << n;
+    NodeIndex n = 0;
+    while (true)
+    {
+        RE_LOG_LIMITED(World, Trace, 50) << "Traversed to: " << n;
         Aabb b;
         memcpy(&b, &m_Nodes[n].bbox, sizeof(b));
 
@@ -44,34 +50,31 @@ NodeIndex BspTree::findLeafOf(const Math::float3& position)
 
         int p = Utils::pointClassifyToPlane(position, m_Nodes[n].plane);
 
-        switch (p)
-        {
-            case 1:  // Front
-                if (m_Nodes[n].front != INVALID_NODE)
-                    return rec(m_Nodes[n].front);
-
-            case 2:  // Back
-                if (m_Nodes[n].back != INVALID_NODE)
-                    return rec(m_Nodes[n].back);
-
-            case 3:  // Split
-            default:
-                break;
-        }
+        if (p == 1 && m_Nodes[n].front != INVALID_NODE)  // Front
+            n = m_Nodes[n].front;
+        else if ((p == 1 || p == 2) && m_Nodes[n].back != INVALID_NODE)  // Back, or front with only a back-child
+            n = m_Nodes[n].back;
+        else  // Split, or no child on that side but not a leaf either?
+            return n;
+    }
+}
 
-        // No front or back, but not a leaf either?
-        return n;
-    };
+Memory::FrameVector<NodeIndex> BspTree::findLeafOf(const Utils::BBox3D& bbox)
+{
+    Memory::FrameVector<NodeIndex> leafs;
 
     ddSetTransform(nullptr);
-    ddSetColor(0xFF0000FF);
+
     assert(!m_Nodes.empty());
-    return rec(0);
-}
 
-std::vector<NodeIndex> BspTree::findLeafOf(const Utils::BBox3D& bbox)
-{
-    std::function<std::vector<NodeIndex>(const Utils::BBox3D&, NodeIndex)> rec = [&](const Utils::BBox3D& bbox, NodeIndex n) -> std::vector<NodeIndex> {
+    // Depth-first, front before back
+    Memory::FrameVector<NodeIndex> stack;
+    stack.push_back(0);
+
+    while (!stack.empty())
+    {
+        NodeIndex n = stack.back();
+        stack.pop_back();
 
         // LogInfo() << "Traversed to: " << n << " (front: " << m_Nodes[n].front << ", back: " << m_Nodes[n].back << ")";
         Aabb b;
@@ -81,41 +84,39 @@ std::vector<NodeIndex> BspTree::findLeafOf(const Utils::BBox3D& bbox)
         ddDraw(b);
 
         if (m_Nodes[n].isLeaf())
-            return {n};
+        {
+            leafs.push_back(n);
+            continue;
+        }
 
-        int p = Utils::bboxClassifyToPlaneSides(bbox, m_Nodes[n].plane);
+        NodeIndex front = m_Nodes[n].front;
+        NodeIndex back = m_Nodes[n].back;
 
-        switch (p)
+        // Nodes missing the child on one side continue on the other one
+        switch (Utils::bboxClassifyToPlaneSides(bbox, m_Nodes[n].plane))
         {
-            case Utils::PLANE_INFRONT:  // Front
-                if (m_Nodes[n].front != INVALID_NODE)
-                    return rec(bbox, m_Nodes[n].front);
-
-            case Utils::PLANE_BEHIND:  // Back
-                if (m_Nodes[n].back != INVALID_NODE)
-                    return rec(bbox, m_Nodes[n].back);
+            case Utils::PLANE_INFRONT:
+                stack.push_back(front != INVALID_NODE ? front : back);
+                break;
 
-            case Utils::PLANE_SPANNING:  // Split
-            {
-                std::vector<NodeIndex> f = m_Nodes[n].front != INVALID_NODE ? rec(bbox, m_Nodes[n].front) : std::vector<NodeIndex>();
-                std::vector<NodeIndex> b = m_Nodes[n].back != INVALID_NODE ? rec(bbox, m_Nodes[n].back) : std::vector<NodeIndex>();
+            case Utils::PLANE_BEHIND:
+                stack.push_back(back != INVALID_NODE ? back : front);
+                break;
 
-                f.insert(f.end(), b.begin(), b.end());
+            case Utils::PLANE_SPANNING:
+                if (back != INVALID_NODE)
+                    stack.push_back(back);
 
-                return f;
-            }
+                if (front != INVALID_NODE)
+                    stack.push_back(front);
+                break;
 
             default:
-                return {};
+                break;
         }
+    }
 
-        return {};
-    };
-
-    ddSetTransform(nullptr);
-
-    assert(!m_Nodes.empty());
-    return rec(bbox, 0);
+    return leafs;
 }
 
 void BspTree::loadBspTree(const ZenLoad::zCBspTreeData& data)
@@ -146,9 +147,9 @@ void BspTree::debugDraw()
     return;
     Math::float3 pp = m_World.getEntity<Components::PositionComponent>(m_World.getScriptEngine().getPlayerEntity()).m_WorldMatrix.Translation();
     Utils::BBox3D bb = {pp - Math::float3(1, 1, 1), pp + Math::float3(1, 1, 1)};
-    std::vector<NodeIndex> pn = findLeafOf(bb);
+    Memory::FrameVector<NodeIndex> pn = findLeafOf(bb);
 
-    LogInfo() << "pn: " << pn;
+    LogInfo() << "pn: " << pn.size();
     LogInfo() << "pp: " << pp.toString();
     return;
     /*
@@ -1,6 +1,7 @@
 #pragma once
 #include <vector>
 #include <handle/HandleDef.h>
+#include <memory/FrameArena.h>
 #include <utils/Utils.h>
 #include <zenload/zTypes.h>
 
@@ -68,7 +69,13 @@ namespace World
          * @return node this position is in, or INVALID_NODE if none
          */
         NodeIndex findLeafOf(const Math::float3& position);
-        std::vector<NodeIndex> findLeafOf(const Utils::BBox3D& bbox);
+
+        /**
+         * Returns the leafs the given box touches
+         * @param bbox Box to check
+         * @return Leafs found, only valid until the end of the next frame
+         */
+        Memory::FrameVector<NodeIndex> findLeafOf(const Utils::BBox3D& bbox);
 
         /**
          * Debug-rendering
@@ -10,6 +10,7 @@ GameClock::GameClock()
     m_totalTimeInDays = 0;
     m_LastFrameDeltaTime = 0;
     m_TotalSecondsRunning = 0.0;
+    m_NumTimeJumps = 0;
 
     // reset clock speed and game speed to default value on new session
     m_ClockSpeedFactor = 1.0;
@@ -29,6 +30,7 @@ int GameClock::getDay() const
 void GameClock::setDay(int newDay)
 {
     m_totalTimeInDays += newDay - getDay();
+    m_NumTimeJumps++;
 }
 
 void GameClock::update(double deltaRealTimeSeconds)
@@ -56,11 +58,13 @@ std::string GameClock::getDateTimeFormatted() const
 void GameClock::setTimeOfDay(int hours, int minutes)
 {
     m_totalTimeInDays = getDay() + hmToDayTime(hours, minutes);
+    m_NumTimeJumps++;
 }
 
 void GameClock::setTotalSeconds(std::size_t s)
 {
     m_totalTimeInDays = s / static_cast<double>(SECONDS_IN_A_DAY);
+    m_NumTimeJumps++;
 }
 
 std::size_t GameClock::getTotalSeconds()
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 
 namespace Engine
@@ -153,6 +154,15 @@ namespace Engine
          */
         bool isDaytime() const;
 
+        /**
+         * @return Number of times the clock has been set directly, rather than advanced by update().
+         *         Lets users of the time notice jumps, including ones back in time.
+         */
+        uint32_t getNumTimeJumps() const
+        {
+            return m_NumTimeJumps;
+        }
+
         static constexpr unsigned int SECONDS_IN_A_DAY = 24 * 60 * 60;
 
         // Defines how much faster the ingame clock runs compared to the real time clock. Don't change this value
@@ -173,5 +183,8 @@ namespace Engine
 
         // Global speed factor for the engine
         float m_GameEngineSpeedFactor;
+
+        // See getNumTimeJumps()
+        uint32_t m_NumTimeJumps;
     };
 }
\ No newline at end of file
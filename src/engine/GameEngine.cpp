@@ -9,17 +9,20 @@
 #include <components/Vob.h>
 #include <entry/input.h>
 #include <logic/CameraController.h>
+#include <memory/AllocationTracker.h>
 #include <render/RenderSystem.h>
 #include <render/WorldRender.h>
 #include <utils/logger.h>
 #include <components/Vob.h>
 #include <utils/cli.h>
+#include <utils/FrameProfiler.h>
 
 using namespace Engine;
 
 namespace Flags
 {
     Cli::Flag drawDistance("rdist", "render-distance", 1, "Renderdistance multiplicator", {"1"}, {"Rendering"});
+    Cli::Flag lodBias("", "lod-bias", 1, "Multiplicator for the distance at which static meshes switch to simplified versions. 0 disables levels of detail", {"1"}, {"Rendering"});
 }
 
 const float DRAW_DISTANCE = 100.0f;
@@ -60,6 +63,8 @@ void GameEngine::initEngine(int argc, char** argv)
 
 void GameEngine::onFrameUpdate(double dt, uint16_t width, uint16_t height)
 {
+    RE_PROFILE_SCOPE("GameEngine::onFrameUpdate");
+
     // Debug only
     //    static bool lastLogicDisableKeyState = false;
     //    static bool disableLogic = false;
@@ -92,6 +97,8 @@ void GameEngine::onFrameUpdate(double dt, uint16_t width, uint16_t height)
 
             // Finally, update main camera
             getMainWorld().get().getCameraController()->onUpdateExplicit(dt);
+
+            getSession().getWorldPreloader().onFrameUpdate();
         }
     }
     drawFrame(width, height);
@@ -99,6 +106,9 @@ void GameEngine::onFrameUpdate(double dt, uint16_t width, uint16_t height)
 
 void GameEngine::drawFrame(uint16_t width, uint16_t height)
 {
+    RE_PROFILE_SCOPE("GameEngine::drawFrame");
+    RE_ALLOCATION_SCOPE(Tag_Render);
+
     Math::Matrix view;
     if (getMainWorld().isValid())
         view = Components::Actions::Position::makeViewMatrixFrom(getMainWorld().get().getComponentAllocator(), getMainWorld().get().getCamera());
@@ -128,6 +138,7 @@ void GameEngine::drawFrame(uint16_t width, uint16_t height)
     if (getMainWorld().isValid())
         m_DefaultRenderSystem.getConfig().state.cameraWorld = getMainWorld().get().getCameraComp<Components::PositionComponent>().m_WorldMatrix;
     m_DefaultRenderSystem.getConfig().state.drawDistanceSquared = drawDistanceTotal * drawDistanceTotal;
+    m_DefaultRenderSystem.getConfig().state.lodBias = (float)atof(Flags::lodBias.getParam(0).c_str());
     m_DefaultRenderSystem.getConfig().state.farPlane = farPlane;
     m_DefaultRenderSystem.getConfig().state.viewWidth = width;
     m_DefaultRenderSystem.getConfig().state.viewHeight = height;
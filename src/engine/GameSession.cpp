@@ -6,17 +6,21 @@
 #include <fstream>
 #include "ui/Hud.h"
 #include "ui/LoadingScreen.h"
+#include <content/AssetCache.h>
 #include <components/VobClasses.h>
 #include <logic/PlayerController.h>
 #include <logic/ScriptEngine.h>
 #include <logic/DialogManager.h>
 #include <logic/CameraController.h>
 #include <logic/MusicController.h>
+#include <utils/FrameProfiler.h>
+#include <utils/JsonBinary.h>
 
 using namespace Engine;
 
 GameSession::GameSession(BaseEngine& engine)
-    : m_Engine(engine)
+    : m_WorldPreloader(engine)
+    , m_Engine(engine)
 {
     m_CurrentSlotIndex = -1;
     setupKeyBindings();
@@ -31,7 +35,11 @@ GameSession::~GameSession()
 
 void GameSession::addInactiveWorld(const std::string& worldName, nlohmann::json&& exportedWorld)
 {
-    m_InactiveWorlds[worldName] = exportedWorld;
+    PackedWorld& packed = m_InactiveWorlds[worldName];
+    packed = Utils::JsonBinary::encode(exportedWorld);
+
+    LogInfo() << "Keeping inactive world " << worldName << " in " << packed.size() / 1024 << " KB ("
+              << m_InactiveWorlds.size() << " inactive worlds, " << getInactiveWorldsMemory() / 1024 << " KB total)";
 }
 
 bool GameSession::hasInactiveWorld(const std::string& worldName)
@@ -39,21 +47,35 @@ bool GameSession::hasInactiveWorld(const std::string& worldName)
     return m_InactiveWorlds.find(worldName) != m_InactiveWorlds.end();
 }
 
-std::map<std::string, nlohmann::json>& GameSession::getInactiveWorlds()
+std::map<std::string, GameSession::PackedWorld>& GameSession::getInactiveWorlds()
 {
     return m_InactiveWorlds;
 }
 
+size_t GameSession::getInactiveWorldsMemory()
+{
+    size_t bytes = 0;
+    for (const auto& pair : m_InactiveWorlds)
+        bytes += pair.second.size();
+
+    return bytes;
+}
+
 nlohmann::json GameSession::retrieveInactiveWorld(const std::string& worldName)
 {
-    if (hasInactiveWorld(worldName))
+    auto it = m_InactiveWorlds.find(worldName);
+    if (it == m_InactiveWorlds.end())
+        return nlohmann::json();
+
+    nlohmann::json worldJson;
+    if (!Utils::JsonBinary::decode((*it).second, worldJson))
     {
-        nlohmann::json worldJson(std::move(m_InactiveWorlds[worldName]));
-        m_InactiveWorlds.erase(worldName);
-        return worldJson;
+        LogError() << "Failed to decode inactive world: " << worldName;
+        worldJson = nlohmann::json();
     }
-    else
-        return nlohmann::json();
+
+    m_InactiveWorlds.erase(it);
+    return worldJson;
 }
 
 GameClock& GameSession::getGameClock()
@@ -93,8 +115,7 @@ std::unique_ptr<World::WorldInstance> GameSession::createWorld(const std::string
     }
     if (!worldFile.empty())
     {
-        std::vector<uint8_t> zenData;
-        m_Engine.getVDFSIndex().getFileData(worldFile, zenData);
+        Content::FileView zenData = m_Engine.getFileView(worldFile);
 
         if (zenData.empty())
         {
@@ -102,7 +123,12 @@ std::unique_ptr<World::WorldInstance> GameSession::createWorld(const std::string
             return nullptr;
         }
     }
-    if (!world.init(worldFile, worldJson, scriptEngine, dialogManager, logManager))  // expensive operation
+    // Take over what was already loaded in the background, if the player walked into a level-change
+    std::unique_ptr<PreloadedZen> preloaded;
+    if (!worldFile.empty())
+        preloaded = m_WorldPreloader.adopt(worldFile);
+
+    if (!world.init(worldFile, worldJson, scriptEngine, dialogManager, logManager, std::move(preloaded)))  // expensive operation
     {
         LogError() << "Failed to init world file: " << worldFile;
         return nullptr;
@@ -121,6 +147,9 @@ Handle::WorldHandle GameSession::registerWorld(std::unique_ptr<World::WorldInsta
     m_WorldInstances.push_back(std::move(pWorldInstance));
     m_Worlds.push_back(world.getMyHandle());
 
+    // The new world has picked up everything it shares with the previous one, free the rest
+    m_Engine.getAssetCache().collectGarbage();
+
     return world.getMyHandle();
 }
 
@@ -142,9 +171,9 @@ void GameSession::removeWorld(Handle::WorldHandle world)
     m_Engine.onWorldRemoved(world);
 }
 
-void GameSession::switchToWorld(const std::string& worldFile)
+void GameSession::switchToWorld(const std::string& worldFile, const std::string& startVob)
 {
-    auto switchToWorld_ = [worldFile](BaseEngine* engine) {
+    auto switchToWorld_ = [worldFile, startVob](BaseEngine* engine) {
 
         json newWorldJson;
         json exportedPlayer;
@@ -189,23 +218,48 @@ void GameSession::switchToWorld(const std::string& worldFile)
          */
         using UniqueWorld = std::unique_ptr<World::WorldInstance>;
         std::shared_ptr<UniqueWorld> world;
+        Utils::FrameProfiler::setThreadName("World loading");
         world = std::make_shared<UniqueWorld>(engine->getSession().createWorld(worldFile, newWorldJson, scriptEngine));
 
         /**
          * epilog
          */
-        auto registerWorld_ = [world, exportedPlayer ](BaseEngine* engine)
+        auto registerWorld_ = [world, exportedPlayer, startVob](BaseEngine* engine)
         {
             Handle::WorldHandle newWorld = engine->getSession().registerWorld(std::move(*world));
             engine->getSession().setMainWorld(newWorld);
             auto playerNew = newWorld.get().importVobAndTakeControl(exportedPlayer);
+            auto playerVob = VobTypes::asNpcVob(newWorld.get(), playerNew);
+
+            // Destination of the level-change, which may either be a waypoint or a vob
+            bool placed = false;
+            if (!startVob.empty() && playerVob.isValid())
+            {
+                World::WorldInstance& w = newWorld.get();
+                Handle::EntityHandle vob = w.getVobEntityByName(startVob);
+
+                if (World::Waynet::waypointExists(w.getWaynet(), startVob))
+                {
+                    LogInfo() << "Teleporting player to waypoint '" << startVob << "'";
+                    playerVob.playerController->teleportToWaypoint(World::Waynet::getWaypointIndex(w.getWaynet(), startVob));
+                    placed = true;
+                }
+                else if (vob.isValid())
+                {
+                    LogInfo() << "Teleporting player to vob '" << startVob << "'";
+                    playerVob.playerController->teleportToPosition(w.getEntity<Components::PositionComponent>(vob).m_WorldMatrix.Translation());
+                    placed = true;
+                }
+                else
+                {
+                    LogWarn() << "Start-vob '" << startVob << "' of the level-change doesn't exist, using the start-point";
+                }
+            }
 
-            // TODO find out start position after level change
-            std::vector<size_t> startpoints = newWorld.get().findStartPoints();
+            std::vector<size_t> startpoints = placed ? std::vector<size_t>() : newWorld.get().findStartPoints();
 
-            if (!startpoints.empty())
+            if (!startpoints.empty() && playerVob.isValid())
             {
-                auto playerVob = VobTypes::asNpcVob(newWorld.get(), playerNew);
                 std::string startpoint = newWorld.get().getWaynet().waypoints[startpoints.front()].name;
                 LogInfo() << "Teleporting player to startpoint '" << startpoint << "'";
                 playerVob.playerController->teleportToWaypoint(startpoints.front());
@@ -250,6 +304,7 @@ void GameSession::startNewGame(const std::string& worldFile)
 
         using UniqueWorld = std::unique_ptr<World::WorldInstance>;
         std::shared_ptr<UniqueWorld> world;
+        Utils::FrameProfiler::setThreadName("World loading");
         world = std::make_shared<UniqueWorld>(engine->getSession().createWorld(worldFile));
 
         auto registerWorld = [world](Engine::BaseEngine* engine)
@@ -8,6 +8,7 @@
 #include "BaseEngine.h"
 #include "GameClock.h"
 #include "World.h"
+#include "WorldPreloader.h"
 #include <handle/HandleDef.h>
 #include <logic/LogManager.h>
 #include <json/json.hpp>
@@ -25,6 +26,12 @@ namespace Engine
          */
         ~GameSession();
 
+        /**
+         * Inactive worlds are kept encoded with Utils::JsonBinary, as a json-tree of a whole world
+         * takes up many times the memory
+         */
+        typedef std::vector<uint8_t> PackedWorld;
+
         /**
          * Store already visited worlds of the current session
          * @param worldName zen filename including extension
@@ -33,22 +40,28 @@ namespace Engine
         void addInactiveWorld(const std::string& worldName, nlohmann::json&& exportedWorld);
 
         /**
-         * Get the remembered World and removes it from the map if it exists, else returns empty json
+         * Get the remembered World and removes it from the map if it exists, else returns empty json.
+         * The world is only decoded here.
          * @param worldName zen filename including extension
          */
         nlohmann::json retrieveInactiveWorld(const std::string& worldName);
 
         /**
-         * @return refernce to all inactive Worlds of the current session
+         * @return refernce to all inactive Worlds of the current session, encoded with Utils::JsonBinary
          */
-        std::map<std::string, nlohmann::json>& getInactiveWorlds();
+        std::map<std::string, PackedWorld>& getInactiveWorlds();
 
         /**
          * @param worldName zen filename including extension
-         * @return whether a world is currently unloaded to memory as json object
+         * @return whether a world is currently unloaded to memory
          */
         bool hasInactiveWorld(const std::string& worldName);
 
+        /**
+         * @return Bytes held by all inactive worlds
+         */
+        size_t getInactiveWorldsMemory();
+
         /**
          * @return Gameclock
          */
@@ -104,8 +117,10 @@ namespace Engine
          * - world found in current save-game slot on disk
          * - else: First visit. No vobs get imported. <World>_startup script-fu will be executed
          * @param worldFile including .zen extension
+         * @param startVob Waypoint or vob to put the player at, ie. the one of a level-change trigger.
+         *                 Empty to use the start-point of the world.
          */
-        void switchToWorld(const std::string& worldFile);
+        void switchToWorld(const std::string& worldFile, const std::string& startVob = "");
 
         /**
          * starts a new game
@@ -142,6 +157,11 @@ namespace Engine
 
         Logic::LogManager& getLogManager() { return m_LogManager; }
 
+        /**
+         * @return Preloader for the destinations of level-changes near the player
+         */
+        WorldPreloader& getWorldPreloader() { return m_WorldPreloader; }
+
         /**
          * Enables/Disables bindings that control the player
          * @param respectCameraMode if true, will only set bindings if camera mode is not ECameramode::Free
@@ -154,7 +174,7 @@ namespace Engine
         void enableActionBindings(bool enabled);
 
     private:
-        std::map<std::string, nlohmann::json> m_InactiveWorlds;
+        std::map<std::string, PackedWorld> m_InactiveWorlds;
 
         /**
          * last savegame slot used in this session (save or load). Is -1 if "new game" was started
@@ -176,6 +196,11 @@ namespace Engine
          */
         Logic::LogManager m_LogManager;
 
+        /**
+         * Loads the destination of a level-change in the background, before the player crosses over
+         */
+        WorldPreloader m_WorldPreloader;
+
         /**
          * Currently active world instances
          */
@@ -1,5 +1,6 @@
 #include "JobManager.h"
 #include <cassert>
+#include <utils/FrameProfiler.h>
 
 namespace Engine
 {
@@ -28,6 +29,7 @@ void JobManager::queueJob(JobType<void> job)
 void JobManager::processJobs()
 {
     assert(isSameThread());
+    RE_PROFILE_SCOPE("JobManager::processJobs");
 
     // execute all pending synchronous jobs
     {
@@ -0,0 +1,65 @@
+#include "NameTable.h"
+#include <cctype>
+
+using namespace World;
+
+namespace
+{
+    inline unsigned char fold(char c)
+    {
+        return static_cast<unsigned char>(std::toupper(static_cast<unsigned char>(c)));
+    }
+}
+
+size_t NameTable::FoldedHash::operator()(const std::string& s) const
+{
+    // FNV-1a over the folded characters
+    uint64_t hash = 14695981039346656037ull;
+    for (char c : s)
+    {
+        hash ^= fold(c);
+        hash *= 1099511628211ull;
+    }
+
+    return static_cast<size_t>(hash);
+}
+
+bool NameTable::FoldedEqual::operator()(const std::string& a, const std::string& b) const
+{
+    if (a.size() != b.size())
+        return false;
+
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        if (fold(a[i]) != fold(b[i]))
+            return false;
+    }
+
+    return true;
+}
+
+NameId NameTable::intern(const std::string& name)
+{
+    auto it = m_IdsByName.find(name);
+    if (it != m_IdsByName.end())
+        return (*it).second;
+
+    std::string folded = name;
+    for (char& c : folded)
+        c = static_cast<char>(fold(c));
+
+    NameId id = static_cast<NameId>(m_Names.size());
+    m_Names.push_back(folded);
+    m_IdsByName.emplace(std::move(folded), id);
+
+    return id;
+}
+
+NameId NameTable::find(const std::string& name) const
+{
+    auto it = m_IdsByName.find(name);
+    if (it == m_IdsByName.end())
+        return INVALID_NAME;
+
+    return (*it).second;
+}
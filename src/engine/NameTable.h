@@ -0,0 +1,71 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+
+namespace World
+{
+    /**
+     * Id of a name inside a NameTable. Names differing only in case share the same id.
+     */
+    typedef uint32_t NameId;
+    enum : NameId
+    {
+        INVALID_NAME = static_cast<NameId>(-1)
+    };
+
+    /**
+     * Interns the names of things inside a world (vobs, mobs, NPCs, waypoints, visuals). Like in the original game,
+     * names are case-insensitive: every name is case-folded and hashed once, when it is interned. Afterwards, the id
+     * can be used as key for hash-tables and compared without touching the string again.
+     *
+     * Lookups take the name as it comes from scripts or zen-files. No folded copy is made for those.
+     */
+    class NameTable
+    {
+    public:
+        /**
+         * @return Id of the given name. Adds the name, if it wasn't known yet.
+         */
+        NameId intern(const std::string& name);
+
+        /**
+         * @return Id of the given name, INVALID_NAME if it was never interned. Never adds the name, so this is what
+         *         lookups with names from scripts should use.
+         */
+        NameId find(const std::string& name) const;
+
+        /**
+         * @return Case-folded (upper case) version of the name with the given id. The reference stays valid for as
+         *         long as the table exists.
+         */
+        const std::string& getName(NameId id) const { return m_Names[id]; }
+
+        /**
+         * @return Number of names known
+         */
+        size_t getNumNames() const { return m_Names.size(); }
+
+    private:
+        struct FoldedHash
+        {
+            size_t operator()(const std::string& s) const;
+        };
+
+        struct FoldedEqual
+        {
+            bool operator()(const std::string& a, const std::string& b) const;
+        };
+
+        /**
+         * Case-folded names, indexed by their ids. A deque, so interning doesn't move the strings handed out.
+         */
+        std::deque<std::string> m_Names;
+
+        /**
+         * Ids by the case-folded names. Hash and compare ignore case, so the lookup-key doesn't need to be folded.
+         */
+        std::unordered_map<std::string, NameId, FoldedHash, FoldedEqual> m_IdsByName;
+    };
+}
@@ -0,0 +1,361 @@
+#include "VobStreamer.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <set>
+#include "BaseEngine.h"
+#include "World.h"
+#include <components/Vob.h>
+#include <content/AssetCache.h>
+#include <logic/VisualController.h>
+#include <physics/PhysicsSystem.h>
+#include <utils/cli.h>
+#include <utils/FrameProfiler.h>
+#include <utils/logger.h>
+#include <vdfs/fileIndex.h>
+
+using namespace World;
+using json = nlohmann::json;
+
+namespace Flags
+{
+    Cli::Flag streamVobs("", "stream-vobs", 1, "Edge-length in meters of the cells static vobs are streamed in around the camera. 0 creates every vob when the world is loaded", {"0"}, {"Rendering"});
+}
+
+namespace
+{
+    /**
+     * Cells are evicted once they are this much further away than the range they are created at
+     */
+    const float EVICT_FACTOR = 1.25f;
+
+    /**
+     * Meshes of cells up to this much further away than the creation-range are decoded in the background
+     */
+    const float PREFETCH_FACTOR = 1.5f;
+
+    /**
+     * Vobs to create per frame. Cells closer than IMMEDIATE_FACTOR times the range are always created right away,
+     * so the player never stands in front of something missing its collision.
+     */
+    const size_t MAX_CREATED_PER_FRAME = 400;
+    const float IMMEDIATE_FACTOR = 0.5f;
+
+    void expand(Utils::BBox3D& box, const Math::float3& p)
+    {
+        box.min = Math::float3(std::min(box.min.x, p.x), std::min(box.min.y, p.y), std::min(box.min.z, p.z));
+        box.max = Math::float3(std::max(box.max.x, p.x), std::max(box.max.y, p.y), std::max(box.max.z, p.z));
+    }
+}
+
+VobStreamer::VobStreamer(WorldInstance& world)
+    : m_World(world)
+{
+    m_CellSize = std::max(1.0f, static_cast<float>(atof(Flags::streamVobs.getParam(0).c_str())));
+}
+
+VobStreamer::~VobStreamer()
+{
+    if (m_Prefetch.valid())
+        m_Prefetch.wait();
+}
+
+bool VobStreamer::isEnabled()
+{
+    return atof(Flags::streamVobs.getParam(0).c_str()) > 0.0;
+}
+
+bool VobStreamer::canStream(const std::string& objectClass, const std::string& vobName, const std::string& visual)
+{
+    return objectClass == "zCVob"
+           && vobName.empty()
+           && Utils::splitExtension(Utils::uppered(visual)).second == ".3DS";
+}
+
+void VobStreamer::addVob(const Descriptor& descriptor)
+{
+    Math::float3 position = descriptor.transform.Translation();
+
+    int64_t x = static_cast<int64_t>(std::floor(position.x / m_CellSize));
+    int64_t z = static_cast<int64_t>(std::floor(position.z / m_CellSize));
+    uint64_t coords = (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(z);
+
+    auto it = m_CellsByCoords.find(coords);
+    if (it == m_CellsByCoords.end())
+    {
+        it = m_CellsByCoords.emplace(coords, m_Cells.size()).first;
+
+        m_Cells.emplace_back();
+        m_Cells.back().bounds = {position, position};
+    }
+
+    Cell& cell = m_Cells[(*it).second];
+    expand(cell.bounds, position);
+
+    if (descriptor.hasBBox)
+    {
+        expand(cell.bounds, descriptor.bbox.min);
+        expand(cell.bounds, descriptor.bbox.max);
+    }
+
+    cell.vobs.push_back(static_cast<uint32_t>(m_Vobs.size()));
+
+    m_Vobs.emplace_back();
+    m_Vobs.back().descriptor = descriptor;
+
+    m_Stats.numCells = static_cast<uint32_t>(m_Cells.size());
+    m_Stats.numVobs = static_cast<uint32_t>(m_Vobs.size());
+}
+
+bool VobStreamer::addVob(const json& j)
+{
+    if (j.find("logic") != j.end())
+        return false;
+
+    auto jvisual = j.find("visual");
+    if (jvisual == j.end())
+        return false;
+
+    auto jname = (*jvisual).find("name");
+    if (jname == (*jvisual).end() || !(*jname).is_string() || !canStream("zCVob", "", *jname))
+        return false;
+
+    Descriptor descriptor;
+    descriptor.transform = Math::Matrix::CreateIdentity();
+    descriptor.visual = m_World.getNameTable().intern(*jname);
+
+    auto jtrans = (*jvisual).find("transform");
+    if (jtrans != (*jvisual).end())
+    {
+        for (size_t i = 0; i < 16 && i < (*jtrans).size(); i++)
+            if (!(*jtrans)[i].is_null())
+                descriptor.transform.mv[i] = (*jtrans)[i];
+    }
+
+    auto jcollision = (*jvisual).find("collision");
+    descriptor.collision = jcollision != (*jvisual).end() && (*jcollision).is_boolean() && (*jcollision).get<bool>();
+
+    addVob(descriptor);
+    return true;
+}
+
+void VobStreamer::update(const Math::float3& cameraPosition, float range)
+{
+    m_Stats.numCreated = 0;
+    m_Stats.numEvicted = 0;
+
+    if (m_Vobs.empty())
+        return;
+
+    RE_PROFILE_SCOPE("VobStreamer::update");
+
+    bool canPrefetch = m_World.getEngine()->getBakeCache().isEnabled() && !isPrefetching();
+    std::vector<size_t> toPrefetch;
+
+    for (size_t i = 0; i < m_Cells.size(); i++)
+    {
+        Cell& cell = m_Cells[i];
+        float distance = distanceToCell(cameraPosition, cell);
+
+        if (cell.resident)
+        {
+            if (distance > range * EVICT_FACTOR)
+                evictCell(cell);
+        }
+        else if (distance < range)
+        {
+            if (!cell.queued)
+            {
+                cell.queued = true;
+                m_Queue.push_back(i);
+            }
+        }
+        else if (canPrefetch && !cell.prefetched && distance < range * PREFETCH_FACTOR)
+        {
+            toPrefetch.push_back(i);
+        }
+    }
+
+    if (!toPrefetch.empty())
+        prefetch(toPrefetch);
+
+    // Closest cells first
+    std::sort(m_Queue.begin(), m_Queue.end(), [&](size_t a, size_t b) {
+        return distanceToCell(cameraPosition, m_Cells[a]) < distanceToCell(cameraPosition, m_Cells[b]);
+    });
+
+    bool collisionAdded = false;
+    size_t numDone = 0;
+    for (; numDone < m_Queue.size(); numDone++)
+    {
+        Cell& cell = m_Cells[m_Queue[numDone]];
+        float distance = distanceToCell(cameraPosition, cell);
+
+        if (m_Stats.numCreated >= MAX_CREATED_PER_FRAME && distance > range * IMMEDIATE_FACTOR)
+            break;
+
+        cell.queued = false;
+
+        // Might have left the range again while waiting
+        if (distance > range * EVICT_FACTOR)
+            continue;
+
+        m_Stats.numCreated += static_cast<uint32_t>(createCell(cell, collisionAdded));
+    }
+
+    m_Queue.erase(m_Queue.begin(), m_Queue.begin() + numDone);
+
+    // Static collision added after loading needs its bounds updated, like at the end of loading
+    if (collisionAdded)
+        m_World.getPhysicsSystem().postProcessLoad();
+
+    m_Stats.numResidentCells = static_cast<uint32_t>(std::count_if(m_Cells.begin(), m_Cells.end(), [](const Cell& c) {
+        return c.resident;
+    }));
+}
+
+size_t VobStreamer::createCell(Cell& cell, bool& collisionAdded)
+{
+    size_t numCreated = 0;
+    for (uint32_t idx : cell.vobs)
+    {
+        StreamedVob& sv = m_Vobs[idx];
+        if (sv.removed || sv.entity.isValid())
+            continue;
+
+        Descriptor& d = sv.descriptor;
+        Handle::EntityHandle e = ::Vob::constructVob(m_World);
+        ::Vob::VobInformation vob = ::Vob::asVob(m_World, e);
+
+        // Static collision is only added the first time, see class-description
+        bool addCollision = d.collision && !sv.collisionAdded;
+
+        ::Vob::setCollisionEnabled(vob, addCollision);
+        ::Vob::setTransform(vob, d.transform);
+        vob.position->m_DrawDistanceFactor = d.drawDistanceFactor;
+        ::Vob::setVisual(vob, m_World.getNameTable().getName(d.visual));
+
+        vob = ::Vob::asVob(m_World, e);
+        ::Vob::setCollisionEnabled(vob, d.collision);
+
+        if (addCollision)
+        {
+            sv.collisionAdded = true;
+            collisionAdded = true;
+        }
+
+        if (d.hasBBox)
+        {
+            Math::float3 position = d.transform.Translation();
+            ::Vob::setBBox(vob, d.bbox.min - position, d.bbox.max - position, 0);
+
+            if (sv.shadow < 0.0f)
+                sv.shadow = m_World.getShadowValueBelow(position, d.bbox);
+
+            if (::Vob::getVisual(vob))
+                ::Vob::getVisual(vob)->setShadowValue(sv.shadow);
+        }
+
+        sv.entity = e;
+        numCreated++;
+    }
+
+    cell.resident = true;
+    m_Stats.numResidentVobs += static_cast<uint32_t>(numCreated);
+
+    return numCreated;
+}
+
+void VobStreamer::evictCell(Cell& cell)
+{
+    for (uint32_t idx : cell.vobs)
+    {
+        StreamedVob& sv = m_Vobs[idx];
+        if (!sv.entity.isValid())
+            continue;
+
+        m_Stats.numResidentVobs--;
+
+        if (!m_World.isEntityValid(sv.entity))
+        {
+            // Removed by something else while it was around
+            sv.removed = true;
+            sv.entity = Handle::EntityHandle::makeInvalidHandle();
+            m_Stats.numRemovedVobs++;
+            continue;
+        }
+
+        // Keep whatever was changed about the vob
+        ::Vob::VobInformation vob = ::Vob::asVob(m_World, sv.entity);
+        sv.descriptor.transform = vob.position->m_WorldMatrix;
+        sv.descriptor.collision = ::Vob::getCollisionEnabled(vob);
+
+        if (vob.visual)
+            sv.descriptor.visual = m_World.getNameTable().intern(vob.visual->getName());
+
+        m_World.removeEntity(sv.entity);
+        sv.entity = Handle::EntityHandle::makeInvalidHandle();
+
+        m_Stats.numEvicted++;
+    }
+
+    cell.resident = false;
+}
+
+void VobStreamer::prefetch(const std::vector<size_t>& cells)
+{
+    std::set<std::string> meshes;
+    for (size_t c : cells)
+    {
+        m_Cells[c].prefetched = true;
+
+        for (uint32_t idx : m_Cells[c].vobs)
+        {
+            if (!m_Vobs[idx].removed)
+                meshes.insert(Utils::splitExtension(m_World.getNameTable().getName(m_Vobs[idx].descriptor.visual)).first + ".MRM");
+        }
+    }
+
+    m_Prefetch = m_World.getEngine()->getJobManager().executeInThread<void>([meshes](Engine::BaseEngine* engine) {
+        Utils::FrameProfiler::setThreadName("Vob prefetching");
+
+        for (const std::string& mesh : meshes)
+            engine->getAssetCache().getStaticMeshAllocator().bakeMeshVDF(engine->getVDFSIndex(), mesh);
+    }, Engine::ExecutionPolicy::NewThread).share();
+}
+
+bool VobStreamer::isPrefetching()
+{
+    return m_Prefetch.valid() && m_Prefetch.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+}
+
+void VobStreamer::exportVobs(json& jcontrollers)
+{
+    for (StreamedVob& sv : m_Vobs)
+    {
+        // Vobs with an entity are exported along with all other entities
+        if (sv.removed || sv.entity.isValid())
+            continue;
+
+        json jvob;
+        json& jvisual = jvob["visual"];
+        jvisual["type"] = "VisualController";
+
+        for (int i = 0; i < 16; i++)
+            jvisual["transform"].push_back(sv.descriptor.transform.mv[i]);
+
+        jvisual["collision"] = sv.descriptor.collision;
+        jvisual["name"] = m_World.getNameTable().getName(sv.descriptor.visual);
+
+        jcontrollers.push_back(std::move(jvob));
+    }
+}
+
+float VobStreamer::distanceToCell(const Math::float3& position, const Cell& cell)
+{
+    Math::float3 closest(std::max(cell.bounds.min.x, std::min(position.x, cell.bounds.max.x)),
+                         std::max(cell.bounds.min.y, std::min(position.y, cell.bounds.max.y)),
+                         std::max(cell.bounds.min.z, std::min(position.z, cell.bounds.max.z)));
+
+    return (position - closest).length();
+}
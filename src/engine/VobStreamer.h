@@ -0,0 +1,200 @@
+#pragma once
+#include <cstdint>
+#include <future>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <engine/NameTable.h>
+#include <handle/HandleDef.h>
+#include <json/json.hpp>
+#include <math/mathlib.h>
+#include <utils/Utils.h>
+
+namespace World
+{
+    class WorldInstance;
+
+    /**
+     * Keeps the static decoration of a world (plain zCVobs with a mesh-visual and no name) as small descriptors
+     * sorted into grid-cells, and only creates entities for the cells near the camera.
+     *
+     * Cells coming into range are queued and turned into entities over the next frames, a limited number of vobs per
+     * frame. Slightly before that, a background-job decodes the meshes of the cell into the bake-cache, so creating
+     * the entities mostly maps finished data. Cells are only evicted once they are clearly out of range again. On
+     * eviction, the transform, visual and collision of every vob are written back into its descriptor, so changes
+     * made while it was around survive. Vobs removed in the meantime stay removed.
+     *
+     * Static collision can't be taken out of the world again, so it is added the first time a vob is created and kept
+     * from then on.
+     *
+     * Vobs with names, logic or other visuals are always created at load, as scripts and other systems may refer to
+     * them at any time. Disabled unless --stream-vobs is given.
+     */
+    class VobStreamer
+    {
+    public:
+        /**
+         * Everything needed to create the entity of a vob
+         */
+        struct Descriptor
+        {
+            Math::Matrix transform;
+
+            /**
+             * World-space, only known for vobs from zen-files
+             */
+            Utils::BBox3D bbox;
+            bool hasBBox = false;
+
+            NameId visual = INVALID_NAME;
+            float drawDistanceFactor = 1.0f;
+            bool collision = false;
+        };
+
+        struct Stats
+        {
+            uint32_t numCells = 0;
+            uint32_t numResidentCells = 0;
+            uint32_t numVobs = 0;
+            uint32_t numResidentVobs = 0;
+            uint32_t numRemovedVobs = 0;
+
+            // During the last frame
+            uint32_t numCreated = 0;
+            uint32_t numEvicted = 0;
+        };
+
+        VobStreamer(WorldInstance& world);
+
+        /**
+         * Waits for the background-job
+         */
+        ~VobStreamer();
+
+        /**
+         * @return Whether streaming was enabled on the commandline
+         */
+        static bool isEnabled();
+
+        /**
+         * @return Whether a vob with the given properties can be streamed
+         */
+        static bool canStream(const std::string& objectClass, const std::string& vobName, const std::string& visual);
+
+        /**
+         * Adds a vob, without creating its entity yet
+         */
+        void addVob(const Descriptor& descriptor);
+
+        /**
+         * Adds a vob exported by WorldInstance::exportWorld()
+         * @return false, if the vob can't be streamed and has to be imported as usual
+         */
+        bool addVob(const nlohmann::json& j);
+
+        /**
+         * Creates and evicts the entities of the cells around the camera. To be called once per frame.
+         * @param cameraPosition Where to stream around
+         * @param range Distance in meters at which cells are created
+         */
+        void update(const Math::float3& cameraPosition, float range);
+
+        /**
+         * Writes every vob which doesn't currently have an entity, in the format WorldInstance::exportWorld() uses.
+         * Vobs with an entity are exported by the world itself.
+         * @param jcontrollers Array to append to
+         */
+        void exportVobs(nlohmann::json& jcontrollers);
+
+        /**
+         * @return Current statistics, the counts of created and evicted vobs are those of the last frame
+         */
+        const Stats& getStats() const { return m_Stats; }
+
+    private:
+        struct StreamedVob
+        {
+            Descriptor descriptor;
+
+            /**
+             * Shadow-value from the worldmesh, traced the first time the entity is created. Negative until then.
+             */
+            float shadow = -1.0f;
+
+            /**
+             * Valid while the entity exists
+             */
+            Handle::EntityHandle entity;
+
+            bool collisionAdded = false;
+            bool removed = false;
+        };
+
+        struct Cell
+        {
+            /**
+             * Indices into m_Vobs
+             */
+            std::vector<uint32_t> vobs;
+
+            /**
+             * Around the positions of all vobs inside
+             */
+            Utils::BBox3D bounds;
+
+            bool resident = false;
+            bool queued = false;
+            bool prefetched = false;
+        };
+
+        /**
+         * Creates the entities of all vobs inside the given cell
+         * @param collisionAdded Set to true, if static collision was added to the world
+         * @return Number of entities created
+         */
+        size_t createCell(Cell& cell, bool& collisionAdded);
+
+        /**
+         * Writes the state of the entities back into their descriptors and removes them
+         */
+        void evictCell(Cell& cell);
+
+        /**
+         * Starts decoding the meshes of the given cells in the background
+         */
+        void prefetch(const std::vector<size_t>& cells);
+
+        /**
+         * @return Whether the background-job is still running
+         */
+        bool isPrefetching();
+
+        /**
+         * @return Distance from the given position to the bounds of the given cell
+         */
+        static float distanceToCell(const Math::float3& position, const Cell& cell);
+
+        WorldInstance& m_World;
+
+        /**
+         * Edge-length of a cell in meters
+         */
+        float m_CellSize;
+
+        std::vector<StreamedVob> m_Vobs;
+        std::vector<Cell> m_Cells;
+        std::unordered_map<uint64_t, size_t> m_CellsByCoords;
+
+        /**
+         * Cells waiting for their entities to be created, in order of arrival
+         */
+        std::vector<size_t> m_Queue;
+
+        /**
+         * Background-job decoding meshes
+         */
+        std::shared_future<void> m_Prefetch;
+
+        Stats m_Stats;
+    };
+}
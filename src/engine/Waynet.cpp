@@ -16,12 +16,17 @@ using namespace World;
 void Waynet::addWaypoint(WaynetInstance& waynet, const Waypoint& wp)
 {
     waynet.waypoints.push_back(wp);
-    waynet.waypointsByName[wp.name] = waynet.waypoints.size() - 1;
+
+    if (waynet.names)
+        waynet.waypointsByName[waynet.names->intern(wp.name)] = waynet.waypoints.size() - 1;
 }
 
-Waynet::WaynetInstance Waynet::makeWaynetFromZen(const ZenLoad::oCWorldData& zenWorld)
+Waynet::WaynetInstance Waynet::makeWaynetFromZen(const ZenLoad::oCWorldData& zenWorld, NameTable& names)
 {
     WaynetInstance w;
+    w.names = &names;
+    w.waypoints.reserve(zenWorld.waynet.waypoints.size());
+    w.waypointsByName.reserve(zenWorld.waynet.waypoints.size());
 
     // Copy waypoint-information
     for (const ZenLoad::zCWaypointData& zwp : zenWorld.waynet.waypoints)
@@ -44,7 +49,7 @@ Waynet::WaynetInstance Waynet::makeWaynetFromZen(const ZenLoad::oCWorldData& zen
         // Note: Edges are emplaced later
 
         w.waypoints.push_back(wp);
-        w.waypointsByName[wp.name] = w.waypoints.size() - 1;
+        w.waypointsByName[names.intern(wp.name)] = w.waypoints.size() - 1;
     }
 
     // Copy edges to waypoints
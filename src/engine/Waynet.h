@@ -1,7 +1,8 @@
 #pragma once
-#include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
+#include <engine/NameTable.h>
 #include <math/mathlib.h>
 #include <zenload/zTypes.h>
 
@@ -42,9 +43,14 @@ namespace World
             std::vector<Waypoint> waypoints;
 
             /**
-             * Map of waypoint names to their indices in the waypoints-vector
+             * Map of interned waypoint names to their indices in the waypoints-vector
              */
-            std::map<std::string, WaypointIndex> waypointsByName;
+            std::unordered_map<NameId, WaypointIndex> waypointsByName;
+
+            /**
+             * Table the waypoint names are interned in. Owned by the world.
+             */
+            NameTable* names = nullptr;
         };
 
         /**
@@ -54,8 +60,9 @@ namespace World
 
         /**
          * @brief Creates a waynet from the given loaded zen-world
+         * @param names Table to intern the waypoint names in. Must outlive the waynet.
          */
-        WaynetInstance makeWaynetFromZen(const ZenLoad::oCWorldData& zenWorld);
+        WaynetInstance makeWaynetFromZen(const ZenLoad::oCWorldData& zenWorld, NameTable& names);
 
         /**
          * @brief Finds a way between two waypoints in the given waypoint instance
@@ -85,24 +92,27 @@ namespace World
         size_t findNearestWaypointTo(const WaynetInstance& waynet, const Math::float3& position);
 
         /**
-         * @return True, if the given waypoint exists inside the waynet
+         * @return Index of the waypoint named like the input string (ignoring case), INVALID_WAYPOINT if none
          */
-        inline bool waypointExists(const WaynetInstance& waynet, const std::string& wp)
+        inline WaypointIndex getWaypointIndex(const WaynetInstance& waynet, const std::string& wp)
         {
-            return waynet.waypointsByName.find(wp) != waynet.waypointsByName.end();
-        }
+            if (!waynet.names)
+                return INVALID_WAYPOINT;
 
-        /**
-         * @return Index of the waypoint named like the input string
-         */
-        inline size_t getWaypointIndex(const WaynetInstance& waynet, const std::string& wp)
-        {
-            auto it = waynet.waypointsByName.find(wp);
+            auto it = waynet.waypointsByName.find(waynet.names->find(wp));
 
             if (it == waynet.waypointsByName.end())
                 return INVALID_WAYPOINT;
 
             return (*it).second;
         }
+
+        /**
+         * @return True, if the given waypoint exists inside the waynet
+         */
+        inline bool waypointExists(const WaynetInstance& waynet, const std::string& wp)
+        {
+            return getWaypointIndex(waynet, wp) != INVALID_WAYPOINT;
+        }
     }
 }
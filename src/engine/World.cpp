@@ -1,4 +1,5 @@
 #include <bitset>
+#include <cmath>
 #include <cstdlib>
 #include <iostream>
 #include <iterator>
@@ -9,34 +10,48 @@
 #include <components/VobClasses.h>
 #include <content/AnimationLibrary.h>
 #include <content/ContentLoad.cpp>
+#include <bx/timer.h>
 #include <debugdraw/debugdraw.h>
 #include <engine/BaseEngine.h>
 #include <engine/GameEngine.h>
 #include <engine/World.h>
+#include <engine/WorldPreloader.h>
 #include <entry/input.h>
 #include <handle/HandleDef.h>
 #include <logic/MobController.h>
 #include <logic/PlayerController.h>
 #include <logic/SoundController.h>
 #include <logic/MusicController.h>
+#include <memory/AllocationTracker.h>
 #include <ui/Hud.h>
 #include <ui/LoadingScreen.h>
 #include <ui/PrintScreenMessages.h>
+#include <utils/cli.h>
 #include <utils/logger.h>
+#include <utils/FrameProfiler.h>
 #include <zenload/zCMesh.h>
 #include <zenload/zenParser.h>
 #include <type_traits>
 #include "BspTree.h"
+#include "VobStreamer.h"
 #include "WorldMesh.h"
 #include <physics/PhysicsSystem.h>
 #include <content/Sky.h>
 #include <logic/DialogManager.h>
+#include <logic/NpcAIScheduler.h>
+#include <logic/NpcRoutineScheduler.h>
+#include <logic/PerceptionSystem.h>
 #include <logic/PfxManager.h>
 #include <logic/ScriptEngine.h>
 #include "WorldAllocators.h"
 
 using namespace World;
 
+namespace Flags
+{
+    Cli::Flag worldMeshCellSize("", "worldmesh-cell-size", 1, "Edge-length in meters of the grid-cells the worldmesh is split into for culling. 0 to only split by material", {"32"}, {"Rendering"});
+}
+
 class WorldInstance::ClassContents
 {
 public:
@@ -49,9 +64,14 @@ public:
         , dialogManager(world)
         , bspTree(world)
         , pfxManager(world)
+        , perceptionSystem(world)
+        , routineScheduler(world)
+        , vobStreamer(world)
         , audioWorld(nullptr)
     {}
 
+    // Declared first, as everything else may hold ids or pointers into it
+    NameTable names;
     WorldMesh worldMesh;
     BspTree bspTree;
     Waynet::WaynetInstance waynet;
@@ -62,6 +82,10 @@ public:
     Content::Sky sky;
     Logic::DialogManager dialogManager;
     Logic::PfxManager pfxManager;
+    Logic::NpcAIScheduler aiScheduler;
+    Logic::PerceptionSystem perceptionSystem;
+    Logic::NpcRoutineScheduler routineScheduler;
+    VobStreamer vobStreamer;
 };
 
 struct LoadSection
@@ -78,9 +102,21 @@ const LoadSection LOAD_SECTION_COLLISION = {40, 60, "Generating world collision"
 const LoadSection LOAD_SECTION_VOBS = {60, 80, "Loading objects"};
 const LoadSection LOAD_SECTION_RUNSCRIPTS = {80, 100, "Running startup scripts"};
 
+/**
+ * @return How far away a vob of the given size is still drawn, as factor of the draw-distance
+ */
+static float getDrawDistanceFactor(const Utils::BBox3D& bbox)
+{
+    float factor = std::max(0.12f, std::min(1.0f, (bbox.max - bbox.min).length() / 10.0f));
+#ifdef ANDROID
+    factor *= 0.6f;
+#endif
+    return factor;
+}
+
 WorldInstance::WorldInstance(Engine::BaseEngine& engine)
     : m_pEngine(&engine)
-    , m_Allocators(std::make_unique<WorldAllocators>(engine))
+    , m_Allocators(std::make_unique<WorldAllocators>(engine.getAssetCache()))
     , m_ClassContents(std::make_unique<ClassContents>(*this))
 {
     Logic::MusicController::resetDefaults();
@@ -135,11 +171,35 @@ bool WorldInstance::init(const std::string& zen,
                          const json& worldJson,
                          const json& scriptEngine,
                          const json& dialogManager,
-                         const json& logManager)
+                         const json& logManager,
+                         std::unique_ptr<Engine::PreloadedZen> preloaded)
 {
+    RE_PROFILE_SCOPE("WorldInstance::init");
+    RE_ALLOCATION_SCOPE(Tag_WorldLoad);
+
     m_ZenFile = zen;
     Engine::BaseEngine& engine = *m_pEngine;
 
+    // Notify user and time every loading-stage on its own
+    std::unique_ptr<Utils::FrameProfiler::Scope> loadSectionScope;
+    int64_t loadSectionStart = 0;
+    auto endLoadSection = [&]() {
+        if (!loadSectionScope)
+            return;
+
+        loadSectionScope.reset();
+        m_LoadStageTimes.back().second = (bx::getHPCounter() - loadSectionStart) * 1000.0 / double(bx::getHPFrequency());
+    };
+    auto startLoadSection = [&](const LoadSection& section) {
+        endLoadSection();
+
+        m_LoadStageTimes.emplace_back(section.info, 0.0);
+        loadSectionStart = bx::getHPCounter();
+        loadSectionScope.reset(new Utils::FrameProfiler::Scope(section.info.c_str()));
+
+        m_pEngine->getHud().getLoadingScreen().startSection(section.p1, section.p2, section.info);
+    };
+
     if (!m_ClassContents->animationLibrary.loadAnimations())
         LogError() << "failed to load animations!";
 
@@ -150,10 +210,7 @@ bool WorldInstance::init(const std::string& zen,
     m_StaticWorldMeshPhysicsObject = m_ClassContents->physicsSystem.makeRigidBody(m_StaticWorldMeshCollsionShape, Math::Matrix::CreateIdentity());
 
     // Notify user
-    m_pEngine->getHud().getLoadingScreen().startSection(
-        LOAD_SECTION_LOADSCRIPTS.p1,
-        LOAD_SECTION_LOADSCRIPTS.p2,
-        LOAD_SECTION_LOADSCRIPTS.info);
+    startLoadSection(LOAD_SECTION_LOADSCRIPTS);
 
     bool hasScriptsInVDF = m_pEngine->getVDFSIndex().hasFile("GOTHIC.DAT");
 
@@ -161,10 +218,9 @@ bool WorldInstance::init(const std::string& zen,
     {
       LogInfo() << "Loading GOTHIC.DAT from VDFS-Archive!";
 
-      std::vector<uint8_t> datfile;
-      m_pEngine->getVDFSIndex().getFileData("GOTHIC.DAT", datfile);
+      Content::FileView datfile = m_pEngine->getFileView("GOTHIC.DAT");
 
-      m_ClassContents->scriptEngine.loadDAT(datfile.data(), datfile.size());
+      m_ClassContents->scriptEngine.loadDAT(datfile.getData(), datfile.getSize());
     }
     else
     {
@@ -187,40 +243,47 @@ bool WorldInstance::init(const std::string& zen,
     if (!zen.empty())
     {
         // Notify user
-        m_pEngine->getHud().getLoadingScreen().startSection(
-            LOAD_SECTION_ZENFILE.p1,
-            LOAD_SECTION_ZENFILE.p2,
-            LOAD_SECTION_ZENFILE.info);
+        startLoadSection(LOAD_SECTION_ZENFILE);
 
-        // Load ZEN
-        ZenLoad::ZenParser parser(zen, engine.getVDFSIndex());
+        // Load ZEN, unless it was already read in the background
+        std::unique_ptr<ZenLoad::ZenParser> parser;
+        ZenLoad::oCWorldData world;
 
-        m_pEngine->getHud().getLoadingScreen().setSectionProgress(20);
+        if (preloaded)
+        {
+            LogInfo() << "Using preloaded zen-file";
+            world = std::move(preloaded->world);
+        }
+        else
+        {
+            parser = std::make_unique<ZenLoad::ZenParser>(zen, engine.getVDFSIndex());
 
-        parser.readHeader();
+            m_pEngine->getHud().getLoadingScreen().setSectionProgress(20);
 
-        m_pEngine->getHud().getLoadingScreen().setSectionProgress(60);
+            parser->readHeader();
 
-        ZenLoad::oCWorldData world;
-        parser.readWorld(world);
+            m_pEngine->getHud().getLoadingScreen().setSectionProgress(60);
 
-        ZenLoad::zCMesh* worldMesh = parser.getWorldMesh();
+            parser->readWorld(world);
+        }
 
         m_pEngine->getHud().getLoadingScreen().setSectionProgress(80);
 
+        collectLevelChangeTriggers(world.rootVobs);
+
         LogInfo() << "Initilizing BSP-Tree...";
         m_ClassContents->bspTree.loadBspTree(world.bspTree);
 
         LogInfo() << "Postprocessing worldmesh...";
 
         // Notify user
-        m_pEngine->getHud().getLoadingScreen().startSection(
-            LOAD_SECTION_WORLDMESH.p1,
-            LOAD_SECTION_WORLDMESH.p2,
-            LOAD_SECTION_WORLDMESH.info);
+        startLoadSection(LOAD_SECTION_WORLDMESH);
 
         ZenLoad::PackedMesh packedWorldMesh;
-        worldMesh->packMesh(packedWorldMesh, 0.01f, false);
+        if (preloaded)
+            packedWorldMesh = std::move(preloaded->packedWorldMesh);
+        else
+            parser->getWorldMesh()->packMesh(packedWorldMesh, 0.01f, false);
 
         m_pEngine->getHud().getLoadingScreen().setSectionProgress(20);
 
@@ -260,9 +323,13 @@ bool WorldInstance::init(const std::string& zen,
 
         Meshes::WorldStaticMesh& worldMeshData = getStaticMeshAllocator().getMesh(worldMeshHandle);
 
+        // Split the worldmesh into grid-cells per material, so the parts which are out of sight can be culled
+        const float cellSize = (float)atof(Flags::worldMeshCellSize.getParam(0).c_str());
+        std::vector<Utils::BBox3D> cellBoxes;
+
         for (size_t i = 0; i < packedWorldMesh.subMeshes.size(); i++)
         {
-            Handle::MeshHandle h = getStaticMeshAllocator().loadFromPackedSubmesh(packedWorldMesh, i, "");
+            Handle::MeshHandle h = getStaticMeshAllocator().loadFromPackedSubmeshCells(packedWorldMesh, i, cellSize, cellBoxes, "");
             Meshes::WorldStaticMesh& hdata = getStaticMeshAllocator().getMesh(h);
 
             std::vector<Handle::EntityHandle> subents = Content::entitifyMesh(*this, h, hdata.mesh);
@@ -270,11 +337,10 @@ bool WorldInstance::init(const std::string& zen,
             ents.insert(ents.end(), subents.begin(), subents.end());
         }
 
+        LogInfo() << "Split worldmesh into " << ents.size() << " cells of " << cellSize << "m";
+
         // Notify user
-        m_pEngine->getHud().getLoadingScreen().startSection(
-            LOAD_SECTION_COLLISION.p1,
-            LOAD_SECTION_COLLISION.p2,
-            LOAD_SECTION_COLLISION.info);
+        startLoadSection(LOAD_SECTION_COLLISION);
 
         // If we haven't already, create an instancebuffer for this mesh
         //if(worldMeshData.instanceDataBufferIndex == (uint32_t)-1)
@@ -294,7 +360,7 @@ bool WorldInstance::init(const std::string& zen,
             m_pEngine->getHud().getLoadingScreen().setSectionProgress(50);
 
             // Add world-mesh collision
-            Handle::CollisionShapeHandle wmch = getPhysicsSystem().makeCollisionShapeFromMesh(packedWorldMesh.triangles, Physics::CollisionShape::CT_WorldMesh);
+            Handle::CollisionShapeHandle wmch = getPhysicsSystem().makeCollisionShapeFromMesh(packedWorldMesh.triangles, Physics::CollisionShape::CT_WorldMesh, m_ZenFile);
             getPhysicsSystem().compoundShapeAddChild(m_StaticWorldMeshCollsionShape, wmch);
 
         }
@@ -302,20 +368,28 @@ bool WorldInstance::init(const std::string& zen,
         // Make sure static collision is initialized before adding the VOBs
         m_ClassContents->physicsSystem.postProcessLoad();
 
-        for (Handle::EntityHandle e : ents)
+        for (size_t i = 0; i < ents.size(); i++)
         {
+            Handle::EntityHandle e = ents[i];
+
             // Init positions
-            Components::EntityComponent& entity = getEntity<Components::EntityComponent>(e);
             Components::Actions::initComponent<Components::PositionComponent>(getComponentAllocator(), e);
 
-            // Copy world-matrix (These are all identiy on the worldmesh)
+            // Cells are stored relative to their center
+            const Utils::BBox3D& box = cellBoxes[i];
             Components::PositionComponent& pos = getEntity<Components::PositionComponent>(e);
             pos.m_WorldMatrix = Math::Matrix::CreateIdentity();
-            pos.m_WorldMatrix.Translation(pos.m_WorldMatrix.Translation() * (1.0f / 100.0f));
-            pos.m_DrawDistanceFactor = -1.0f;  // Always draw the worldmesh
+            pos.m_WorldMatrix.Translation(box.min * 0.5f + box.max * 0.5f);
+            pos.m_DrawDistanceFactor = -1.0f;  // Culled by m_IsWorldMeshCell instead
+
+            Components::BBoxComponent& bbox = Components::Actions::initComponent<Components::BBoxComponent>(getComponentAllocator(), e);
+            bbox.m_BBox3D.min = box.min - pos.m_WorldMatrix.Translation();
+            bbox.m_BBox3D.max = box.max - pos.m_WorldMatrix.Translation();
+            bbox.m_SphereRadius = (box.max - box.min).length() * 0.5f;
 
             Components::StaticMeshComponent& sm = getEntity<Components::StaticMeshComponent>(e);
             sm.m_InstanceDataIndex = (uint32_t)-2;  // Disable instancing
+            sm.m_IsWorldMeshCell = true;
         }
 
         // TODO: Refractor. Make a map of all vobs by classes or something.
@@ -388,6 +462,21 @@ bool WorldInstance::init(const std::string& zen,
 
                     LogInfo() << "Found default music zone: " << v.vobName;
                 }
+                else if (VobStreamer::isEnabled() && VobStreamer::canStream(v.objectClass, v.vobName, v.visual))
+                {
+                    // Only remembered for now, the entity is created once the camera comes close
+                    VobStreamer::Descriptor d;
+                    d.transform = Math::Matrix(v.worldMatrix.mv);
+                    d.transform.Translation(d.transform.Translation() * (1.0f / 100.0f));
+                    d.bbox = {Math::float3(v.bbox[0].v) * (1.0f / 100.0f), Math::float3(v.bbox[1].v) * (1.0f / 100.0f)};
+                    d.hasBBox = true;
+                    d.visual = m_ClassContents->names.intern(v.visual);
+                    d.drawDistanceFactor = getDrawDistanceFactor(d.bbox);
+                    d.collision = v.cdDyn;
+
+                    m_ClassContents->vobStreamer.addVob(d);
+                    continue;
+                }
                 else
                 {
                     // Normal zCVob or not implemented subclass
@@ -404,7 +493,7 @@ bool WorldInstance::init(const std::string& zen,
                     Vob::setName(vob, v.vobName);
 
                     // Add to name-map
-                    m_VobsByNames[v.vobName] = e;
+                    m_VobsByNames[m_ClassContents->names.intern(v.vobName)] = e;
                 }
 
                 // Set position
@@ -439,10 +528,7 @@ bool WorldInstance::init(const std::string& zen,
                                           Math::float3(v.bbox[1].v) * (1.0f / 100.0f)};
 
                     //LogInfo() << "Vobsize (" << v.visual << "): " << (bbox.max - bbox.min).length() / 10.0f;
-                    vob.position->m_DrawDistanceFactor = std::max(0.12f, std::min(1.0f, (bbox.max - bbox.min).length() / 10.0f));
-#ifdef ANDROID
-                    vob.position->m_DrawDistanceFactor *= 0.6f;
-#endif
+                    vob.position->m_DrawDistanceFactor = getDrawDistanceFactor(bbox);
                     //LogInfo() << "DistanceFactor (" << v.visual << "): " << vob.position->m_DrawDistanceFactor;
 
                     Vob::setVisual(vob, v.visual);
@@ -454,33 +540,14 @@ bool WorldInstance::init(const std::string& zen,
                                  Math::float3(v.bbox[1].v) * (1.0f / 100.0f) - m.Translation(),
                                  0 /*vob.visual ? 0 : 0xFF00AA00*/);
 
-                    // Trace down from this vob to get the shadow-value from the worldmesh
-                    Math::float3 traceStart = Math::float3(m.Translation().x, v.bbox[1].y * (1.0f / 100.0f), m.Translation().z);
-                    Math::float3 traceEnd = Math::float3(m.Translation().x, (v.bbox[0].y * (1.0f / 100.0f)) - 5.0f, m.Translation().z);
-                    Physics::RayTestResult hit = m_ClassContents->physicsSystem.raytrace(traceStart, traceEnd,
-                                                                          Physics::CollisionShape::CT_WorldMesh);  // FIXME: Use boundingbox for this
-
-                    if (hit.hasHit)
-                    {
-                        float shadow = m_ClassContents->worldMesh.interpolateTriangleShadowValue(hit.hitTriangleIndex, hit.hitPosition);
-
-                        if (Vob::getVisual(vob))
-                            Vob::getVisual(vob)->setShadowValue(shadow);
-                    }
-                    else
-                    {
-                        if (Vob::getVisual(vob))
-                            Vob::getVisual(vob)->setShadowValue(0.6);
-                    }
+                    if (Vob::getVisual(vob))
+                        Vob::getVisual(vob)->setShadowValue(getShadowValueBelow(m.Translation(), bbox));
                 }
             }
         };
 
         // Notify user
-        m_pEngine->getHud().getLoadingScreen().startSection(
-            LOAD_SECTION_VOBS.p1,
-            LOAD_SECTION_VOBS.p2,
-            LOAD_SECTION_VOBS.info);
+        startLoadSection(LOAD_SECTION_VOBS);
 
         bool worldUnknownToPlayer = worldJson.empty();
         if (worldUnknownToPlayer)
@@ -502,7 +569,7 @@ bool WorldInstance::init(const std::string& zen,
         m_ClassContents->physicsSystem.postProcessLoad();
 
         // Load waynet
-        m_ClassContents->waynet = Waynet::makeWaynetFromZen(world);
+        m_ClassContents->waynet = Waynet::makeWaynetFromZen(world, m_ClassContents->names);
 
         // Insert startpoint as a waypoint with the name zCVobStartpoint:zCVob.
         if (!startPoint.objectClass.empty())
@@ -518,10 +585,7 @@ bool WorldInstance::init(const std::string& zen,
         }
 
         // Notify user
-        m_pEngine->getHud().getLoadingScreen().startSection(
-            LOAD_SECTION_RUNSCRIPTS.p1,
-            LOAD_SECTION_RUNSCRIPTS.p2,
-            LOAD_SECTION_RUNSCRIPTS.info);
+        startLoadSection(LOAD_SECTION_RUNSCRIPTS);
 
         LogInfo() << "Creating AudioWorld";
         // must create AudioWorld before initializeScriptEngineForZenWorld, because startup_<worldname> calls snd_play
@@ -584,6 +648,8 @@ bool WorldInstance::init(const std::string& zen,
         LogInfo() << "ZEN-Files found in the currently loaded Archives: " << zenFiles;
     }
 
+    endLoadSection();
+
     // Initialize the sky, so it will get the right values
     m_ClassContents->sky.onWorldNameChanged(getWorldName());
 
@@ -659,6 +725,8 @@ Handle::EntityHandle WorldInstance::addEntity(Components::ComponentMask componen
 
 void WorldInstance::onFrameUpdate(double deltaTime, float updateRangeSquared, const Math::Matrix& cameraWorld)
 {
+    RE_PROFILE_SCOPE("WorldInstance::onFrameUpdate");
+
     // Tell script engine the frame started
     m_ClassContents->scriptEngine.onFrameStart();
 
@@ -666,7 +734,21 @@ void WorldInstance::onFrameUpdate(double deltaTime, float updateRangeSquared, co
     m_ClassContents->physicsSystem.update(deltaTime);
 
     // Update sky
-    m_ClassContents->sky.interpolate();
+    {
+        RE_PROFILE_SCOPE("Sky::interpolate");
+        m_ClassContents->sky.interpolate();
+    }
+
+    RE_PROFILE_SCOPE("Entity updates");
+
+    m_NumEntitiesUpdated = 0;
+    m_ClassContents->aiScheduler.beginFrame(cameraWorld, std::sqrt(updateRangeSquared));
+
+    // Let NPCs whose daily routine has changed know about it
+    m_ClassContents->routineScheduler.update();
+
+    // Create and remove the streamed vobs around the camera, before going through the entities
+    m_ClassContents->vobStreamer.update(cameraWorld.Translation(), std::sqrt(updateRangeSquared));
 
     size_t num = getComponentAllocator().getNumObtainedElements();
     const auto& ctuple = getComponentDataBundle().m_Data;
@@ -689,6 +771,8 @@ void WorldInstance::onFrameUpdate(double deltaTime, float updateRangeSquared, co
                 continue;
         }
 
+        m_NumEntitiesUpdated++;
+
         Components::ComponentMask mask = ents[i].m_ComponentMask;
         if (Components::hasComponent<Components::LogicComponent>(ents[i]))
         {
@@ -723,6 +807,12 @@ void WorldInstance::onFrameUpdate(double deltaTime, float updateRangeSquared, co
             player.playerController->onUpdateByInput(deltaTime);
     }
 
+    // Let NPCs perceive what happened this frame
+    {
+        RE_PROFILE_SCOPE("PerceptionSystem::update");
+        m_ClassContents->perceptionSystem.update(deltaTime);
+    }
+
     // Update sound-listener position
     getAudioWorld().setListenerPosition(getCameraController()->getEntityTransform().Translation());
     //getAudioWorld().setListenerVelocity(); // don't need this for now, no need for the Doppler effect
@@ -732,9 +822,6 @@ void WorldInstance::onFrameUpdate(double deltaTime, float updateRangeSquared, co
     // Update dialogs
     m_ClassContents->dialogManager.update(deltaTime);
 
-    // Tell script engine the frame ended
-    m_ClassContents->scriptEngine.onFrameEnd();
-
     // Update hud
     m_pEngine->getHud().setDateTimeDisplay(m_pEngine->getGameClock().getDateTimeFormatted());
 
@@ -773,6 +860,44 @@ void WorldInstance::removeEntity(Handle::EntityHandle h)
     getComponentAllocator().removeObject(h);
 }
 
+float WorldInstance::getShadowValueBelow(const Math::float3& position, const Utils::BBox3D& bbox)
+{
+    // Trace down from the vob to get the shadow-value from the worldmesh
+    Math::float3 traceStart = Math::float3(position.x, bbox.max.y, position.z);
+    Math::float3 traceEnd = Math::float3(position.x, bbox.min.y - 5.0f, position.z);
+    Physics::RayTestResult hit = m_ClassContents->physicsSystem.raytrace(traceStart, traceEnd,
+                                                                         Physics::CollisionShape::CT_WorldMesh);  // FIXME: Use boundingbox for this
+
+    if (!hit.hasHit)
+        return 0.6f;
+
+    return m_ClassContents->worldMesh.interpolateTriangleShadowValue(hit.hitTriangleIndex, hit.hitPosition);
+}
+
+void WorldInstance::collectLevelChangeTriggers(const std::vector<ZenLoad::zCVobData>& vobs)
+{
+    for (const ZenLoad::zCVobData& v : vobs)
+    {
+        collectLevelChangeTriggers(v.childVobs);
+
+        if (v.objectClass.find("oCTriggerChangeLevel") == std::string::npos)
+            continue;
+
+        // Stored like "NEWWORLD\NEWWORLD.ZEN" or without extension, but the archives know them by their filename
+        std::string level = Utils::uppered(v.oCTriggerChangeLevel.levelName);
+        level = level.substr(level.find_last_of("\\/") + 1);
+        if (Utils::splitExtension(level).second.empty())
+            level += ".ZEN";
+
+        LevelChangeTrigger trigger;
+        trigger.bbox = {Math::float3(v.bbox[0].v) * (1.0f / 100.0f), Math::float3(v.bbox[1].v) * (1.0f / 100.0f)};
+        trigger.zenFile = level;
+        trigger.startVob = v.oCTriggerChangeLevel.startVobName;
+
+        m_LevelChangeTriggers.push_back(trigger);
+    }
+}
+
 std::vector<size_t> WorldInstance::findStartPoints()
 {
     std::vector<size_t> pts;
@@ -781,14 +906,14 @@ std::vector<size_t> WorldInstance::findStartPoints()
 
     /*
     // Gothic 1
-    auto it = m_ClassContents->waynet.waypointsByName.find("WP_INTRO_SHORE");
-    if(it != m_ClassContents->waynet.waypointsByName.end())
-        pts.push_back((*it).second);
+    Waynet::WaypointIndex wp = Waynet::getWaypointIndex(m_ClassContents->waynet, "WP_INTRO_SHORE");
+    if(wp != Waynet::INVALID_WAYPOINT)
+        pts.push_back(wp);
      */
 
-    auto it = m_ClassContents->waynet.waypointsByName.find("zCVobStartpoint:zCVob");
-    if (it != m_ClassContents->waynet.waypointsByName.end())
-        pts.push_back((*it).second);
+    Waynet::WaypointIndex wp = Waynet::getWaypointIndex(m_ClassContents->waynet, "zCVobStartpoint:zCVob");
+    if (wp != Waynet::INVALID_WAYPOINT)
+        pts.push_back(wp);
 
     if (!pts.empty())
         return pts;
@@ -810,20 +935,19 @@ std::vector<size_t> WorldInstance::findStartPoints()
     return pts;
 }
 
-std::vector<Handle::EntityHandle>
+Memory::FrameVector<Handle::EntityHandle>
 WorldInstance::getFreepointsInRange(const Math::float3& center, float distance, const std::string& name, bool closestOnly,
                                     Handle::EntityHandle inst)
 {
-    std::vector<Handle::EntityHandle> m;
+    Memory::FrameVector<Handle::EntityHandle> m;
 
     Handle::EntityHandle closestFP;
 
     float closest2 = FLT_MAX;
     float distance2 = distance * distance;
-    std::vector<Handle::EntityHandle> fps = getFreepoints(name);
+    const std::vector<Handle::EntityHandle>& fps = getFreepoints(name);
     for (auto& fp : fps)
     {
-        Components::SpotComponent& sp = getEntity<Components::SpotComponent>(fp);
         Components::PositionComponent& pos = getEntity<Components::PositionComponent>(fp);
 
         if (!isFreepointOccupied(fp))
@@ -844,29 +968,26 @@ WorldInstance::getFreepointsInRange(const Math::float3& center, float distance,
 
     }
 
-    if (closestOnly)
-        return closestFP.isValid() ? std::vector<Handle::EntityHandle>({closestFP}) : std::vector<Handle::EntityHandle>();
-    else
-        return m;
+    if (closestOnly && closestFP.isValid())
+        m.push_back(closestFP);
+
+    return m;
 }
 
-std::vector<Handle::EntityHandle> WorldInstance::getFreepoints(const std::string& tag)
+const std::vector<Handle::EntityHandle>& WorldInstance::getFreepoints(const std::string& tag)
 {
-    std::vector<Handle::EntityHandle> mp;
-
     auto cacheIt = m_FreePointTagCache.find(tag);
     if(cacheIt != m_FreePointTagCache.end())
         return cacheIt->second;
 
     // Tag not cached, do full search now and cache it
+    std::vector<Handle::EntityHandle>& mp = m_FreePointTagCache[tag];
     for(auto& fp : m_FreePoints)
     {
         if(fp.first.find(tag) != std::string::npos)
             mp.push_back(fp.second);
     }
 
-    m_FreePointTagCache[tag] = mp;
-
     return mp;
 }
 
@@ -954,6 +1075,9 @@ void WorldInstance::exportWorld(json& j, std::set<Handle::EntityHandle> skip)
             // Do the actual export
             exportControllers(logicController, visualController, jvobs["controllers"][i]);
         }
+
+        // Vobs which are streamed in don't all have an entity right now
+        m_ClassContents->vobStreamer.exportVobs(jvobs["controllers"]);
     }
 }
 
@@ -1025,11 +1149,13 @@ void WorldInstance::importVobs(const json& j)
     // j must be an array of vobs
     size_t numImported = 0;
     size_t numTotal = j["controllers"].size();
+    bool streamVobs = VobStreamer::isEnabled();
     for (const json& vob : j["controllers"])
     {
         if (!vob.is_null())
         {
-            importSingleVob(vob);
+            if (!streamVobs || !m_ClassContents->vobStreamer.addVob(vob))
+                importSingleVob(vob);
         }
 
         numImported++;
@@ -1091,7 +1217,7 @@ void WorldInstance::takeControlOver(Handle::EntityHandle entityHandle)
 {
     VobTypes::NpcVobInformation newPlayer = VobTypes::asNpcVob(*this, entityHandle);
     getScriptEngine().setPlayerEntity(entityHandle);
-    getScriptEngine().setInstanceNPC("hero", VobTypes::getScriptHandle(newPlayer));
+    getScriptEngine().setInstanceNPC(getScriptEngine().getCommonSymbols().hero, VobTypes::getScriptHandle(newPlayer));
 }
 
 Handle::EntityHandle WorldInstance::importVobAndTakeControl(const json& j)
@@ -1124,6 +1250,20 @@ const Waynet::WaynetInstance& WorldInstance::getWaynet()
     return m_ClassContents->waynet;
 }
 
+NameTable& WorldInstance::getNameTable()
+{
+    return m_ClassContents->names;
+}
+
+Handle::EntityHandle WorldInstance::getVobEntityByName(const std::string& name)
+{
+    auto it = m_VobsByNames.find(m_ClassContents->names.find(name));
+    if (it == m_VobsByNames.end())
+        return Handle::EntityHandle::makeInvalidHandle();
+
+    return (*it).second;
+}
+
 std::string WorldInstance::getWorldName()
 {
     return Utils::stripExtension(m_ZenFile);
@@ -1164,6 +1304,26 @@ Logic::PfxManager& WorldInstance::getPfxManager()
     return m_ClassContents->pfxManager;
 }
 
+Logic::NpcAIScheduler& WorldInstance::getAIScheduler()
+{
+    return m_ClassContents->aiScheduler;
+}
+
+Logic::PerceptionSystem& WorldInstance::getPerceptionSystem()
+{
+    return m_ClassContents->perceptionSystem;
+}
+
+Logic::NpcRoutineScheduler& WorldInstance::getRoutineScheduler()
+{
+    return m_ClassContents->routineScheduler;
+}
+
+VobStreamer& WorldInstance::getVobStreamer()
+{
+    return m_ClassContents->vobStreamer;
+}
+
 Animations::AnimationLibrary& WorldInstance::getAnimationLibrary()
 {
     return m_ClassContents->animationLibrary;
@@ -1174,7 +1334,7 @@ Components::ComponentAllocator::DataBundle WorldInstance::getComponentDataBundle
     return m_Allocators->m_ComponentAllocator.getDataBundle();
 }
 
-Textures::TextureAllocator& WorldInstance::getTextureAllocator()
+Content::SharedTextureAllocator& WorldInstance::getTextureAllocator()
 {
     return m_Allocators->m_LevelTextureAllocator;
 }
@@ -1184,24 +1344,24 @@ Components::ComponentAllocator& WorldInstance::getComponentAllocator()
     return m_Allocators->m_ComponentAllocator;
 }
 
-Meshes::StaticMeshAllocator& WorldInstance::getStaticMeshAllocator()
+Content::SharedStaticMeshAllocator& WorldInstance::getStaticMeshAllocator()
 {
     return m_Allocators->m_LevelStaticMeshAllocator;
 }
 
-Meshes::SkeletalMeshAllocator& WorldInstance::getSkeletalMeshAllocator()
+Content::SharedSkeletalMeshAllocator& WorldInstance::getSkeletalMeshAllocator()
 {
     return m_Allocators->m_LevelSkeletalMeshAllocator;
 }
 
 Animations::AnimationAllocator& WorldInstance::getAnimationAllocator()
 {
-    return m_Allocators->m_AnimationAllocator;
+    return m_Allocators->m_AssetCache.getAnimationAllocator();
 }
 
 Animations::AnimationDataAllocator& WorldInstance::getAnimationDataAllocator()
 {
-    return m_Allocators->m_AnimationDataAllocator;
+    return m_Allocators->m_AssetCache.getAnimationDataAllocator();
 }
 
 World::WorldAllocators& WorldInstance::getAllocators()
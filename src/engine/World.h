@@ -5,18 +5,22 @@
 #include <ZenLib/daedalus/DaedalusStdlib.h>
 #include <handle/HandleDef.h>
 #include <math/mathlib.h>
+#include <memory/FrameArena.h>
 #include <components/Entities.h>
+#include <engine/NameTable.h>
 
 using json = nlohmann::json;
 
 namespace ZenLoad
 {
     class ZenParser;
+    struct zCVobData;
 }
 
 namespace Engine
 {
     class BaseEngine;
+    struct PreloadedZen;
 }
 
 namespace Physics
@@ -33,6 +37,9 @@ namespace Logic
 {
     class DialogManager;
     class PfxManager;
+    class NpcAIScheduler;
+    class PerceptionSystem;
+    class NpcRoutineScheduler;
     class CameraController;
     class ScriptEngine;
 }
@@ -47,10 +54,11 @@ namespace UI
     class PrintScreenMessages;
 }
 
-namespace Meshes
+namespace Content
 {
-    class StaticMeshAllocator;
-    class SkeletalMeshAllocator;
+    class SharedTextureAllocator;
+    class SharedStaticMeshAllocator;
+    class SharedSkeletalMeshAllocator;
 }
 
 namespace Animations
@@ -64,6 +72,7 @@ namespace Animations
 namespace World
 {
     class AudioWorld;
+    class VobStreamer;
     class WorldMesh;
     struct WorldAllocators;
 
@@ -82,6 +91,27 @@ namespace World
         std::vector<size_t> m_VisibleEntities;
     };
 
+    /**
+     * Trigger-vob taking the player to another world once entered
+     */
+    struct LevelChangeTrigger
+    {
+        /**
+         * Area of the trigger, in world-space
+         */
+        Utils::BBox3D bbox;
+
+        /**
+         * World to switch to, upper case including the .ZEN extension
+         */
+        std::string zenFile;
+
+        /**
+         * Vob to put the player at inside the new world
+         */
+        std::string startVob;
+    };
+
     class WorldInstance : public Handle::HandleTypeDescriptor<Handle::WorldHandle>
     {
     public:
@@ -94,12 +124,14 @@ namespace World
          * @param scriptEngine may be empty
          * @param dialogManager may be empty
          * @param logManager may be empty
+         * @param preloaded Contents of the zen-file, if they were already read by the Engine::WorldPreloader
          */
         bool init(const std::string& zen,
                   const json& worldJson = json(),
                   const json& scriptEngine = json(),
                   const json& dialogManager = json(),
-                  const json& logManager = json());
+                  const json& logManager = json(),
+                  std::unique_ptr<Engine::PreloadedZen> preloaded = nullptr);
 
         /**
          * Creates an entity with the given components and returns its handle
@@ -157,16 +189,9 @@ namespace World
         }
 
         /**
-         * @return The vob-entity of a vob using the given name
+         * @return The vob-entity of a vob using the given name (ignoring case)
          */
-        Handle::EntityHandle getVobEntityByName(const std::string& name)
-        {
-            auto it = m_VobsByNames.find(name);
-            if (it == m_VobsByNames.end())
-                return Handle::EntityHandle::makeInvalidHandle();
-
-            return (*it).second;
-        }
+        Handle::EntityHandle getVobEntityByName(const std::string& name);
 
         /**
          * Goes through the list of all vobs and returns a list of the startwaypoint-indices
@@ -174,6 +199,19 @@ namespace World
          */
         std::vector<size_t> findStartPoints();
 
+        /**
+         * Traces straight down through the worldmesh, to find out how much a vob is in shadow
+         * @param position Where the vob is
+         * @param bbox World-space bounds of the vob
+         * @return Shadow-value of the worldmesh below the vob, 0.6 if there is none
+         */
+        float getShadowValueBelow(const Math::float3& position, const Utils::BBox3D& bbox);
+
+        /**
+         * @return Level-change triggers found in the zen-file
+         */
+        const std::vector<LevelChangeTrigger>& getLevelChangeTriggers() { return m_LevelChangeTriggers; }
+
         /**
          * @return Basic gametype this is. Needed for sky configuration, for example
          */
@@ -185,10 +223,10 @@ namespace World
          */
         WorldAllocators& getAllocators();
         Components::ComponentAllocator::DataBundle getComponentDataBundle();
-        Textures::TextureAllocator& getTextureAllocator();
+        Content::SharedTextureAllocator& getTextureAllocator();
         Components::ComponentAllocator& getComponentAllocator();
-        Meshes::StaticMeshAllocator& getStaticMeshAllocator();
-        Meshes::SkeletalMeshAllocator& getSkeletalMeshAllocator();
+        Content::SharedStaticMeshAllocator& getStaticMeshAllocator();
+        Content::SharedSkeletalMeshAllocator& getSkeletalMeshAllocator();
         Animations::AnimationAllocator& getAnimationAllocator();
         Animations::AnimationDataAllocator& getAnimationDataAllocator();
 
@@ -207,6 +245,7 @@ namespace World
         }
 
         const Waynet::WaynetInstance& getWaynet();
+        NameTable& getNameTable();
         Logic::ScriptEngine& getScriptEngine();
 
 
@@ -219,6 +258,10 @@ namespace World
         Logic::DialogManager& getDialogManager();
         World::AudioWorld& getAudioWorld();
         Logic::PfxManager& getPfxManager();
+        Logic::NpcAIScheduler& getAIScheduler();
+        Logic::PerceptionSystem& getPerceptionSystem();
+        Logic::NpcRoutineScheduler& getRoutineScheduler();
+        VobStreamer& getVobStreamer();
         Animations::AnimationLibrary& getAnimationLibrary();
 
         /**
@@ -227,9 +270,9 @@ namespace World
         UI::PrintScreenMessages& getPrintScreenManager();
 
         /**
-         * @return freepoints with this tag
+         * @return freepoints with this tag. Stays valid, as the result is cached.
          */
-        std::vector<Handle::EntityHandle> getFreepoints(const std::string& tag);
+        const std::vector<Handle::EntityHandle>& getFreepoints(const std::string& tag);
 
         /**
          * @return Map of all freepoints
@@ -260,13 +303,13 @@ namespace World
          * @param name Name-filter
          * @param closestOnly Put only the closest one into the result
          * @param inst Entity that want's a new freepoint, aka, should not be on any of the returned ones
-         * @return Vector of closest freepoints
+         * @return Vector of closest freepoints, only valid until the end of the next frame
          */
-        std::vector<Handle::EntityHandle> getFreepointsInRange(const Math::float3& center,
-                                                               float distance,
-                                                               const std::string& name = "",
-                                                               bool closestOnly = false,
-                                                               Handle::EntityHandle inst = Handle::EntityHandle::makeInvalidHandle());
+        Memory::FrameVector<Handle::EntityHandle> getFreepointsInRange(const Math::float3& center,
+                                                                       float distance,
+                                                                       const std::string& name = "",
+                                                                       bool closestOnly = false,
+                                                                       Handle::EntityHandle inst = Handle::EntityHandle::makeInvalidHandle());
 
         /**
          * Marks the given Freepoint as "occupied" for the next occupiedForSeconds
@@ -313,6 +356,16 @@ namespace World
          */
         std::string getWorldName();
 
+        /**
+         * @return Name and duration in milliseconds of every loading-stage done by init(), in order
+         */
+        const std::vector<std::pair<std::string, double>>& getLoadStageTimes() { return m_LoadStageTimes; }
+
+        /**
+         * @return Number of entities which were inside the update-range during the last onFrameUpdate()
+         */
+        size_t getNumEntitiesUpdated() { return m_NumEntitiesUpdated; }
+
         /**
          * Imports vobs from a json-object
          * @param j
@@ -350,6 +403,11 @@ namespace World
          */
         void initializeScriptEngineForZenWorld(const std::string& worldName, bool firstStart = true);
 
+        /**
+         * Remembers the level-change triggers among the given vobs and their children
+         */
+        void collectLevelChangeTriggers(const std::vector<ZenLoad::zCVobData>& vobs);
+
 
         TransientEntityFeatures m_TransientEntityFeatures;
 
@@ -358,6 +416,15 @@ namespace World
          */
         std::string m_ZenFile;
 
+        /**
+         * Durations of the loading-stages of this world, see getLoadStageTimes()
+         */
+        std::vector<std::pair<std::string, double>> m_LoadStageTimes;
+
+        /**
+         * Entities processed during the last frame
+         */
+        size_t m_NumEntitiesUpdated = 0;
 
 
         /**
@@ -379,15 +446,20 @@ namespace World
         Handle::WorldHandle m_MyHandle;
 
         /**
-         * Map of vobs by their names (If they have one)
+         * Map of vobs by their interned names (If they have one)
          */
-        std::unordered_map<std::string, Handle::EntityHandle> m_VobsByNames;
+        std::unordered_map<NameId, Handle::EntityHandle> m_VobsByNames;
 
         /**
          * List of freepoints
          */
         std::map<std::string, Handle::EntityHandle> m_FreePoints;
 
+        /**
+         * Level-change triggers, see getLevelChangeTriggers()
+         */
+        std::vector<LevelChangeTrigger> m_LevelChangeTriggers;
+
         /**
          * Usually freepoints are named like "FP_GUARD_XXX", where "FP_GUARD" is the 'tag' of
          * a freepoint. To save us from going through the whole freepoint list every time we need a
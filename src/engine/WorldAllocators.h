@@ -1,8 +1,5 @@
 #pragma once
-#include <content/AnimationAllocator.h>
-#include <content/SkeletalMeshAllocator.h>
-#include <content/StaticMeshAllocator.h>
-#include <content/Texture.h>
+#include <content/AssetCache.h>
 #include <content/VertexTypes.h>
 #include <memory/StaticReferencedAllocator.h>
 #include <memory/AllocatorBundle.h>
@@ -12,10 +9,11 @@ namespace World
 {
     struct WorldAllocators
     {
-        WorldAllocators(Engine::BaseEngine& engine)
-                : m_LevelTextureAllocator(engine)
-                , m_LevelSkeletalMeshAllocator(engine)
-                , m_LevelStaticMeshAllocator(engine)
+        WorldAllocators(Content::AssetCache& assetCache)
+                : m_LevelTextureAllocator(assetCache)
+                , m_LevelStaticMeshAllocator(assetCache)
+                , m_LevelSkeletalMeshAllocator(assetCache)
+                , m_AssetCache(assetCache)
         {
         }
         template <typename V, typename I>
@@ -24,10 +22,13 @@ namespace World
                 Config::MAX_NUM_LEVEL_MESHES>;
 
         Components::ComponentAllocator m_ComponentAllocator;
-        Textures::TextureAllocator m_LevelTextureAllocator;
-        Meshes::StaticMeshAllocator m_LevelStaticMeshAllocator;
-        Meshes::SkeletalMeshAllocator m_LevelSkeletalMeshAllocator;
-        Animations::AnimationAllocator m_AnimationAllocator;
-        Animations::AnimationDataAllocator m_AnimationDataAllocator;
+
+        /**
+         * Assets are stored engine-wide, these only keep track of what this world is using
+         */
+        Content::SharedTextureAllocator m_LevelTextureAllocator;
+        Content::SharedStaticMeshAllocator m_LevelStaticMeshAllocator;
+        Content::SharedSkeletalMeshAllocator m_LevelSkeletalMeshAllocator;
+        Content::AssetCache& m_AssetCache;
     };
 }
\ No newline at end of file
@@ -0,0 +1,379 @@
+#include "WorldPreloader.h"
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <set>
+#include <thread>
+#include "BaseEngine.h"
+#include "GameSession.h"
+#include "World.h"
+#include <bx/timer.h>
+#include <content/AssetCache.h>
+#include <logic/ScriptEngine.h>
+#include <utils/cli.h>
+#include <utils/FrameProfiler.h>
+#include <utils/logger.h>
+#include <vdfs/fileIndex.h>
+#include <zenload/zCMesh.h>
+#include <zenload/zenParser.h>
+
+using namespace Engine;
+
+namespace Flags
+{
+    Cli::Flag preloadLevels("", "preload-levels", 1, "Starts loading the destination of a level-change in the background once the player gets closer to its trigger than the given distance in meters. 0 disables", {"0"}, "Game");
+    Cli::Flag preloadBudget("", "preload-budget", 1, "Megabytes the parsed destination-world may take up while it is being preloaded", {"256"}, "Game");
+}
+
+namespace
+{
+    /**
+     * A preload is only cancelled once the player is this much further away than where it was started, so walking
+     * along the edge doesn't start it over and over again
+     */
+    const float CANCEL_DISTANCE_FACTOR = 1.5f;
+
+    float getPreloadDistance()
+    {
+        return static_cast<float>(atof(Flags::preloadLevels.getParam(0).c_str()));
+    }
+
+    float distanceToBox(const Math::float3& p, const Utils::BBox3D& box)
+    {
+        Math::float3 closest(std::max(box.min.x, std::min(p.x, box.max.x)),
+                             std::max(box.min.y, std::min(p.y, box.max.y)),
+                             std::max(box.min.z, std::min(p.z, box.max.z)));
+
+        return (p - closest).length();
+    }
+
+    size_t estimateMemory(const std::vector<ZenLoad::zCVobData>& vobs)
+    {
+        size_t bytes = vobs.size() * sizeof(ZenLoad::zCVobData);
+        for (const ZenLoad::zCVobData& v : vobs)
+            bytes += v.vobName.capacity() + v.visual.capacity() + estimateMemory(v.childVobs);
+
+        return bytes;
+    }
+
+    /**
+     * @return Estimated bytes taken up by everything kept of a parsed zen: the packed worldmesh, the vob-tree,
+     *         the bsp-tree and the waynet
+     */
+    size_t estimateMemory(const Engine::PreloadedZen& zen)
+    {
+        const ZenLoad::PackedMesh& packed = zen.packedWorldMesh;
+        size_t bytes = packed.vertices.size() * sizeof(packed.vertices[0])
+                       + packed.triangles.size() * sizeof(packed.triangles[0]);
+
+        for (const auto& sm : packed.subMeshes)
+            bytes += sm.indices.size() * sizeof(sm.indices[0])
+                     + sm.triangleLightmapIndices.size() * sizeof(sm.triangleLightmapIndices[0]);
+
+        const ZenLoad::oCWorldData& world = zen.world;
+        bytes += estimateMemory(world.rootVobs)
+                 + world.bspTree.nodes.size() * sizeof(world.bspTree.nodes[0])
+                 + world.waynet.waypoints.size() * sizeof(world.waynet.waypoints[0])
+                 + world.waynet.edges.size() * sizeof(world.waynet.edges[0]);
+
+        return bytes;
+    }
+
+    /**
+     * Collects the compiled meshes used as visuals by the given vobs and their children
+     */
+    void collectVobMeshes(const std::vector<ZenLoad::zCVobData>& vobs, std::set<std::string>& meshes)
+    {
+        for (const ZenLoad::zCVobData& v : vobs)
+        {
+            collectVobMeshes(v.childVobs, meshes);
+
+            std::pair<std::string, std::string> split = Utils::splitExtension(Utils::uppered(v.visual));
+            if (split.second == ".3DS")
+                meshes.insert(split.first + ".MRM");
+        }
+    }
+}
+
+WorldPreloader::WorldPreloader(BaseEngine& engine)
+    : m_Engine(engine)
+    , m_Stop(Stop_None)
+    , m_NumAssetsBaked(0)
+    , m_NumAssetsTotal(0)
+{
+}
+
+WorldPreloader::~WorldPreloader()
+{
+    cancel();
+
+    if (m_Worker.valid())
+        m_Worker.wait();
+}
+
+bool WorldPreloader::isEnabled()
+{
+    return getPreloadDistance() > 0.0f;
+}
+
+void WorldPreloader::onFrameUpdate()
+{
+    if (!isEnabled())
+        return;
+
+    Handle::WorldHandle worldHandle = m_Engine.getMainWorld();
+    if (!worldHandle.isValid())
+        return;
+
+    World::WorldInstance& world = worldHandle.get();
+    Handle::EntityHandle player = world.getScriptEngine().getPlayerEntity();
+    if (!player.isValid())
+        return;
+
+    Math::float3 position = world.getEntity<Components::PositionComponent>(player).m_WorldMatrix.Translation();
+
+    const World::LevelChangeTrigger* closest = nullptr;
+    float closestDistance = FLT_MAX;
+    for (const World::LevelChangeTrigger& trigger : world.getLevelChangeTriggers())
+    {
+        float distance = distanceToBox(position, trigger.bbox);
+        if (distance < closestDistance)
+        {
+            closest = &trigger;
+            closestDistance = distance;
+        }
+    }
+
+    if (closest && closestDistance == 0.0f)
+    {
+        if (m_Armed)
+        {
+            m_Armed = false;
+
+            LogInfo() << "Player entered level-change to " << closest->zenFile << " (" << closest->startVob << ")";
+            m_Engine.getSession().switchToWorld(closest->zenFile, closest->startVob);
+        }
+        return;
+    }
+
+    m_Armed = true;
+
+    std::string current;
+    {
+        std::lock_guard<std::mutex> guard(m_Mutex);
+        current = m_ZenFile;
+    }
+
+    float preloadDistance = getPreloadDistance();
+    if (!current.empty())
+    {
+        bool stillInRange = false;
+        for (const World::LevelChangeTrigger& trigger : world.getLevelChangeTriggers())
+        {
+            if (trigger.zenFile == current
+                && distanceToBox(position, trigger.bbox) < preloadDistance * CANCEL_DISTANCE_FACTOR)
+            {
+                stillInRange = true;
+                break;
+            }
+        }
+
+        if (!stillInRange)
+            cancel();
+    }
+    else if (closest && closestDistance < preloadDistance && !isBusy())
+    {
+        start(closest->zenFile);
+    }
+}
+
+std::unique_ptr<PreloadedZen> WorldPreloader::adopt(const std::string& zenFile)
+{
+    std::shared_future<void> worker;
+    {
+        std::lock_guard<std::mutex> guard(m_Mutex);
+        if (m_ZenFile.empty())
+            return nullptr;
+
+        if (m_ZenFile == Utils::uppered(zenFile))
+        {
+            m_Stop = Stop_Adopt;
+            worker = m_Worker;
+        }
+    }
+
+    if (!worker.valid())
+    {
+        // Loading a different world than the one preloaded
+        cancel();
+        return nullptr;
+    }
+
+    worker.wait();
+
+    std::lock_guard<std::mutex> guard(m_Mutex);
+    m_ZenFile.clear();
+
+    if (m_Result)
+        LogInfo() << "Adopting preloaded " << m_Result->zenFile << " (" << m_NumAssetsBaked.load() << "/"
+                  << m_NumAssetsTotal.load() << " assets baked)";
+
+    return std::move(m_Result);
+}
+
+void WorldPreloader::cancel()
+{
+    std::lock_guard<std::mutex> guard(m_Mutex);
+    if (m_ZenFile.empty())
+        return;
+
+    LogInfo() << "Cancelling preload of " << m_ZenFile;
+
+    m_Stop = Stop_Cancel;
+    m_ZenFile.clear();
+    m_Result.reset();
+}
+
+std::string WorldPreloader::getStatus()
+{
+    if (!isEnabled())
+        return "Preloading is disabled, see --preload-levels";
+
+    std::lock_guard<std::mutex> guard(m_Mutex);
+    if (m_ZenFile.empty())
+        return "Idle";
+
+    std::string status = "Preloading " + m_ZenFile + ": ";
+    status += m_Result ? "zen parsed (" + std::to_string(estimateMemory(*m_Result) / (1024 * 1024)) + " MB)"
+                       : "zen not parsed";
+    status += ", " + std::to_string(m_NumAssetsBaked.load()) + "/" + std::to_string(m_NumAssetsTotal.load()) + " assets baked";
+
+    return status;
+}
+
+bool WorldPreloader::isBusy()
+{
+    return m_Worker.valid() && m_Worker.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+}
+
+void WorldPreloader::start(const std::string& zenFile)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_Mutex);
+        m_ZenFile = zenFile;
+        m_Result.reset();
+        m_Stop = Stop_None;
+        m_NumAssetsBaked = 0;
+        m_NumAssetsTotal = 0;
+    }
+
+    LogInfo() << "Player is close to the level-change to " << zenFile << ", preloading it";
+
+    std::shared_future<void> worker = m_Engine.getJobManager().executeInThread<void>([this, zenFile](BaseEngine* engine) {
+        run(zenFile);
+    }, ExecutionPolicy::NewThread).share();
+
+    std::lock_guard<std::mutex> guard(m_Mutex);
+    m_Worker = worker;
+}
+
+void WorldPreloader::run(const std::string& zenFile)
+{
+    Utils::FrameProfiler::setThreadName("World preloading");
+
+    VDFS::FileIndex& idx = m_Engine.getVDFSIndex();
+    if (!idx.hasFile(zenFile))
+    {
+        LogWarn() << "Can't preload " << zenFile << ", the file doesn't exist";
+        return;
+    }
+
+    size_t budget = static_cast<size_t>(atof(Flags::preloadBudget.getParam(0).c_str()) * 1024 * 1024);
+
+    // The parser reads the whole file into memory first, so a zen bigger than the budget can't fit once parsed either.
+    // Only checked for mapped files, getting the size of any other file would mean reading it an extra time.
+    size_t fileSize = 0;
+    if (m_Engine.getMappedArchives().getMappedSize(zenFile, fileSize) && fileSize > budget)
+    {
+        LogInfo() << "Not preloading " << zenFile << ", the file alone is over budget (" << fileSize / 1024 << " of "
+                  << budget / 1024 << " KB)";
+        return;
+    }
+
+    int64_t start = bx::getHPCounter();
+
+    std::unique_ptr<PreloadedZen> zen = std::make_unique<PreloadedZen>();
+    zen->zenFile = zenFile;
+
+    {
+        ZenLoad::ZenParser parser(zenFile, idx);
+        parser.readHeader();
+        parser.readWorld(zen->world);
+
+        if (m_Stop == Stop_Cancel)
+            return;
+
+        parser.getWorldMesh()->packMesh(zen->packedWorldMesh, 0.01f, false);
+    }
+
+    // Find out what the world is going to need, before the parsed zen possibly gets thrown away
+    std::set<std::string> textures;
+    for (const auto& sm : zen->packedWorldMesh.subMeshes)
+    {
+        if (!sm.material.texture.empty())
+            textures.insert(Utils::uppered(sm.material.texture));
+    }
+
+    std::set<std::string> meshes;
+    collectVobMeshes(zen->world.rootVobs, meshes);
+
+    size_t bytes = estimateMemory(*zen);
+
+    LogInfo() << "Parsed " << zenFile << " in " << (bx::getHPCounter() - start) * 1000.0 / bx::getHPFrequency()
+              << "ms, takes up " << bytes / 1024 << " KB";
+
+    if (bytes > budget)
+    {
+        LogInfo() << "Preloaded " << zenFile << " is over budget (" << budget / 1024 << " KB), only baking its assets";
+        zen.reset();
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(m_Mutex);
+        if (m_Stop == Stop_Cancel)
+            return;
+
+        m_Result = std::move(zen);
+    }
+
+    // Decoding textures and meshes only helps if the results are kept somewhere the loading-thread finds them
+    if (!m_Engine.getBakeCache().isEnabled())
+        return;
+
+    m_NumAssetsTotal = textures.size() + meshes.size();
+
+    Content::AssetCache& cache = m_Engine.getAssetCache();
+    auto bake = [&](const std::set<std::string>& files, bool texture) {
+        for (const std::string& file : files)
+        {
+            if (m_Stop != Stop_None)
+                return;
+
+            if (texture)
+                cache.getTextureAllocator().bakeTextureVDF(idx, file);
+            else
+                cache.getStaticMeshAllocator().bakeMeshVDF(idx, file);
+
+            m_NumAssetsBaked++;
+
+            // Stay out of the way of the running game
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    };
+
+    bake(textures, true);
+    bake(meshes, false);
+
+    LogInfo() << "Preloading " << zenFile << " done after " << (bx::getHPCounter() - start) / double(bx::getHPFrequency())
+              << "s, baked " << m_NumAssetsBaked.load() << "/" << m_NumAssetsTotal.load() << " assets";
+}
@@ -0,0 +1,127 @@
+#pragma once
+#include <atomic>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <zenload/zTypes.h>
+
+namespace Engine
+{
+    class BaseEngine;
+
+    /**
+     * What WorldInstance::init() would otherwise read out of the zen-file itself
+     */
+    struct PreloadedZen
+    {
+        std::string zenFile;
+        ZenLoad::oCWorldData world;
+        ZenLoad::PackedMesh packedWorldMesh;
+    };
+
+    /**
+     * Starts loading the destination of a level-change trigger in the background, once the player gets close to it.
+     *
+     * The worker parses the destination zen and packs its worldmesh, then decodes the textures and meshes the world
+     * will need into the bake-cache, yielding between each one so it doesn't compete with the running game. When the
+     * player enters the trigger, the world is switched and the loading-thread adopts whatever the worker got done.
+     * Walking away again cancels the worker and frees the parsed zen.
+     *
+     * Disabled unless --preload-levels is given.
+     */
+    class WorldPreloader
+    {
+    public:
+        WorldPreloader(BaseEngine& engine);
+
+        /**
+         * Cancels the worker and waits for it
+         */
+        ~WorldPreloader();
+
+        /**
+         * @return Whether predictive loading was enabled on the commandline
+         */
+        static bool isEnabled();
+
+        /**
+         * Checks the player of the main world against its level-change triggers. Starts or cancels preloading and
+         * switches the world once the player is inside a trigger. Call once per frame, from the main thread.
+         */
+        void onFrameUpdate();
+
+        /**
+         * Stops the worker and hands over the parsed zen, if it is the one asked for. If the worker is still parsing,
+         * this waits for it to finish, as that is quicker than starting over. Anything else is cancelled.
+         * Safe to call from the world-loading thread.
+         * @param zenFile World about to be loaded
+         * @return Preloaded state of the given world, nullptr if there is none
+         */
+        std::unique_ptr<PreloadedZen> adopt(const std::string& zenFile);
+
+        /**
+         * Cancels the worker without waiting for it. The parsed zen is dropped.
+         */
+        void cancel();
+
+        /**
+         * @return Human readable state of the preloader, for the console
+         */
+        std::string getStatus();
+
+    private:
+        enum EStop
+        {
+            Stop_None,
+            Stop_Cancel,  // Drop everything
+            Stop_Adopt,   // Stop, but keep the parsed zen
+        };
+
+        /**
+         * Starts the worker on the given world. The previous worker must have finished.
+         */
+        void start(const std::string& zenFile);
+
+        /**
+         * Worker-thread
+         */
+        void run(const std::string& zenFile);
+
+        /**
+         * @return Whether the worker is still running
+         */
+        bool isBusy();
+
+        BaseEngine& m_Engine;
+
+        /**
+         * Guards everything shared with the worker, except for m_Stop
+         */
+        std::mutex m_Mutex;
+        std::shared_future<void> m_Worker;
+        std::atomic<int> m_Stop;
+
+        /**
+         * World the worker is/was loading, upper case
+         */
+        std::string m_ZenFile;
+
+        /**
+         * Result of the worker. Only set once the zen was parsed, and only if it fits the memory-budget.
+         */
+        std::unique_ptr<PreloadedZen> m_Result;
+
+        /**
+         * Progress of the worker, for getStatus()
+         */
+        std::atomic<size_t> m_NumAssetsBaked;
+        std::atomic<size_t> m_NumAssetsTotal;
+
+        /**
+         * Triggers only fire once the player was seen outside of all of them, so arriving inside one doesn't send the
+         * player straight back, and a switch already under way isn't started a second time
+         */
+        bool m_Armed = false;
+    };
+}
@@ -55,6 +55,7 @@ Logic::CameraController::CameraController(World::WorldInstance& world, Handle::E
     m_CameraSettings.dialogueCameraSettings.dontShowHeroChance = 4;
 
     m_KeyframeDuration = 1.0f;
+    m_KeyframeActive = -1.0f;
     setupKeybinds();
 }
 
@@ -608,6 +609,54 @@ void Logic::CameraController::playKeyframes(float speed)
     setCameraMode(ECameraMode::KeyedAnimation);
 }
 
+void Logic::CameraController::exportKeyframes(json& j)
+{
+    j["keyframes"] = json::array();
+    for (const Keyframe& f : m_Keyframes)
+    {
+        j["keyframes"].push_back({{"position", {f.position.x, f.position.y, f.position.z}},
+                                  {"lookat", {f.lookat.x, f.lookat.y, f.lookat.z}}});
+    }
+}
+
+/**
+ * Reads a vector stored as [x, y, z]
+ * @return false, if the given value isn't an array of 3 numbers
+ */
+static bool readKeyframeVector(const json& v, Math::float3& out)
+{
+    if (!v.is_array() || v.size() != 3 || !v[0].is_number() || !v[1].is_number() || !v[2].is_number())
+        return false;
+
+    out = Math::float3(v[0].get<float>(), v[1].get<float>(), v[2].get<float>());
+    return true;
+}
+
+bool Logic::CameraController::importKeyframes(const json& j)
+{
+    if (j.find("keyframes") == j.end() || !j["keyframes"].is_array())
+        return false;
+
+    std::vector<Keyframe> keyframes;
+    for (const json& jf : j["keyframes"])
+    {
+        if (!jf.is_object() || !jf.count("position") || !jf.count("lookat"))
+            return false;
+
+        Keyframe f;
+        if (!readKeyframeVector(jf["position"], f.position) || !readKeyframeVector(jf["lookat"], f.lookat))
+            return false;
+
+        keyframes.push_back(f);
+    }
+
+    if (keyframes.empty())
+        return false;
+
+    m_Keyframes = std::move(keyframes);
+    return true;
+}
+
 std::pair<Math::float3, Math::float3> Logic::CameraController::updateKeyframedPlay(float dt)
 {
     if(m_KeyframeActive == -1.0f)
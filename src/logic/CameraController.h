@@ -256,6 +256,22 @@ namespace Logic
          * Plays all stored keyframes
          */
         void playKeyframes(float duration = 1.0f);
+
+        /**
+         * @return Whether the stored keyframes are currently being played
+         */
+        bool isPlayingKeyframes() { return m_CameraMode == ECameraMode::KeyedAnimation && m_KeyframeActive != -1.0f; }
+
+        /**
+         * Writes the stored keyframes into the given json-object
+         */
+        void exportKeyframes(json& j);
+
+        /**
+         * Replaces the stored keyframes with the ones from the given json-object
+         * @return false, if the object did not contain valid keyframes
+         */
+        bool importKeyframes(const json& j);
     protected:
 
         /**
@@ -1,4 +1,5 @@
 #include "Inventory.h"
+#include <iterator>
 #include "PlayerController.h"
 #include "ScriptEngine.h"
 #include <components/VobClasses.h>
@@ -9,7 +10,9 @@ using namespace Logic;
 Inventory::Inventory(World::WorldInstance& world, Daedalus::GameState::NpcHandle npc)
     : m_World(world)
     , m_NPC(npc)
+    , m_CategoryMask(0)
 {
+    m_NumItemsByCategoryBit.fill(0);
 }
 
 Inventory::~Inventory()
@@ -69,24 +72,26 @@ bool Inventory::removeItem(Daedalus::GameState::ItemHandle item, unsigned int co
 
     Daedalus::GEngineClasses::C_Item& data = vm.getGameState().getItem(item);
 
-    return vm.getGameState().removeInventoryItem(data.instanceSymbol, m_NPC, count);
+    size_t instanceSymbol = data.instanceSymbol;
+    size_t numItemsBefore = getItems().size();
+    bool removed = vm.getGameState().removeInventoryItem(instanceSymbol, m_NPC, count);
+
+    // Last one of the stack gone?
+    if (getItems().size() < numItemsBefore)
+        unindexItem(item, instanceSymbol);
+
+    return removed;
 }
 
 Daedalus::GameState::ItemHandle Inventory::getItem(size_t symIndex)
 {
-    // Get script-engine
-    Logic::ScriptEngine& vm = m_World.getScriptEngine();
-    const std::list<Daedalus::GameState::ItemHandle>& items = getItems();
-
-    for (Daedalus::GameState::ItemHandle h : items)
-    {
-        Daedalus::GEngineClasses::C_Item& data = vm.getGameState().getItem(h);
+    syncIndex();
 
-        if (data.instanceSymbol == symIndex)
-            return h;
-    }
+    auto it = m_IndexBySymbol.find(symIndex);
+    if (it == m_IndexBySymbol.end())
+        return Daedalus::GameState::ItemHandle();
 
-    return Daedalus::GameState::ItemHandle();
+    return m_IndexedItems[it->second].handle;
 }
 
 Daedalus::GameState::ItemHandle Inventory::getItem(const std::string& sym)
@@ -103,6 +108,13 @@ Daedalus::GEngineClasses::C_Item& Inventory::getItem(Daedalus::GameState::ItemHa
     return vm.getGameState().getItem(item);
 }
 
+uint32_t Inventory::getCategoryMask()
+{
+    syncIndex();
+
+    return m_CategoryMask;
+}
+
 unsigned int Inventory::getItemCount(size_t symIndex)
 {
     Daedalus::GameState::ItemHandle item = getItem(symIndex);
@@ -163,3 +175,128 @@ void Inventory::clear()
 
     assert(getItems().empty());
 }
+
+void Inventory::syncIndex()
+{
+    const std::list<Daedalus::GameState::ItemHandle>& items = getItems();
+
+    if (items.size() == m_IndexedItems.size())
+        return;
+
+    if (items.size() < m_IndexedItems.size())
+    {
+        // Something got removed without us knowing
+        rebuildIndex();
+        return;
+    }
+
+    // New items are appended by the game-state, so only look at those
+    size_t numNew = items.size() - m_IndexedItems.size();
+    auto it = items.end();
+    std::advance(it, -static_cast<std::ptrdiff_t>(numNew));
+
+    for (; it != items.end(); it++)
+    {
+        if (!indexItem(*it))
+        {
+            // Not the items we expected, start over
+            rebuildIndex();
+            return;
+        }
+    }
+}
+
+void Inventory::rebuildIndex()
+{
+    m_IndexedItems.clear();
+    m_IndexBySymbol.clear();
+    m_NumItemsByCategoryBit.fill(0);
+    m_CategoryMask = 0;
+
+    for (Daedalus::GameState::ItemHandle h : getItems())
+        indexItem(h);
+}
+
+bool Inventory::indexItem(Daedalus::GameState::ItemHandle item)
+{
+    Daedalus::GEngineClasses::C_Item& data = m_World.getScriptEngine().getGameState().getItem(item);
+
+    auto it = m_IndexBySymbol.find(data.instanceSymbol);
+    if (it != m_IndexBySymbol.end() && m_IndexedItems[it->second].handle == item)
+        return false;
+
+    IndexedItem entry;
+    entry.handle = item;
+    entry.instanceSymbol = data.instanceSymbol;
+    entry.mainflag = static_cast<uint32_t>(data.mainflag);
+
+    if (it == m_IndexBySymbol.end())
+        m_IndexBySymbol[entry.instanceSymbol] = m_IndexedItems.size();
+
+    m_IndexedItems.push_back(entry);
+
+    for (uint32_t bit = 0; bit < 32; bit++)
+    {
+        if (entry.mainflag & (1u << bit))
+            m_NumItemsByCategoryBit[bit]++;
+    }
+
+    m_CategoryMask |= entry.mainflag;
+    return true;
+}
+
+void Inventory::unindexItem(Daedalus::GameState::ItemHandle item, size_t instanceSymbol)
+{
+    auto bySymbol = m_IndexBySymbol.find(instanceSymbol);
+    if (bySymbol == m_IndexBySymbol.end())
+        return;
+
+    size_t pos = bySymbol->second;
+    if (!(m_IndexedItems[pos].handle == item))
+    {
+        // One of multiple items of the same instance
+        pos = 0;
+        while (pos < m_IndexedItems.size() && !(m_IndexedItems[pos].handle == item))
+            pos++;
+    }
+
+    if (pos == m_IndexedItems.size())
+        return;
+
+    IndexedItem removed = m_IndexedItems[pos];
+
+    for (uint32_t bit = 0; bit < 32; bit++)
+    {
+        if ((removed.mainflag & (1u << bit)) && --m_NumItemsByCategoryBit[bit] == 0)
+            m_CategoryMask &= ~(1u << bit);
+    }
+
+    // Keep the array dense by moving the last item into the gap
+    size_t last = m_IndexedItems.size() - 1;
+    if (pos != last)
+    {
+        m_IndexedItems[pos] = m_IndexedItems[last];
+
+        auto moved = m_IndexBySymbol.find(m_IndexedItems[pos].instanceSymbol);
+        if (moved != m_IndexBySymbol.end() && moved->second == last)
+            moved->second = pos;
+    }
+
+    m_IndexedItems.pop_back();
+
+    // Point the symbol at another item of the same instance, if there is one
+    auto it = m_IndexBySymbol.find(removed.instanceSymbol);
+    if (it != m_IndexBySymbol.end() && (it->second == pos || it->second >= m_IndexedItems.size()))
+    {
+        m_IndexBySymbol.erase(it);
+
+        for (size_t i = 0; i < m_IndexedItems.size(); i++)
+        {
+            if (m_IndexedItems[i].instanceSymbol == removed.instanceSymbol)
+            {
+                m_IndexBySymbol[removed.instanceSymbol] = i;
+                break;
+            }
+        }
+    }
+}
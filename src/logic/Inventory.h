@@ -1,4 +1,7 @@
 #pragma once
+#include <array>
+#include <unordered_map>
+#include <vector>
 #include <json.hpp>
 #include <daedalus/DaedalusGameState.h>
 #include <handle/HandleDef.h>
@@ -12,6 +15,14 @@ namespace World
 
 namespace Logic
 {
+    /**
+     * Items of an NPC. The items themselves live inside the inventory of the script game-state, which stays the
+     * authoritative source. This keeps an index on top of it, so items can be looked up by instance without
+     * walking the whole inventory.
+     *
+     * Removals have to go through this class. Items added directly to the game-state are picked up on the next
+     * lookup, by comparing the number of items known to the index against the game-state.
+     */
     class Inventory
     {
     public:
@@ -54,6 +65,16 @@ namespace Logic
          */
         Daedalus::GEngineClasses::C_Item& getItem(Daedalus::GameState::ItemHandle item);
 
+        /**
+         * @return Bitwise OR of the main-flags (ITM_CAT_*) of all items in this inventory
+         */
+        uint32_t getCategoryMask();
+
+        /**
+         * @return Whether an item with any of the given main-flags (ITM_CAT_*) is in this inventory
+         */
+        bool hasItemOfCategory(uint32_t mainflags) { return (getCategoryMask() & mainflags) != 0; }
+
         /**
          * @return Count of how many items of the given type are in this inventory
          */
@@ -79,6 +100,55 @@ namespace Logic
         void importInventory(const json& j);
 
     protected:
+        /**
+         * Brings the index up to date with the inventory of the game-state
+         */
+        void syncIndex();
+
+        /**
+         * Rebuilds the index from scratch
+         */
+        void rebuildIndex();
+
+        /**
+         * Adds an item of the game-state inventory to the index
+         * @return false, if the item was already indexed
+         */
+        bool indexItem(Daedalus::GameState::ItemHandle item);
+
+        /**
+         * Removes the given item from the index
+         * @param instanceSymbol Instance of the item. Passed in, as the item may not exist in the game-state anymore.
+         */
+        void unindexItem(Daedalus::GameState::ItemHandle item, size_t instanceSymbol);
+
+        /**
+         * Entry of the index
+         */
+        struct IndexedItem
+        {
+            Daedalus::GameState::ItemHandle handle;
+            size_t instanceSymbol;
+            uint32_t mainflag;
+        };
+
+        /**
+         * All items of the inventory, in no particular order
+         */
+        std::vector<IndexedItem> m_IndexedItems;
+
+        /**
+         * Position in m_IndexedItems by instance-symbol. Should the game-state ever hold more than one item
+         * of an instance, this points to one of them.
+         */
+        std::unordered_map<size_t, size_t> m_IndexBySymbol;
+
+        /**
+         * Number of indexed items for each bit of the main-flags, and the resulting mask
+         */
+        std::array<uint32_t, 32> m_NumItemsByCategoryBit;
+        uint32_t m_CategoryMask;
+
         /**
          * NPC this inventory belongs to
          */
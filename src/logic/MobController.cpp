@@ -217,6 +217,7 @@ void MobController::initFromVobDescriptor(const ZenLoad::zCVobData& vob)
 {
     m_FocusName = vob.vobName;
     m_zObjectClass = vob.objectClass;
+    m_World.getScriptEngine().setMobName(m_Entity, m_FocusName);
 
     if (m_FocusName == "Bed")
         m_MobCore = new MobCores::Bed(m_World, m_Entity);
@@ -247,6 +248,7 @@ void MobController::initFromJSONDescriptor(const json& j)
 {
     m_FocusName = j["focusName"];
     m_zObjectClass = j["objectClass"];
+    m_World.getScriptEngine().setMobName(m_Entity, m_FocusName);
 
     if (m_FocusName == "Bed")
         m_MobCore = new MobCores::Bed(m_World, m_Entity);
@@ -273,7 +275,7 @@ void MobController::onMessage(std::shared_ptr<EventMessages::EventMessage> messa
     Controller::onMessage(message, sourceVob);
     assert(message->messageType == EventMessages::EventMessageType::Mob);
 
-    EventMessages::MobMessage& msg = *std::dynamic_pointer_cast<EventMessages::MobMessage>(message);
+    EventMessages::MobMessage& msg = *std::static_pointer_cast<EventMessages::MobMessage>(message);
     switch ((EventMessages::MobMessage::MobSubType)msg.subType)
     {
         case EventMessages::MobMessage::ST_STARTINTERACTION:
@@ -305,8 +307,8 @@ void MobController::callOnStateFunc(Handle::EntityHandle npc, int state)
     if (idx != static_cast<size_t>(-1))
     {
         VobTypes::NpcVobInformation nv = VobTypes::asNpcVob(m_World, npc);
-        s.setInstanceNPC("self", VobTypes::getScriptHandle(nv));
-        s.setInstanceItem("item", nv.playerController->getInteractItem());
+        s.setInstanceNPC(s.getCommonSymbols().self, VobTypes::getScriptHandle(nv));
+        s.setInstanceItem(s.getCommonSymbols().item, nv.playerController->getInteractItem());
 
         s.prepareRunFunction();
         s.runFunctionBySymIndex(idx);
@@ -0,0 +1,91 @@
+#include "NpcAIScheduler.h"
+#include <algorithm>
+#include <bx/timer.h>
+
+using namespace Logic;
+
+NpcAIScheduler::TickScope::TickScope(NpcAIScheduler& scheduler, bool active)
+    : m_Scheduler(scheduler)
+    , m_Active(active)
+    , m_Start(active ? bx::getHPCounter() : 0)
+{
+}
+
+NpcAIScheduler::TickScope::~TickScope()
+{
+    if (m_Active)
+        m_Scheduler.m_SpentTicks += bx::getHPCounter() - m_Start;
+}
+
+NpcAIScheduler::NpcAIScheduler()
+    : m_Enabled(true)
+    , m_CameraPosition(0, 0, 0)
+    , m_CameraForward(0, 0, 1)
+    , m_UpdateRange(0.0f)
+    , m_SpentTicks(0)
+    , m_BudgetTicks(0)
+{
+}
+
+void NpcAIScheduler::beginFrame(const Math::Matrix& cameraWorld, float updateRange)
+{
+    m_FrameStats.timeMs = float(m_SpentTicks * 1000.0 / double(bx::getHPFrequency()));
+    m_LastFrameStats = m_FrameStats;
+    m_FrameStats = Stats();
+
+    m_CameraPosition = cameraWorld.Translation();
+    m_CameraForward = cameraWorld.Forward();
+    m_UpdateRange = updateRange;
+
+    m_SpentTicks = 0;
+    m_BudgetTicks = (int64_t)(m_Config.budgetMs / 1000.0 * double(bx::getHPFrequency()));
+}
+
+float NpcAIScheduler::getTickInterval(const Math::float3& position) const
+{
+    Math::float3 toNpc = position - m_CameraPosition;
+    float distance = toNpc.length();
+
+    if (distance <= m_Config.fullRateDistance || m_UpdateRange <= m_Config.fullRateDistance)
+        return 0.0f;
+
+    float t = std::min(1.0f, (distance - m_Config.fullRateDistance) / (m_UpdateRange - m_Config.fullRateDistance));
+    float interval = t * m_Config.maxInterval;
+
+    // Behind the camera?
+    if (toNpc.dot(m_CameraForward) < 0.0f)
+        interval *= m_Config.invisibleIntervalFactor;
+
+    return interval;
+}
+
+bool NpcAIScheduler::shouldTick(const Math::float3& position, bool isBusy, float timeSinceLastTick)
+{
+    if (!m_Enabled || isBusy)
+    {
+        m_FrameStats.numTicked++;
+        return true;
+    }
+
+    float interval = getTickInterval(position);
+    if (timeSinceLastTick < interval)
+    {
+        m_FrameStats.numSkipped++;
+        return false;
+    }
+
+    // Background NPCs have to fit into the budget
+    if (interval > 0.0f && m_SpentTicks >= m_BudgetTicks)
+    {
+        if (timeSinceLastTick < m_Config.maxDelay)
+        {
+            m_FrameStats.numDeferred++;
+            return false;
+        }
+
+        m_FrameStats.numForced++;
+    }
+
+    m_FrameStats.numTicked++;
+    return true;
+}
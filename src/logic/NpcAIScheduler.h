@@ -0,0 +1,137 @@
+#pragma once
+#include <cstdint>
+#include <math/mathlib.h>
+
+namespace Logic
+{
+    /**
+     * Decides which NPCs get their AI (script-states, message-queue, movement) ticked in the current frame.
+     * NPCs close to the camera and NPCs busy with actions are ticked every frame. Background NPCs are ticked
+     * less often the further away they are, even less if they are behind the camera. Those ticks are further
+     * limited by a per-frame time-budget, spreading them across frames.
+     *
+     * NPCs accumulate the time passed between their ticks themselves and pass all of it on once they get ticked,
+     * so state-times stay correct.
+     */
+    class NpcAIScheduler
+    {
+    public:
+        struct Config
+        {
+            /**
+             * NPCs closer to the camera than this are ticked every frame
+             */
+            float fullRateDistance = 15.0f;
+
+            /**
+             * Interval in seconds to use for NPCs at the border of the update-range. Scales linearly
+             * from 0 at fullRateDistance.
+             */
+            float maxInterval = 0.5f;
+
+            /**
+             * Interval-multiplier for NPCs behind the camera
+             */
+            float invisibleIntervalFactor = 2.0f;
+
+            /**
+             * Time in milliseconds background NPCs may spend per frame. NPCs which are ticked every
+             * frame count into this, but are never held back by it.
+             */
+            float budgetMs = 2.0f;
+
+            /**
+             * NPCs which haven't been ticked for this long are ticked, regardless of the budget
+             */
+            float maxDelay = 1.0f;
+        };
+
+        struct Stats
+        {
+            // NPCs which have been ticked
+            uint32_t numTicked = 0;
+
+            // NPCs which were not due yet
+            uint32_t numSkipped = 0;
+
+            // NPCs which were due, but held back because the budget was used up
+            uint32_t numDeferred = 0;
+
+            // NPCs which were ticked after being held back for too long, even though the budget was used up
+            uint32_t numForced = 0;
+
+            // Time spent in ticked NPCs
+            float timeMs = 0.0f;
+        };
+
+        /**
+         * Measures the time of one NPC-tick
+         */
+        class TickScope
+        {
+        public:
+            TickScope(NpcAIScheduler& scheduler, bool active);
+            ~TickScope();
+
+        private:
+            NpcAIScheduler& m_Scheduler;
+            bool m_Active;
+            int64_t m_Start;
+        };
+
+        NpcAIScheduler();
+
+        /**
+         * Whether NPCs should be scheduled at all. If disabled, all NPCs are ticked every frame.
+         */
+        void setEnabled(bool enabled) { m_Enabled = enabled; }
+        bool isEnabled() const { return m_Enabled; }
+
+        Config& getConfig() { return m_Config; }
+
+        /**
+         * To be called before any NPC was updated
+         * @param cameraWorld World-matrix of the camera NPC-distances are measured from
+         * @param updateRange Range in which entities get updated at all
+         */
+        void beginFrame(const Math::Matrix& cameraWorld, float updateRange);
+
+        /**
+         * Decides whether the NPC at the given position should be ticked this frame.
+         * Call once per NPC and frame, as this updates the statistics.
+         * @param position Position of the NPC
+         * @param isBusy Whether the NPC is doing something which needs to be handled every frame, e.g. moving
+         * @param timeSinceLastTick Time the NPC has accumulated since its last tick, including this frame
+         * @return True, if the NPC should be ticked with its accumulated time
+         */
+        bool shouldTick(const Math::float3& position, bool isBusy, float timeSinceLastTick);
+
+        /**
+         * @return Statistics of the last full frame
+         */
+        const Stats& getLastFrameStats() const { return m_LastFrameStats; }
+
+    private:
+
+        /**
+         * @return Interval in seconds the NPC at the given position should be ticked with
+         */
+        float getTickInterval(const Math::float3& position) const;
+
+        bool m_Enabled;
+        Config m_Config;
+
+        Math::float3 m_CameraPosition;
+        Math::float3 m_CameraForward;
+        float m_UpdateRange;
+
+        /**
+         * Ticks of time spent in ticked NPCs during the current frame
+         */
+        int64_t m_SpentTicks;
+        int64_t m_BudgetTicks;
+
+        Stats m_FrameStats;
+        Stats m_LastFrameStats;
+    };
+}
@@ -0,0 +1,98 @@
+#include "NpcRoutineScheduler.h"
+#include <components/VobClasses.h>
+#include <engine/BaseEngine.h>
+#include <engine/GameClock.h>
+#include <engine/World.h>
+#include <logic/PlayerController.h>
+#include <logic/ScriptEngine.h>
+
+using namespace Logic;
+
+NpcRoutineScheduler::NpcRoutineScheduler(World::WorldInstance& world)
+    : m_World(world)
+{
+    const Engine::GameClock& clock = m_World.getEngine()->getGameClock();
+
+    m_LastNumTimeJumps = clock.getNumTimeJumps();
+    m_LastGameMinute = getGameMinute(clock);
+}
+
+void NpcRoutineScheduler::schedule(Handle::EntityHandle npc, int64_t gameMinute, uint32_t generation)
+{
+    m_Queue.push({gameMinute, npc, generation});
+}
+
+void NpcRoutineScheduler::update()
+{
+    const Engine::GameClock& clock = m_World.getEngine()->getGameClock();
+    int64_t now = getGameMinute(clock);
+
+    Stats stats;
+
+    // Pending checks are meaningless once the clock has been set
+    if (clock.getNumTimeJumps() != m_LastNumTimeJumps || now < m_LastGameMinute)
+    {
+        m_LastNumTimeJumps = clock.getNumTimeJumps();
+        m_LastGameMinute = now;
+
+        wakeAll();
+
+        stats.numWoken = static_cast<uint32_t>(m_World.getScriptEngine().getWorldNPCs().size());
+        stats.numPending = static_cast<uint32_t>(m_Queue.size());
+        m_LastFrameStats = stats;
+        return;
+    }
+
+    m_LastGameMinute = now;
+
+    // NPCs reschedule while being woken, but never for the current minute, so this terminates
+    while (!m_Queue.empty() && m_Queue.top().gameMinute <= now)
+    {
+        Wakeup w = m_Queue.top();
+        m_Queue.pop();
+
+        if (wake(w))
+            stats.numWoken++;
+        else
+            stats.numStale++;
+    }
+
+    stats.numPending = static_cast<uint32_t>(m_Queue.size());
+    m_LastFrameStats = stats;
+}
+
+int64_t NpcRoutineScheduler::getGameMinute(const Engine::GameClock& clock)
+{
+    int h, m;
+    clock.getTimeOfDay(h, m);
+
+    return static_cast<int64_t>(clock.getDay()) * 24 * 60 + h * 60 + m;
+}
+
+void NpcRoutineScheduler::wakeAll()
+{
+    m_Queue = decltype(m_Queue)();
+
+    for (Handle::EntityHandle e : m_World.getScriptEngine().getWorldNPCs())
+    {
+        VobTypes::NpcVobInformation npc = VobTypes::asNpcVob(m_World, e);
+
+        if (npc.isValid())
+            npc.playerController->getAIStateMachine().onRoutineWake();
+    }
+}
+
+bool NpcRoutineScheduler::wake(const Wakeup& w)
+{
+    VobTypes::NpcVobInformation npc = VobTypes::asNpcVob(m_World, w.npc);
+
+    if (!npc.isValid())
+        return false;
+
+    NpcScriptState& state = npc.playerController->getAIStateMachine();
+    if (state.getRoutineScheduleGeneration() != w.generation)
+        return false;
+
+    state.onRoutineWake();
+    return true;
+}
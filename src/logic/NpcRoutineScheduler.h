@@ -0,0 +1,106 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <vector>
+#include <handle/HandleDef.h>
+
+namespace World
+{
+    class WorldInstance;
+}
+
+namespace Engine
+{
+    class GameClock;
+}
+
+namespace Logic
+{
+    /**
+     * Wakes NPCs once the daily routine they follow may have to change, instead of having every NPC check
+     * its routine against the clock each frame.
+     *
+     * NPCs schedule a check for the next game-minute at which one of their routine-entries starts or ends.
+     * Since those are keyed on game-time rather than real-time, changing the clock-speed needs no special care.
+     * Whenever the clock is set directly (new game, savegame, wld_settime, console), all pending checks
+     * are dropped and every NPC is checked right away.
+     */
+    class NpcRoutineScheduler
+    {
+    public:
+        struct Stats
+        {
+            // NPCs which had their routine checked
+            uint32_t numWoken = 0;
+
+            // Checks which were outdated by the time they were due
+            uint32_t numStale = 0;
+
+            // Checks still pending
+            uint32_t numPending = 0;
+        };
+
+        NpcRoutineScheduler(World::WorldInstance& world);
+
+        /**
+         * Schedules a routine-check for the given NPC. Checks with an other generation than the one the NPC
+         * currently has are dropped when due, so NPCs can outdate checks by increasing their generation.
+         * @param npc NPC to wake
+         * @param gameMinute When to wake the NPC, see getGameMinute()
+         * @param generation Current schedule-generation of the NPC
+         */
+        void schedule(Handle::EntityHandle npc, int64_t gameMinute, uint32_t generation);
+
+        /**
+         * Wakes all NPCs whose checks are due. To be called once per frame, before NPCs are updated.
+         */
+        void update();
+
+        /**
+         * @return Minutes since day 0, 0:00 on the given clock. Rounded the same way as GameClock::getTimeOfDay().
+         */
+        static int64_t getGameMinute(const Engine::GameClock& clock);
+
+        /**
+         * @return Statistics of the last frame
+         */
+        const Stats& getLastFrameStats() const { return m_LastFrameStats; }
+
+    private:
+        struct Wakeup
+        {
+            int64_t gameMinute;
+            Handle::EntityHandle npc;
+            uint32_t generation;
+
+            bool operator>(const Wakeup& other) const { return gameMinute > other.gameMinute; }
+        };
+
+        /**
+         * Drops all pending checks and checks every NPC of the world
+         */
+        void wakeAll();
+
+        /**
+         * Lets the NPC check its routine, if the wakeup is still current
+         * @return false, if the wakeup was outdated
+         */
+        bool wake(const Wakeup& w);
+
+        World::WorldInstance& m_World;
+
+        /**
+         * Pending checks, earliest first
+         */
+        std::priority_queue<Wakeup, std::vector<Wakeup>, std::greater<Wakeup>> m_Queue;
+
+        /**
+         * State of the clock at the last update, to detect jumps
+         */
+        uint32_t m_LastNumTimeJumps;
+        int64_t m_LastGameMinute;
+
+        Stats m_LastFrameStats;
+    };
+}
@@ -1,4 +1,6 @@
 #include "NpcScriptState.h"
+#include <algorithm>
+#include "NpcRoutineScheduler.h"
 #include "PlayerController.h"
 #include <ZenLib/utils/logger.h>
 #include <components/Vob.h>
@@ -40,6 +42,7 @@ NpcScriptState::NpcScriptState(World::WorldInstance& world, Handle::EntityHandle
     m_Routine.startNewRoutine = true;
     m_Routine.hasRoutine = false;
     m_Routine.routineActiveIdx = 0;
+    m_Routine.scheduleGeneration = 0;
 }
 
 NpcScriptState::~NpcScriptState()
@@ -52,10 +55,12 @@ bool Logic::NpcScriptState::startAIState(size_t symIdx, bool endOldState, bool i
     ScriptEngine& s = m_World.getScriptEngine();
     Daedalus::DATFile& dat = s.getVM().getDATFile();
 
+    const ScriptEngine::CommonSymbols& syms = s.getCommonSymbols();
+
     // Save script variables
-    m_StateOther = s.getNPCFromSymbol("other");
-    m_StateVictim = s.getNPCFromSymbol("victim");
-    m_StateItem = s.getItemFromSymbol("item");
+    m_StateOther = s.getNPCFromSymbol(syms.other);
+    m_StateVictim = s.getNPCFromSymbol(syms.victim);
+    m_StateItem = s.getItemFromSymbol(syms.item);
 
     if (!isPrgState)
     {
@@ -85,7 +90,7 @@ bool Logic::NpcScriptState::startAIState(size_t symIdx, bool endOldState, bool i
 
         // Just call the function
         s.prepareRunFunction();
-        s.setInstance("self", VobTypes::getScriptObject(vob).instanceSymbol);
+        s.setInstance(syms.self, VobTypes::getScriptObject(vob).instanceSymbol);
         s.runFunctionBySymIndex(symIdx);
 
         m_CurrentState.isRoutineState = oldIsRoutineState;
@@ -94,15 +99,10 @@ bool Logic::NpcScriptState::startAIState(size_t symIdx, bool endOldState, bool i
 
     m_NextState.isRoutineState = isRoutineState;
 
+    const ScriptEngine::StateFunctions& fns = s.getStateFunctions(symIdx);
     m_NextState.symIndex = symIdx;
-    m_NextState.symEnd = 0;
-    m_NextState.symLoop = 0;
-
-    if (dat.hasSymbolName(m_NextState.name + "_END"))
-        m_NextState.symEnd = dat.getSymbolIndexByName(m_NextState.name + "_END");
-
-    if (dat.hasSymbolName(m_NextState.name + "_LOOP"))
-        m_NextState.symLoop = dat.getSymbolIndexByName(m_NextState.name + "_LOOP");
+    m_NextState.symEnd = fns.symEnd;
+    m_NextState.symLoop = fns.symLoop;
 
     m_NextState.valid = true;
 
@@ -162,37 +162,11 @@ bool NpcScriptState::doAIState(float deltaTime)
 {
     VobTypes::NpcVobInformation vob = VobTypes::asNpcVob(m_World, m_HostVob);
     ScriptEngine& s = m_World.getScriptEngine();
-    Daedalus::DATFile& dat = s.getVM().getDATFile();
 
     // Increase time this state is already running
     if (m_CurrentState.valid && m_CurrentState.phase == NpcAIState::EPhase::Loop)
         m_CurrentState.stateTime += deltaTime;
 
-    std::string name = vob.playerController->getScriptInstance().name[0];
-
-    if (m_Routine.hasRoutine && isInRoutine())
-    {
-        int h, m;
-        m_World.getEngine()->getGameClock().getTimeOfDay(h, m);
-
-        if (!m_Routine.routine[m_Routine.routineActiveIdx].timeInRange(h, m))
-        {
-            // Find next
-            size_t i = 0;
-            for (RoutineEntry& e : m_Routine.routine)
-            {
-                if (e.timeInRange(h, m) && i != m_Routine.routineActiveIdx)
-                {
-                    m_Routine.routineActiveIdx = i;
-                    m_Routine.startNewRoutine = true;
-                    break;
-                }
-
-                i++;
-            }
-        }
-    }
-
     // Only do states if we do not have messages pending
     if (vob.playerController->getEM().isEmpty())
     {
@@ -228,17 +202,22 @@ bool NpcScriptState::doAIState(float deltaTime)
         if (m_CurrentState.valid)
         {
             // Prepare state function call
-            auto& inst = VobTypes::getScriptObject(vob);
-            s.setInstanceNPC("self", VobTypes::getScriptHandle(vob));
+            const ScriptEngine::CommonSymbols& syms = s.getCommonSymbols();
+            s.setInstanceNPC(syms.self, VobTypes::getScriptHandle(vob));
 
             // These are set by the game, but seem to be always 0
-            s.setInstanceNPC("OTHER", m_StateOther);
-            s.setInstanceNPC("VICTIM", m_StateVictim);
-            s.setInstanceItem("ITEM", m_StateItem);
+            s.setInstanceNPC(syms.other, m_StateOther);
+            s.setInstanceNPC(syms.victim, m_StateVictim);
+            s.setInstanceItem(syms.item, m_StateItem);
+
+            // Attribute everything done below to this state
+            ScriptProfiler::Scope profile(s.getProfiler(), ScriptProfiler::EKind::AIState,
+                                          m_CurrentState.symIndex, VobTypes::getScriptObject(vob).instanceSymbol);
 
             if (m_CurrentState.phase == NpcAIState::EPhase::Uninitialized)
             {
-                // TODO: Set perception-time to 5000
+                // Every state starts with the default perception-time, the setup-function may change it
+                vob.playerController->getPerceptions().interval = NpcPerceptions::DEFAULT_INTERVAL;
 
                 //LogInfo() << "AISTATE-INIT: " << m_CurrentState.name << " on NPC: " << VobTypes::getScriptObject(vob).name[0] << " (WP: " << VobTypes::getScriptObject(vob).wp << ")";
 
@@ -415,6 +394,8 @@ void NpcScriptState::insertRoutine(int hoursStart, int minutesStart, int hoursEn
     entry.isOverlay = false;
 
     m_Routine.routine.push_back(entry);
+
+    scheduleRoutineCheck(true);
 }
 
 bool NpcScriptState::isNpcStateDriven()
@@ -555,6 +536,8 @@ void NpcScriptState::importScriptState(const json& j)
     m_Routine.routineActiveIdx = j["activeRoutineIdx"];
     m_Routine.hasRoutine = !m_Routine.routine.empty();
 
+    scheduleRoutineCheck(true);
+
     // Start routine
     //reinitRoutine();
 }
@@ -563,6 +546,77 @@ void NpcScriptState::clearRoutine()
 {
     m_Routine.hasRoutine = false;
     m_Routine.routine.clear();
+
+    // Drops pending checks
+    scheduleRoutineCheck(false);
+}
+
+void NpcScriptState::onRoutineWake()
+{
+    if (!m_Routine.hasRoutine || m_Routine.routine.empty())
+        return;
+
+    // Also done while in some other state, so the right routine is picked up once the NPC returns to it
+    int h, m;
+    m_World.getEngine()->getGameClock().getTimeOfDay(h, m);
+
+    if (!m_Routine.routine[m_Routine.routineActiveIdx].timeInRange(h, m))
+    {
+        // Find next
+        size_t i = 0;
+        for (RoutineEntry& e : m_Routine.routine)
+        {
+            if (e.timeInRange(h, m) && i != m_Routine.routineActiveIdx)
+            {
+                m_Routine.routineActiveIdx = i;
+                m_Routine.startNewRoutine = true;
+                break;
+            }
+
+            i++;
+        }
+    }
+
+    scheduleRoutineCheck(false);
+}
+
+void NpcScriptState::scheduleRoutineCheck(bool immediately)
+{
+    const int MINUTES_PER_DAY = 24 * 60;
+
+    m_Routine.scheduleGeneration++;
+
+    if (!m_Routine.hasRoutine || m_Routine.routine.empty())
+        return;
+
+    int64_t now = NpcRoutineScheduler::getGameMinute(m_World.getEngine()->getGameClock());
+
+    if (immediately)
+    {
+        m_World.getRoutineScheduler().schedule(m_HostVob, now, m_Routine.scheduleGeneration);
+        return;
+    }
+
+    // timeInRange() excludes both the start- and end-minute, so an entry can only change
+    // whether it matches at those and the minutes right after
+    int minuteOfDay = static_cast<int>(now % MINUTES_PER_DAY);
+    int next = MINUTES_PER_DAY;
+
+    for (const RoutineEntry& e : m_Routine.routine)
+    {
+        int start = e.hoursStart * 60 + e.minutesStart;
+        int end = e.hoursEnd * 60 + e.minutesEnd;
+
+        for (int boundary : {start, start + 1, end, end + 1})
+        {
+            int delta = ((boundary - minuteOfDay) % MINUTES_PER_DAY + MINUTES_PER_DAY) % MINUTES_PER_DAY;
+
+            if (delta > 0)
+                next = std::min(next, delta);
+        }
+    }
+
+    m_World.getRoutineScheduler().schedule(m_HostVob, now + next, m_Routine.scheduleGeneration);
 }
 
 void NpcScriptState::setCurrentStateTime(float time)
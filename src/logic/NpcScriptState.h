@@ -127,6 +127,17 @@ namespace Logic
          */
         void clearRoutine();
 
+        /**
+         * Called by the NpcRoutineScheduler once the routine may have to change. Selects the routine-entry
+         * matching the current time and schedules the next check.
+         */
+        void onRoutineWake();
+
+        /**
+         * @return Generation of the last routine-check scheduled, see NpcRoutineScheduler::schedule()
+         */
+        uint32_t getRoutineScheduleGeneration() const { return m_Routine.scheduleGeneration; }
+
         /**
          * Checks whether this NPC is currently in the state with stateMainSymbol as starting function
          * @param stateMainSymbol Starting function of the state to check
@@ -277,6 +288,12 @@ namespace Logic
             bool isOverlay;
         };
 
+        /**
+         * Outdates all pending routine-checks and schedules a new one
+         * @param immediately Whether to check on the next frame, rather than at the next start or end of a routine-entry
+         */
+        void scheduleRoutineCheck(bool immediately);
+
         struct
         {
             /**
@@ -290,6 +307,11 @@ namespace Logic
              */
             bool startNewRoutine;
             bool hasRoutine;
+
+            /**
+             * Increased whenever a routine-check is scheduled, to outdate the ones still pending
+             */
+            uint32_t scheduleGeneration;
         } m_Routine;
     };
 }
\ No newline at end of file
@@ -0,0 +1,385 @@
+#include "PerceptionSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <bx/timer.h>
+#include <components/VobClasses.h>
+#include <daedalus/DaedalusVM.h>
+#include <engine/World.h>
+#include <logic/PlayerController.h>
+#include <logic/ScriptEngine.h>
+#include <physics/PhysicsSystem.h>
+#include <utils/logger.h>
+
+using namespace Logic;
+
+namespace
+{
+    /**
+     * Value of ATT_HOSTILE in case the scripts don't define it
+     */
+    const int32_t DEFAULT_ATT_HOSTILE = 1;
+
+    /**
+     * Active perceptions in the order they are checked
+     */
+    const int32_t ACTIVE_PERCEPTIONS[] = {PERC_ASSESSPLAYER, PERC_ASSESSENEMY, PERC_ASSESSBODY};
+    const size_t NUM_ACTIVE_PERCEPTIONS = sizeof(ACTIVE_PERCEPTIONS) / sizeof(ACTIVE_PERCEPTIONS[0]);
+}
+
+PerceptionSystem::PerceptionSystem(World::WorldInstance& world)
+    : m_World(world)
+    , m_Enabled(true)
+    , m_TimeSinceTick(0.0f)
+    , m_GridCellSize(1.0f)
+    , m_SymGuildAttitudes(ScriptEngine::INVALID_SYMBOL)
+    , m_NumGuilds(0)
+    , m_AttHostile(DEFAULT_ATT_HOSTILE)
+{
+}
+
+void PerceptionSystem::setRange(int32_t perception, float range)
+{
+    m_Ranges[perception] = range;
+}
+
+float PerceptionSystem::getRange(int32_t perception) const
+{
+    auto it = m_Ranges.find(perception);
+    return it != m_Ranges.end() ? it->second : 0.0f;
+}
+
+void PerceptionSystem::sendPassivePerception(Handle::EntityHandle source,
+                                             int32_t perception,
+                                             Daedalus::GameState::NpcHandle other,
+                                             Daedalus::GameState::NpcHandle victim)
+{
+    m_Queue.push_back({source, perception, other, victim, true});
+}
+
+void PerceptionSystem::sendSinglePerception(Handle::EntityHandle target, int32_t perception, Daedalus::GameState::NpcHandle other)
+{
+    m_Queue.push_back({target, perception, other, Daedalus::GameState::NpcHandle(), false});
+}
+
+void PerceptionSystem::update(double deltaTime)
+{
+    m_TimeSinceTick += static_cast<float>(deltaTime);
+
+    if (m_TimeSinceTick < m_Config.tickInterval)
+        return;
+
+    float elapsed = m_TimeSinceTick;
+    m_TimeSinceTick = 0.0f;
+
+    if (!m_Enabled)
+    {
+        m_Queue.clear();
+        return;
+    }
+
+    tick(elapsed);
+}
+
+void PerceptionSystem::tick(float deltaTime)
+{
+    int64_t start = bx::getHPCounter();
+
+    Stats stats;
+    ScriptEngine& s = m_World.getScriptEngine();
+    Handle::EntityHandle playerEntity = s.getPlayerEntity();
+
+    // Look at the attitude-matrix once, so the checks between pairs of NPCs only have to index into it
+    {
+        Daedalus::DATFile& dat = s.getVM().getDATFile();
+        const ScriptEngine::CommonSymbols& syms = s.getCommonSymbols();
+
+        m_SymGuildAttitudes = syms.guildAttitudes;
+        m_NumGuilds = 0;
+        if (m_SymGuildAttitudes != ScriptEngine::INVALID_SYMBOL)
+        {
+            // The matrix is square, GIL_ATTITUDES[GIL_MAX * GIL_MAX]
+            uint32_t count = dat.getSymbolByIndex(m_SymGuildAttitudes).properties.elemProps.count;
+            m_NumGuilds = static_cast<int32_t>(std::sqrt(static_cast<double>(count)));
+        }
+
+        m_AttHostile = syms.attHostile != ScriptEngine::INVALID_SYMBOL ? dat.getSymbolByIndex(syms.attHostile).getInt()
+                                                                       : DEFAULT_ATT_HOSTILE;
+    }
+
+    // Take a snapshot of all NPCs. Scripts called below may move or kill them, but that will only be seen next tick.
+    m_Records.clear();
+    std::vector<uint32_t> perceivers;
+    for (Handle::EntityHandle e : s.getWorldNPCs())
+    {
+        VobTypes::NpcVobInformation npc = VobTypes::asNpcVob(m_World, e);
+        if (!npc.isValid())
+            continue;
+
+        NpcRecord r;
+        r.entity = e;
+        r.position = npc.playerController->getEntityTransform().Translation();
+        r.eyePosition = npc.playerController->getEyePosition();
+        r.guild = npc.playerController->getScriptInstance().guild;
+        r.isDead = npc.playerController->getBodyState() == BS_DEAD;
+        r.isPlayer = e == playerEntity;
+
+        m_Records.push_back(r);
+
+        if (r.isDead || npc.playerController->isPlayerControlled())
+            continue;
+
+        NpcPerceptions& p = npc.playerController->getPerceptions();
+
+        bool hasActive = false;
+        for (int32_t perc : ACTIVE_PERCEPTIONS)
+            hasActive = hasActive || p.functions.count(perc) != 0;
+
+        if (!hasActive)
+            continue;
+
+        p.timeLeft -= deltaTime;
+        if (p.timeLeft > 0.0f)
+            continue;
+
+        p.timeLeft = p.interval;
+        perceivers.push_back(static_cast<uint32_t>(m_Records.size() - 1));
+    }
+
+    stats.numPerceivers = static_cast<uint32_t>(perceivers.size());
+
+    float maxRange = 0.0f;
+    for (int32_t perc : ACTIVE_PERCEPTIONS)
+        maxRange = std::max(maxRange, getRange(perc));
+
+    /**
+     * Candidate for an active perception, waiting for its line of sight to be resolved
+     */
+    struct Candidate
+    {
+        uint32_t perceiver;
+        uint32_t other;
+        size_t perception;
+        float distance2;
+        size_t ray;
+    };
+
+    std::vector<Candidate> candidates;
+    std::vector<std::pair<Math::float3, Math::float3>> rays;
+
+    if (!perceivers.empty() && maxRange > 0.0f)
+    {
+        buildGrid(maxRange);
+
+        float ranges2[NUM_ACTIVE_PERCEPTIONS];
+        for (size_t i = 0; i < NUM_ACTIVE_PERCEPTIONS; i++)
+            ranges2[i] = getRange(ACTIVE_PERCEPTIONS[i]) * getRange(ACTIVE_PERCEPTIONS[i]);
+
+        // Rays are shared between the perceptions of a single pair
+        std::map<uint32_t, size_t> rayByOther;
+
+        for (uint32_t pi : perceivers)
+        {
+            const NpcRecord& perceiver = m_Records[pi];
+            VobTypes::NpcVobInformation npc = VobTypes::asNpcVob(m_World, perceiver.entity);
+            const NpcPerceptions& p = npc.playerController->getPerceptions();
+
+            rayByOther.clear();
+            forEachNeighbour(perceiver.position, [&](uint32_t oi) {
+                if (oi == pi)
+                    return;
+
+                stats.numPairsTested++;
+
+                const NpcRecord& other = m_Records[oi];
+                float distance2 = (other.position - perceiver.position).lengthSquared();
+
+                for (size_t i = 0; i < NUM_ACTIVE_PERCEPTIONS; i++)
+                {
+                    int32_t perc = ACTIVE_PERCEPTIONS[i];
+
+                    if (distance2 > ranges2[i] || !p.functions.count(perc))
+                        continue;
+
+                    if (!matchesActivePerception(perc, perceiver, other))
+                        continue;
+
+                    // Same field of view as PlayerController::canSee
+                    if (npc.playerController->getAngleTo(other.position) > 0.5f * Math::PI)
+                        continue;
+
+                    stats.numPairsInRange++;
+
+                    auto it = rayByOther.find(oi);
+                    if (it == rayByOther.end())
+                    {
+                        it = rayByOther.emplace(oi, rays.size()).first;
+                        rays.emplace_back(perceiver.eyePosition, other.eyePosition);
+                    }
+
+                    candidates.push_back({pi, oi, i, distance2, it->second});
+                }
+            });
+        }
+    }
+
+    // Resolve line of sight of all candidates at once
+    std::vector<uint8_t> occluded;
+    if (!rays.empty())
+        m_World.getPhysicsSystem().raytraceOcclusion(rays, occluded, Physics::CollisionShape::CT_WorldMesh);
+
+    stats.numRaysCast = static_cast<uint32_t>(rays.size());
+
+    // Every perceiver perceives the nearest visible candidate of each type
+    std::map<std::pair<uint32_t, size_t>, const Candidate*> nearest;
+    for (const Candidate& c : candidates)
+    {
+        if (occluded[c.ray])
+            continue;
+
+        const Candidate*& n = nearest[std::make_pair(c.perceiver, c.perception)];
+        if (!n || c.distance2 < n->distance2)
+            n = &c;
+    }
+
+    for (const auto& n : nearest)
+    {
+        const Candidate& c = *n.second;
+        VobTypes::NpcVobInformation other = VobTypes::asNpcVob(m_World, m_Records[c.other].entity);
+        if (!other.isValid())
+            continue;
+
+        if (dispatch(m_Records[c.perceiver].entity, ACTIVE_PERCEPTIONS[c.perception],
+                     VobTypes::getScriptHandle(other), Daedalus::GameState::NpcHandle()))
+            stats.numDispatched++;
+    }
+
+    // Hand out what the scripts have sent since the last tick. Scripts run here may queue more, those wait for the next tick.
+    std::vector<QueuedPerception> queue;
+    queue.swap(m_Queue);
+
+    for (const QueuedPerception& q : queue)
+    {
+        if (!q.isPassive)
+        {
+            if (dispatch(q.entity, q.perception, q.other, q.victim))
+                stats.numDispatched++;
+
+            continue;
+        }
+
+        float range = getRange(q.perception);
+        if (range <= 0.0f)
+            continue;
+
+        VobTypes::NpcVobInformation source = VobTypes::asNpcVob(m_World, q.entity);
+        if (!source.isValid())
+            continue;
+
+        Math::float3 sourcePosition = source.playerController->getEntityTransform().Translation();
+        for (Handle::EntityHandle e : s.getNPCsInRadius(sourcePosition, range))
+        {
+            if (e == q.entity)
+                continue;
+
+            if (dispatch(e, q.perception, q.other, q.victim))
+                stats.numDispatched++;
+        }
+    }
+
+    stats.timeMs = static_cast<float>(double(bx::getHPCounter() - start) * 1000.0 / double(bx::getHPFrequency()));
+    m_LastTickStats = stats;
+}
+
+void PerceptionSystem::buildGrid(float cellSize)
+{
+    m_Grid.clear();
+    m_GridCellSize = cellSize;
+
+    for (uint32_t i = 0; i < m_Records.size(); i++)
+    {
+        const Math::float3& p = m_Records[i].position;
+        auto cell = std::make_pair(static_cast<int32_t>(std::floor(p.x / cellSize)),
+                                   static_cast<int32_t>(std::floor(p.z / cellSize)));
+
+        m_Grid[cell].push_back(i);
+    }
+}
+
+template <typename F>
+void PerceptionSystem::forEachNeighbour(const Math::float3& position, F fn) const
+{
+    // Cells are as large as the largest range, so only the direct neighbours need to be checked
+    int32_t cx = static_cast<int32_t>(std::floor(position.x / m_GridCellSize));
+    int32_t cz = static_cast<int32_t>(std::floor(position.z / m_GridCellSize));
+
+    for (int32_t x = cx - 1; x <= cx + 1; x++)
+    {
+        for (int32_t z = cz - 1; z <= cz + 1; z++)
+        {
+            auto it = m_Grid.find(std::make_pair(x, z));
+            if (it == m_Grid.end())
+                continue;
+
+            for (uint32_t i : it->second)
+                fn(i);
+        }
+    }
+}
+
+bool PerceptionSystem::matchesActivePerception(int32_t perception, const NpcRecord& perceiver, const NpcRecord& other) const
+{
+    switch (perception)
+    {
+        case PERC_ASSESSPLAYER:
+            return other.isPlayer;
+
+        case PERC_ASSESSBODY:
+            return other.isDead;
+
+        case PERC_ASSESSENEMY:
+        {
+            if (other.isDead)
+                return false;
+
+            if (perceiver.guild < 0 || perceiver.guild >= m_NumGuilds || other.guild < 0 || other.guild >= m_NumGuilds)
+                return false;
+
+            Daedalus::DATFile& dat = m_World.getScriptEngine().getVM().getDATFile();
+
+            // The perceiver is the aggressor here, see wld_getguildattitude
+            return dat.getSymbolByIndex(m_SymGuildAttitudes).getInt(perceiver.guild * m_NumGuilds + other.guild) == m_AttHostile;
+        }
+
+        default:
+            return false;
+    }
+}
+
+bool PerceptionSystem::dispatch(Handle::EntityHandle npc,
+                                int32_t perception,
+                                Daedalus::GameState::NpcHandle other,
+                                Daedalus::GameState::NpcHandle victim)
+{
+    VobTypes::NpcVobInformation vob = VobTypes::asNpcVob(m_World, npc);
+    if (!vob.isValid())
+        return false;
+
+    const NpcPerceptions& p = vob.playerController->getPerceptions();
+    auto it = p.functions.find(perception);
+    if (it == p.functions.end())
+        return false;
+
+    ScriptEngine& s = m_World.getScriptEngine();
+    const ScriptEngine::CommonSymbols& syms = s.getCommonSymbols();
+
+    s.prepareRunFunction();
+    s.setInstanceNPC(syms.self, VobTypes::getScriptHandle(vob));
+    s.setInstanceNPC(syms.other, other);
+    s.setInstanceNPC(syms.victim, victim);
+
+    ScriptProfiler::Scope profile(s.getProfiler(), ScriptProfiler::EKind::Perception,
+                                  it->second, VobTypes::getScriptObject(vob).instanceSymbol);
+
+    s.runFunctionBySymIndex(it->second);
+    return true;
+}
@@ -0,0 +1,230 @@
+#pragma once
+#include <cstdint>
+#include <map>
+#include <vector>
+#include <daedalus/DaedalusGameState.h>
+#include <handle/HandleDef.h>
+#include <math/mathlib.h>
+
+namespace World
+{
+    class WorldInstance;
+}
+
+namespace Logic
+{
+    /**
+     * Perception-types the engine generates by itself. Values are fixed by the original engine.
+     */
+    enum EPerception : int32_t
+    {
+        PERC_ASSESSPLAYER = 1,
+        PERC_ASSESSENEMY = 2,
+        PERC_ASSESSBODY = 4
+    };
+
+    /**
+     * Perception-settings of a single NPC, as set by the scripts
+     */
+    struct NpcPerceptions
+    {
+        /**
+         * Default interval of active perceptions, set whenever a new AI-state starts
+         */
+        static constexpr float DEFAULT_INTERVAL = 5.0f;
+
+        /**
+         * Script-function to call for each enabled perception-type
+         */
+        std::map<int32_t, size_t> functions;
+
+        /**
+         * Time in seconds between two checks for active perceptions
+         */
+        float interval = DEFAULT_INTERVAL;
+
+        /**
+         * Time left until the next check for active perceptions
+         */
+        float timeLeft = 0.0f;
+    };
+
+    /**
+     * Generates perceptions for all NPCs of a world and calls the script-functions registered for them.
+     *
+     * Work is done on a fixed tick rather than every frame. Each tick, the NPCs which are due for their
+     * active perceptions (seeing the player, enemies or bodies) are matched against their neighbours
+     * using a grid. Candidates within the ranges set by the scripts have their line of sight resolved
+     * together, in one batch of occlusion-tests. Passive perceptions (sounds, fights) and single
+     * perceptions sent by scripts are queued and handed out on the next tick.
+     */
+    class PerceptionSystem
+    {
+    public:
+        struct Config
+        {
+            /**
+             * Time in seconds between two ticks
+             */
+            float tickInterval = 0.2f;
+        };
+
+        struct Stats
+        {
+            // NPCs which were due for active perceptions
+            uint32_t numPerceivers = 0;
+
+            // NPC-pairs taken from the grid
+            uint32_t numPairsTested = 0;
+
+            // Pairs which were in range of a perception
+            uint32_t numPairsInRange = 0;
+
+            // Occlusion-tests done for those pairs
+            uint32_t numRaysCast = 0;
+
+            // Script-functions called
+            uint32_t numDispatched = 0;
+
+            // Time spent for the whole tick
+            float timeMs = 0.0f;
+        };
+
+        PerceptionSystem(World::WorldInstance& world);
+
+        /**
+         * Whether perceptions should be generated at all
+         */
+        void setEnabled(bool enabled) { m_Enabled = enabled; }
+        bool isEnabled() const { return m_Enabled; }
+
+        Config& getConfig() { return m_Config; }
+
+        /**
+         * Sets the range in which the given perception works
+         * @param range Range in meters
+         */
+        void setRange(int32_t perception, float range);
+
+        /**
+         * @return Range of the given perception in meters, 0 if not set
+         */
+        float getRange(int32_t perception) const;
+
+        /**
+         * Lets all NPCs in range of the given perception around the source perceive it, on the next tick
+         * @param source NPC sending the perception
+         * @param other NPC to be stored in "other" for the receivers
+         * @param victim NPC to be stored in "victim" for the receivers
+         */
+        void sendPassivePerception(Handle::EntityHandle source,
+                                   int32_t perception,
+                                   Daedalus::GameState::NpcHandle other,
+                                   Daedalus::GameState::NpcHandle victim);
+
+        /**
+         * Lets the target perceive the given perception on the next tick, regardless of range
+         * @param other NPC to be stored in "other" for the target
+         */
+        void sendSinglePerception(Handle::EntityHandle target, int32_t perception, Daedalus::GameState::NpcHandle other);
+
+        /**
+         * Advances the tick-timer and runs a tick, if due
+         * @param deltaTime Time since the last frame
+         */
+        void update(double deltaTime);
+
+        /**
+         * @return Statistics of the last tick
+         */
+        const Stats& getLastTickStats() const { return m_LastTickStats; }
+
+    private:
+        /**
+         * State of an NPC as seen by a single tick
+         */
+        struct NpcRecord
+        {
+            Handle::EntityHandle entity;
+            Math::float3 position;
+            Math::float3 eyePosition;
+            int32_t guild;
+            bool isDead;
+            bool isPlayer;
+        };
+
+        struct QueuedPerception
+        {
+            Handle::EntityHandle entity;
+            int32_t perception;
+            Daedalus::GameState::NpcHandle other;
+            Daedalus::GameState::NpcHandle victim;
+            bool isPassive;
+        };
+
+        /**
+         * Collects the NPCs and runs all perceptions
+         */
+        void tick(float deltaTime);
+
+        /**
+         * Puts the records into a grid with the given cell-size
+         */
+        void buildGrid(float cellSize);
+
+        /**
+         * Calls fn(index) for every record in the cells around the given position
+         */
+        template <typename F>
+        void forEachNeighbour(const Math::float3& position, F fn) const;
+
+        /**
+         * Checks whether the perceiver would perceive other as the given active perception, ignoring range and sight
+         */
+        bool matchesActivePerception(int32_t perception, const NpcRecord& perceiver, const NpcRecord& other) const;
+
+        /**
+         * Calls the script-function the NPC has registered for the given perception, if any
+         */
+        bool dispatch(Handle::EntityHandle npc,
+                      int32_t perception,
+                      Daedalus::GameState::NpcHandle other,
+                      Daedalus::GameState::NpcHandle victim);
+
+        World::WorldInstance& m_World;
+        bool m_Enabled;
+        Config m_Config;
+
+        /**
+         * Ranges in meters, by perception-type
+         */
+        std::map<int32_t, float> m_Ranges;
+
+        /**
+         * Perceptions sent by scripts since the last tick
+         */
+        std::vector<QueuedPerception> m_Queue;
+
+        /**
+         * Time since the last tick
+         */
+        float m_TimeSinceTick;
+
+        /**
+         * Working data of the current tick
+         */
+        std::vector<NpcRecord> m_Records;
+        std::map<std::pair<int32_t, int32_t>, std::vector<uint32_t>> m_Grid;
+        float m_GridCellSize;
+
+        /**
+         * Guild-attitude matrix of the scripts, resolved at the start of every tick. No guild is valid if the
+         * scripts don't have one.
+         */
+        size_t m_SymGuildAttitudes;
+        int32_t m_NumGuilds;
+        int32_t m_AttHostile;
+
+        Stats m_LastTickStats;
+    };
+}
@@ -21,6 +21,7 @@
 #include <engine/WorldMesh.h>
 #include <entry/input.h>
 #include <logic/DialogManager.h>
+#include <logic/NpcAIScheduler.h>
 #include <logic/PfxManager.h>
 #include <logic/SavegameManager.h>
 #include <logic/ScriptEngine.h>
@@ -103,6 +104,8 @@ PlayerController::PlayerController(World::WorldInstance& world,
     m_EquipmentState.activeWeapon.invalidate();
 
     m_RefuseTalkTime = 0;
+    m_TimeSinceAITick = 0;
+    m_LastGroundTracePosition = Math::float3(0, 0, 0);
 
     m_LastAniRootPosUpdatedAniHash = 0;
     m_NoAniRootPosHack = false;
@@ -112,16 +115,32 @@ PlayerController::PlayerController(World::WorldInstance& world,
 
 void PlayerController::onUpdate(float deltaTime)
 {
-    // If anything wants this to be modified, it as to keep it up to date
-    // It is important that the update-method is called last in this update-handler
-    m_AIHandler.setTargetMovementState(EMovementState::None);
+    // Background NPCs don't need their AI ticked every frame, they will get all the time passed since then
+    // once they are ticked again
+    m_TimeSinceAITick += deltaTime;
 
-    m_RefuseTalkTime -= deltaTime;
+    NpcAIScheduler& scheduler = m_World.getAIScheduler();
+    bool tickAI = isPlayerControlled() || scheduler.shouldTick(m_MoveState.position, !getEM().isEmpty(), m_TimeSinceAITick);
 
-    m_AIStateMachine.doAIState(deltaTime);
+    // Covers the movement-update at the end of this method as well
+    NpcAIScheduler::TickScope tickScope(scheduler, tickAI);
+    float aiDeltaTime = m_TimeSinceAITick;
 
-    // This vob should react to messages
-    getEM().processMessageQueue();
+    if (tickAI)
+    {
+        m_TimeSinceAITick = 0.0f;
+
+        // If anything wants this to be modified, it as to keep it up to date
+        // It is important that the update-method is called last in this update-handler
+        m_AIHandler.setTargetMovementState(EMovementState::None);
+
+        m_RefuseTalkTime -= aiDeltaTime;
+
+        m_AIStateMachine.doAIState(aiDeltaTime);
+
+        // This vob should react to messages
+        getEM().processMessageQueue();
+    }
 
     ModelVisual* model = getModelVisual();
 
@@ -138,8 +157,13 @@ void PlayerController::onUpdate(float deltaTime)
         // Update model for this frame
         model->onFrameUpdate(deltaTime);
 
-        // Retrieve data of the ground on which the NPC is standing
-        traceDownNPCGround();
+        // Retrieve data of the ground on which the NPC is standing. Only needs to be redone if something could have changed.
+        if (tickAI || !m_MoveState.ground.successful
+            || (m_MoveState.position - m_LastGroundTracePosition).lengthSquared() > 0.0001f)
+        {
+            traceDownNPCGround();
+            m_LastGroundTracePosition = m_MoveState.position;
+        }
 
         // Needs to be done here to account for changes of feet-height
         placeOnGround();
@@ -178,9 +202,9 @@ void PlayerController::onUpdate(float deltaTime)
     {
         onUpdateForPlayer(deltaTime);
     }
-    else
+    else if (tickAI)
     {
-        m_AIHandler.npcUpdate(deltaTime);
+        m_AIHandler.npcUpdate(aiDeltaTime);
     }
 }
 
@@ -430,7 +454,7 @@ void PlayerController::placeOnGround()
     Math::float3 to = entityPosition + Math::float3(0.0f, -100.0f, 0.0f);
     Math::float3 from = entityPosition + Math::float3(0.0f, 30.0f, 0.0f);
 
-    std::vector<Physics::RayTestResult> hitall = m_World.getPhysicsSystem().raytraceAll(from, to);
+    Memory::FrameVector<Physics::RayTestResult> hitall = m_World.getPhysicsSystem().raytraceAll(from, to);
     if (hitall.empty())
         return;
     std::sort(hitall.begin(), hitall.end(), [](const Physics::RayTestResult& a, const Physics::RayTestResult& b) {
@@ -574,34 +598,34 @@ void PlayerController::onMessage(SharedEMessage message, Handle::EntityHandle so
             done = EV_Event(message, sourceVob);
             break;
         case EventMessages::EventMessageType::Npc:
-            done = EV_Npc(std::dynamic_pointer_cast<EventMessages::NpcMessage>(message), sourceVob);
+            done = EV_Npc(std::static_pointer_cast<EventMessages::NpcMessage>(message), sourceVob);
             break;
         case EventMessages::EventMessageType::Damage:
-            done = EV_Damage(std::dynamic_pointer_cast<EventMessages::DamageMessage>(message), sourceVob);
+            done = EV_Damage(std::static_pointer_cast<EventMessages::DamageMessage>(message), sourceVob);
             break;
         case EventMessages::EventMessageType::Weapon:
-            done = EV_Weapon(std::dynamic_pointer_cast<EventMessages::WeaponMessage>(message), sourceVob);
+            done = EV_Weapon(std::static_pointer_cast<EventMessages::WeaponMessage>(message), sourceVob);
             break;
         case EventMessages::EventMessageType::Movement:
-            done = EV_Movement(std::dynamic_pointer_cast<EventMessages::MovementMessage>(message), sourceVob);
+            done = EV_Movement(std::static_pointer_cast<EventMessages::MovementMessage>(message), sourceVob);
             break;
         case EventMessages::EventMessageType::Attack:
-            done = EV_Attack(std::dynamic_pointer_cast<EventMessages::AttackMessage>(message), sourceVob);
+            done = EV_Attack(std::static_pointer_cast<EventMessages::AttackMessage>(message), sourceVob);
             break;
         case EventMessages::EventMessageType::UseItem:
-            done = EV_UseItem(std::dynamic_pointer_cast<EventMessages::UseItemMessage>(message), sourceVob);
+            done = EV_UseItem(std::static_pointer_cast<EventMessages::UseItemMessage>(message), sourceVob);
             break;
         case EventMessages::EventMessageType::State:
-            done = EV_State(std::dynamic_pointer_cast<EventMessages::StateMessage>(message), sourceVob);
+            done = EV_State(std::static_pointer_cast<EventMessages::StateMessage>(message), sourceVob);
             break;
         case EventMessages::EventMessageType::Manipulate:
-            done = EV_Manipulate(std::dynamic_pointer_cast<EventMessages::ManipulateMessage>(message), sourceVob);
+            done = EV_Manipulate(std::static_pointer_cast<EventMessages::ManipulateMessage>(message), sourceVob);
             break;
         case EventMessages::EventMessageType::Conversation:
-            done = EV_Conversation(std::dynamic_pointer_cast<EventMessages::ConversationMessage>(message), sourceVob);
+            done = EV_Conversation(std::static_pointer_cast<EventMessages::ConversationMessage>(message), sourceVob);
             break;
         case EventMessages::EventMessageType::Magic:
-            done = EV_Magic(std::dynamic_pointer_cast<EventMessages::MagicMessage>(message), sourceVob);
+            done = EV_Magic(std::static_pointer_cast<EventMessages::MagicMessage>(message), sourceVob);
             break;
         case EventMessages::EventMessageType::Mob:
             //TODO handle this somehow?
@@ -826,9 +850,10 @@ bool PlayerController::EV_State(std::shared_ptr<EventMessages::StateMessage> sha
             }
 
             // Set up script instances. // TODO: Self is originally not set by gothic here! Why?
-            m_World.getScriptEngine().setInstance("self", getScriptInstance().instanceSymbol);
-            m_World.getScriptEngine().setInstanceNPC("other", message.other);
-            m_World.getScriptEngine().setInstanceNPC("victim", message.victim);
+            const ScriptEngine::CommonSymbols& syms = m_World.getScriptEngine().getCommonSymbols();
+            m_World.getScriptEngine().setInstance(syms.self, getScriptInstance().instanceSymbol);
+            m_World.getScriptEngine().setInstanceNPC(syms.other, message.other);
+            m_World.getScriptEngine().setInstanceNPC(syms.victim, message.victim);
 
             getEM().clear();
 
@@ -1176,6 +1201,12 @@ void PlayerController::interrupt()
     getEM().clear();
 }
 
+Math::float3 PlayerController::getEyePosition()
+{
+    // Top of our BBox
+    return getEntityTransform().Translation() + Math::float3(0.0f, m_NPCProperties.collisionBBox[1].y, 0.0f);
+}
+
 bool PlayerController::canSee(Handle::EntityHandle entity, bool ignoreAngles)
 {
     const float MAX_ANGLE = 0.5f * Math::PI;  // 90 degrees
@@ -1183,7 +1214,7 @@ bool PlayerController::canSee(Handle::EntityHandle entity, bool ignoreAngles)
     Components::PositionComponent& otherPos = m_World.getEntity<Components::PositionComponent>(entity);
 
     // Trace from the top of our BBox (eyes)
-    Math::float3 start = getEntityTransform().Translation() + Math::float3(0.0f, m_NPCProperties.collisionBBox[1].y, 0.0f);
+    Math::float3 start = getEyePosition();
 
     Math::float3 end = otherPos.m_WorldMatrix.Translation();
 
@@ -1215,7 +1246,7 @@ bool PlayerController::canSee(Handle::EntityHandle entity, bool ignoreAngles)
 bool PlayerController::freeLineOfSight(const Math::float3& target)
 {
     // Trace from the top of our BBox (eyes)
-    Math::float3 start = getEntityTransform().Translation() + Math::float3(0.0f, m_NPCProperties.collisionBBox[1].y, 0.0f);
+    Math::float3 start = getEyePosition();
 
     // Do the raytest to the other object
     Physics::RayTestResult res = m_World.getPhysicsSystem().raytrace(
@@ -1263,8 +1294,9 @@ void PlayerController::changeRoutine(const std::string& routineName)
     // Build new name for the routine
     std::string namecomp = "RTN_" + routineName + "_" + std::to_string(getScriptInstance().id);
 
-    if (m_World.getScriptEngine().hasSymbol(namecomp))
-        setRoutineFunc(m_World.getScriptEngine().getSymbolIndexByName(namecomp));
+    size_t symRoutine = m_World.getScriptEngine().getSymbolIndexByName(namecomp);
+    if (symRoutine != ScriptEngine::INVALID_SYMBOL)
+        setRoutineFunc(symRoutine);
     else
         LogWarn() << "Could not find routine " << namecomp << " on NPC: " << getScriptInstance().name[0];
 }
@@ -1301,7 +1333,7 @@ bool PlayerController::useItem(Daedalus::GameState::ItemHandle item)
     // Call script function to be executed on use
     if (data.on_state[0])
     {
-        m_World.getScriptEngine().setInstanceNPC("self", getScriptHandle());
+        m_World.getScriptEngine().setInstanceNPC(m_World.getScriptEngine().getCommonSymbols().self, getScriptHandle());
         m_World.getScriptEngine().prepareRunFunction();
         m_World.getScriptEngine().runFunctionBySymIndex(data.on_state[0]);
 
@@ -1334,8 +1366,8 @@ bool PlayerController::canUse(Daedalus::GameState::ItemHandle item)
             if (npc.attribute[data.cond_atr[i]] < data.cond_value[i])
             {
                 // Display messages, if this is the player and do debug-output
-                s.setInstanceNPC("self", getScriptHandle());
-                s.setInstanceItem("item", item);
+                s.setInstanceNPC(s.getCommonSymbols().self, getScriptHandle());
+                s.setInstanceItem(s.getCommonSymbols().item, item);
 
                 s.prepareRunFunction();
 
@@ -1559,6 +1591,9 @@ void PlayerController::importObject(const json& j, bool noTransform)
         scriptObj.lp = j["scriptObj"]["lp"];
     }
 
+    // The imported display-name may differ from the one given by the instance-constructor
+    m_World.getScriptEngine().updateNpcName(m_Entity);
+
     // Import inventory
     m_Inventory.importInventory(j["inventory"]);
 
@@ -1615,22 +1650,23 @@ void PlayerController::die(Handle::EntityHandle attackingNPC)
 
     if (!m_AIStateMachine.isInState(NPC_PRGAISTATE_DEAD))
     {
-        Daedalus::GameState::NpcHandle oldOther = m_World.getScriptEngine().getNPCFromSymbol("other");
+        const size_t symOther = m_World.getScriptEngine().getCommonSymbols().other;
+        Daedalus::GameState::NpcHandle oldOther = m_World.getScriptEngine().getNPCFromSymbol(symOther);
 
         if (attackingNPC.isValid())
         {
             VobTypes::NpcVobInformation attacker = VobTypes::asNpcVob(m_World, attackingNPC);
-            m_World.getScriptEngine().setInstanceNPC("other", VobTypes::getScriptHandle(attacker));
+            m_World.getScriptEngine().setInstanceNPC(symOther, VobTypes::getScriptHandle(attacker));
         }
         else
         {
-            m_World.getScriptEngine().setInstanceNPC("other", Daedalus::GameState::NpcHandle());
+            m_World.getScriptEngine().setInstanceNPC(symOther, Daedalus::GameState::NpcHandle());
         }
 
         m_AIStateMachine.startAIState(Logic::NPC_PRGAISTATE_DEAD, false, false, true);
 
         // Restore old other
-        m_World.getScriptEngine().setInstanceNPC("other", oldOther);
+        m_World.getScriptEngine().setInstanceNPC(symOther, oldOther);
     }
 
     setAttribute(Daedalus::GEngineClasses::C_Npc::EAttributes::EATR_HITPOINTS, 0);
@@ -1725,7 +1761,7 @@ void PlayerController::traceDownNPCGround()
     Math::float3 entityPos = to;
     to.y = -1000.0f;
     from.y = 10000.0f;
-    std::vector<Physics::RayTestResult> hitall = m_World.getPhysicsSystem().raytraceAll(from, to, Physics::CollisionShape::CT_WorldMesh);
+    Memory::FrameVector<Physics::RayTestResult> hitall = m_World.getPhysicsSystem().raytraceAll(from, to, Physics::CollisionShape::CT_WorldMesh);
     if (hitall.empty())
     {
         return;
@@ -2073,7 +2109,7 @@ void PlayerController::onAction(Engine::ActionType actionType, bool triggered, f
                     }
                 }
 
-                std::set<Handle::EntityHandle> nearNPCs = m_World.getScriptEngine().getNPCsInRadius(
+                Memory::FrameVector<Handle::EntityHandle> nearNPCs = m_World.getScriptEngine().getNPCsInRadius(
                     getEntityTransform().Translation(), 5.0f);
 
                 // Talk to the nearest NPC other than the current player, of course
@@ -2096,7 +2132,7 @@ void PlayerController::onAction(Engine::ActionType actionType, bool triggered, f
                     }
                 }
 
-                std::set<Handle::EntityHandle> mobs = m_World.getScriptEngine().getWorldMobs();
+                const std::set<Handle::EntityHandle>& mobs = m_World.getScriptEngine().getWorldMobs();
 
                 // Use the nearest mob
                 Handle::EntityHandle nearestMob;
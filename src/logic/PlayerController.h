@@ -7,6 +7,7 @@
 #include "NpcAIHandler.h"
 #include "NpcAnimationHandler.h"
 #include "NpcScriptState.h"
+#include "PerceptionSystem.h"
 #include "Pathfinder.h"
 #include "CharacterEquipment.h"
 #include <daedalus/DaedalusGameState.h>
@@ -316,6 +317,16 @@ namespace Logic
          */
         float getAngleTo(const Math::float3& pos);
 
+        /**
+         * @return Position of the NPCs eyes in world-space, where line of sight is traced from
+         */
+        Math::float3 getEyePosition();
+
+        /**
+         * @return Perceptions the scripts have enabled for this NPC
+         */
+        NpcPerceptions& getPerceptions() { return m_Perceptions; }
+
         /**
          * Lets the NPC stop all it's actions
          * @param walkingAllowed Whether walking should be allowed and not be stopped
@@ -528,6 +539,21 @@ namespace Logic
          */
         float m_RefuseTalkTime;
 
+        /**
+         * Time passed since the AI of this NPC has last been ticked, see NpcAIScheduler
+         */
+        float m_TimeSinceAITick;
+
+        /**
+         * Perceptions enabled by the scripts, see PerceptionSystem
+         */
+        NpcPerceptions m_Perceptions;
+
+        /**
+         * Position the ground below this NPC has last been traced at
+         */
+        Math::float3 m_LastGroundTracePosition;
+
         /**
          * Key states
          */
@@ -1,10 +1,17 @@
 #include "SavegameManager.h"
+#include <cstdio>
 #include <fstream>
+#include <future>
+#include <mutex>
 #include "engine/GameEngine.h"
 #include "ui/Hud.h"
 #include "ui/LoadingScreen.h"
+#include <bx/timer.h>
 #include <json/json.hpp>
+#include <utils/FrameProfiler.h>
+#include <utils/JsonBinary.h>
 #include <utils/Utils.h>
+#include <utils/EngineLog.h>
 #include <utils/logger.h>
 #include <logic/ScriptEngine.h>
 #include <logic/DialogManager.h>
@@ -17,6 +24,42 @@ using namespace Engine;
  */
 Engine::GameEngine* gameEngine;
 
+/**
+ * Save currently being written in the background, see saveToSlot(). Guarded by the mutex, as files are
+ * also read by the threads loading worlds.
+ */
+static std::shared_future<void> pendingSave;
+static std::mutex pendingSaveMutex;
+
+static std::shared_future<void> getPendingSave()
+{
+    std::lock_guard<std::mutex> guard(pendingSaveMutex);
+    return pendingSave;
+}
+
+namespace
+{
+    struct SaveFile
+    {
+        std::string relativePath;
+        json data;
+
+        // If not empty, the data is still encoded with Utils::JsonBinary and decoded by the writer
+        std::vector<uint8_t> packedData;
+    };
+
+    /**
+     * Everything going into a savegame, taken from the game-state at once
+     */
+    struct SavegameSnapshot
+    {
+        int slot;
+        std::string slotPath;
+        SavegameManager::SavegameInfo info;
+        std::vector<SaveFile> files;
+    };
+}
+
 // Enures that all folders to save into the given savegame-slot exist
 void ensureSavegameFolders(int idx)
 {
@@ -57,6 +100,15 @@ std::vector<std::string> SavegameManager::getSavegameWorlds(int idx)
     return worlds;
 }
 
+/**
+ * @return Whether the given file inside a savegame-folder was written by REGoth
+ */
+static bool isSaveFile(const std::string& name)
+{
+    return Utils::endsWith(name, ".json") &&
+           (Utils::startsWith(name, "regoth_") || Utils::startsWith(name, "world_") || Utils::startsWith(name, "player") || Utils::startsWith(name, "dialogmanager") || Utils::startsWith(name, "logmanager") || Utils::startsWith(name, "scriptengine"));
+}
+
 void SavegameManager::clearSavegame(int idx)
 {
     if (!isSavegameAvailable(idx))
@@ -64,10 +116,7 @@ void SavegameManager::clearSavegame(int idx)
 
     Utils::forEachFile(buildSavegamePath(idx), [](const std::string& path, const std::string& name, const std::string& ext) {
         // Make sure this is a REGoth-file
-        bool isRegothFile = Utils::endsWith(name, ".json") &&
-                            (Utils::startsWith(name, "regoth_") || Utils::startsWith(name, "world_") || Utils::startsWith(name, "player") || Utils::startsWith(name, "dialogmanager") || Utils::startsWith(name, "scriptengine"));
-
-        if (!isRegothFile)
+        if (!isSaveFile(name))
             return;  // Better not touch that one
 
         // Empty the file
@@ -89,19 +138,26 @@ bool SavegameManager::isSavegameAvailable(int idx)
     return Utils::getFileSize(buildSavegamePath(idx) + "/regoth_save.json") > 0;
 }
 
-bool SavegameManager::writeSavegameInfo(int idx, const SavegameInfo& info)
+static json savegameInfoToJson(const SavegameManager::SavegameInfo& info)
 {
-    std::string infoFile = buildSavegamePath(idx) + "/regoth_save.json";
-
-    ensureSavegameFolders(idx);
-
     json j;
     j["version"] = info.LATEST_KNOWN_VERSION;
     j["name"] = info.name;
     j["world"] = info.world;
     j["timePlayed"] = info.timePlayed;
 
-    LogInfo() << "Writing savegame-info: " << infoFile;
+    return j;
+}
+
+bool SavegameManager::writeSavegameInfo(int idx, const SavegameInfo& info)
+{
+    std::string infoFile = buildSavegamePath(idx) + "/regoth_save.json";
+
+    ensureSavegameFolders(idx);
+
+    json j = savegameInfoToJson(info);
+
+    RE_LOG_DEBUG(Savegame) << "Writing savegame-info: " << infoFile;
 
     // Save
     std::ofstream f(infoFile);
@@ -125,7 +181,7 @@ Engine::SavegameManager::SavegameInfo SavegameManager::readSavegameInfo(int idx)
     if (!Utils::getFileSize(info))
         return SavegameInfo();
 
-    LogInfo() << "Reading savegame-info: " << info;
+    RE_LOG_DEBUG(Savegame) << "Reading savegame-info: " << info;
 
     std::string infoContents = Utils::readFileContents(info);
     json j = json::parse(infoContents);
@@ -175,8 +231,109 @@ void Engine::SavegameManager::init(Engine::GameEngine& engine)
     gameEngine = &engine;
 }
 
+/**
+ * @return Names of the REGoth-files directly inside the given folder. Everything else in there is left alone.
+ */
+static std::vector<std::string> listSaveFiles(const std::string& dir)
+{
+    std::vector<std::string> names;
+
+    Utils::forEachFile(dir, [&](const std::string& path, const std::string& name, const std::string& ext) {
+        if (isSaveFile(name) && name != "regoth_save.json")
+            names.push_back(name);
+    },
+                       false);
+
+    return names;
+}
+
+/**
+ * Deletes the REGoth-files directly inside the given folder
+ */
+static void removeSaveFiles(const std::string& dir)
+{
+    std::vector<std::string> names = listSaveFiles(dir);
+    names.push_back("regoth_save.json");
+
+    for (const std::string& name : names)
+    {
+        std::string path = dir + "/" + name;
+        if (Utils::fileExists(path) && std::remove(path.c_str()) != 0)
+            LogWarn() << "Failed to remove save-file: " << path;
+    }
+}
+
+/**
+ * Deletes the REGoth-files inside the given folder, then the folder itself, unless something else is left in it
+ */
+static void removeSaveFolder(const std::string& dir)
+{
+    removeSaveFiles(dir);
+
+    if (!Utils::removeDirectory(dir))
+        LogWarn() << "Leaving " << dir << " in place, it contains files not written by REGoth";
+}
+
+/**
+ * Moves the REGoth-files of one folder into another one, which must not contain any of them
+ * @param intoSlot Whether files are moved into a slot. The info-file is what makes a slot count as valid, so it is
+ *                 moved last into a slot and first out of one.
+ * @return Whether all files could be moved
+ */
+static bool moveSaveFiles(const std::string& from, const std::string& to, bool intoSlot)
+{
+    std::vector<std::string> names = listSaveFiles(from);
+
+    if (Utils::fileExists(from + "/regoth_save.json"))
+        names.insert(intoSlot ? names.end() : names.begin(), "regoth_save.json");
+
+    for (const std::string& name : names)
+    {
+        std::string source = from + "/" + name;
+        std::string target = to + "/" + name;
+
+        if (!Utils::renamePath(source, target))
+        {
+            if (Utils::fileExists(target))
+                LogError() << "Failed to move save-file " << source << ", it is blocked by: " << target;
+            else
+                LogError() << "Failed to move save-file " << source << " to: " << target;
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Puts back the previous save of the given slot, in case the game went down while a new one was moved into place
+ */
+static void recoverInterruptedSave(int idx)
+{
+    std::string slotPath = SavegameManager::buildSavegamePath(idx);
+    std::string oldPath = slotPath + ".old";
+
+    if (Utils::getFileSize(slotPath + "/regoth_save.json") == 0 && Utils::getFileSize(oldPath + "/regoth_save.json") > 0)
+    {
+        LogWarn() << "Restoring savegame left by an interrupted save: " << slotPath;
+
+        Utils::mkdir(slotPath);
+        removeSaveFiles(slotPath);
+        if (!moveSaveFiles(oldPath, slotPath, true))
+        {
+            LogError() << "Failed to restore savegame from: " << oldPath;
+            return;
+        }
+
+        removeSaveFolder(oldPath);
+    }
+}
+
 std::vector<std::shared_ptr<const std::string>> SavegameManager::gatherAvailableSavegames()
 {
+    waitForPendingSave();
+
     int numSlots = maxSlots();
 
     std::vector<std::shared_ptr<const std::string>> names(numSlots, nullptr);
@@ -184,6 +341,8 @@ std::vector<std::shared_ptr<const std::string>> SavegameManager::gatherAvailable
     // Try every slot
     for (int i = 0; i < numSlots; ++i)
     {
+        recoverInterruptedSave(i);
+
         if (isSavegameAvailable(i))
         {
             SavegameInfo info = readSavegameInfo(i);
@@ -212,6 +371,9 @@ std::string Engine::SavegameManager::loadSaveGameSlot(int index)
     // Lock to number of savegames
     assert(index >= 0 && index < maxSlots());
 
+    waitForPendingSave();
+    recoverInterruptedSave(index);
+
     if (!isSavegameAvailable(index))
     {
         return "Savegame at slot " + std::to_string(index) + " not available!";
@@ -277,65 +439,230 @@ int Engine::SavegameManager::maxSlots()
     }
 }
 
-void Engine::SavegameManager::saveToSlot(int index, std::string savegameName)
+/**
+ * Writes a file of a savegame, reporting errors
+ */
+static bool writeSaveFile(const std::string& file, const std::string& data)
+{
+    std::ofstream f(file);
+    if (!f.is_open())
+    {
+        LogWarn() << "Failed to save data! Could not open file: " << file;
+        return false;
+    }
+
+    f << data;
+    f.close();
+
+    if (f.fail())
+    {
+        LogWarn() << "Failed to save data! Could not write file: " << file;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Passes the given progress to the callback, on the main thread
+ */
+static void reportSaveProgress(const SavegameManager::SaveCallback& callback, const SavegameManager::SaveProgress& progress)
+{
+    if (!callback)
+        return;
+
+    gameEngine->getJobManager().executeInMainThread<void>([callback, progress](BaseEngine* engine) {
+        callback(progress);
+    });
+}
+
+/**
+ * Serializes the snapshot into a temporary folder next to the slot, then swaps its files with the ones in the slot.
+ * The previous save is only removed after the new one is in place. Only files written by REGoth are moved around.
+ * @return Whether the slot now holds the snapshot
+ */
+static bool writeSnapshot(const SavegameSnapshot& snapshot, const SavegameManager::SaveCallback& callback)
+{
+    std::string tempPath = snapshot.slotPath + ".tmp";
+    std::string oldPath = snapshot.slotPath + ".old";
+
+    if (!Utils::mkdir(tempPath))
+    {
+        LogError() << "Failed to create temporary savegame-directory at: " << tempPath;
+        return false;
+    }
+
+    // Might be left over from an interrupted save
+    removeSaveFiles(tempPath);
+
+    float numFiles = static_cast<float>(snapshot.files.size() + 1);
+    for (size_t i = 0; i < snapshot.files.size(); i++)
+    {
+        const SaveFile& file = snapshot.files[i];
+
+        json unpacked;
+        if (!file.packedData.empty() && !Utils::JsonBinary::decode(file.packedData, unpacked))
+        {
+            LogError() << "Failed to decode data for save-file: " << file.relativePath;
+            removeSaveFolder(tempPath);
+            return false;
+        }
+
+        const json& data = file.packedData.empty() ? file.data : unpacked;
+        if (!writeSaveFile(tempPath + "/" + file.relativePath, Utils::iso_8859_1_to_utf8(data.dump())))
+        {
+            removeSaveFolder(tempPath);
+            return false;
+        }
+
+        reportSaveProgress(callback, {snapshot.slot, (i + 1) / numFiles, false, false});
+    }
+
+    // The info-file is what makes a slot count as valid, so it goes last
+    if (!writeSaveFile(tempPath + "/regoth_save.json", savegameInfoToJson(snapshot.info).dump(4)))
+    {
+        removeSaveFolder(tempPath);
+        return false;
+    }
+
+    if (!Utils::mkdir(oldPath))
+    {
+        LogError() << "Failed to create savegame-backup-directory at: " << oldPath;
+        removeSaveFolder(tempPath);
+        return false;
+    }
+
+    // Swap in the new save. Should the game go down in between, recoverInterruptedSave() puts back the old one.
+    removeSaveFiles(oldPath);
+
+    if (!moveSaveFiles(snapshot.slotPath, oldPath, false))
+    {
+        LogError() << "Failed to move previous savegame out of the way: " << snapshot.slotPath;
+
+        moveSaveFiles(oldPath, snapshot.slotPath, true);
+        removeSaveFolder(tempPath);
+        return false;
+    }
+
+    if (!moveSaveFiles(tempPath, snapshot.slotPath, true))
+    {
+        LogError() << "Failed to move savegame into place: " << snapshot.slotPath;
+
+        removeSaveFiles(snapshot.slotPath);
+        moveSaveFiles(oldPath, snapshot.slotPath, true);
+        removeSaveFolder(tempPath);
+        return false;
+    }
+
+    removeSaveFolder(oldPath);
+    removeSaveFolder(tempPath);
+    return true;
+}
+
+bool Engine::SavegameManager::saveToSlot(int index, std::string savegameName, SaveCallback callback)
 {
     if (!gameEngine->getMainWorld().isValid() || gameEngine->getMainWorld().get().getDialogManager().isDialogActive())
-        return; // only save while not in Dialog
+        return false; // only save while not in Dialog
+
+    if (isSaveInProgress())
+    {
+        LogWarn() << "Can't save to slot " << index << " while the previous save is still being written";
+        return false;
+    }
 
     Utils::RecursiveStopWatch excludeFrameTime(gameEngine->m_ExcludedFrameTime);
     assert(index >= 0 && index < SavegameManager::maxSlots());
 
+    int64_t snapshotStart = bx::getHPCounter();
+
     if (savegameName.empty())
         savegameName = std::string("Slot") + std::to_string(index);
 
-    // TODO: Should be writing to a temp-directory first, before messing with the save-files already existing
-    // Clean data from old savegame, so we don't load into worlds we haven't been to yet
-    Engine::SavegameManager::clearSavegame(index);
+    ensureSavegameFolders(index);
+
+    // Note: Nothing in here may touch the files of the slot, as the previous save has to stay intact until the
+    // new one has been written completely
+    std::shared_ptr<SavegameSnapshot> snapshot = std::make_shared<SavegameSnapshot>();
+    snapshot->slot = index;
+    snapshot->slotPath = buildSavegamePath(index);
 
     World::WorldInstance& mainWorld = gameEngine->getMainWorld().get();
     // Write information about the current game-state
-    Engine::SavegameManager::SavegameInfo info;
-    info.version = Engine::SavegameManager::SavegameInfo::LATEST_KNOWN_VERSION;
-    info.name = savegameName;
-    info.world = Utils::stripExtension(mainWorld.getZenFile());
-    info.timePlayed = gameEngine->getGameClock().getTotalSeconds();
-
-    Engine::SavegameManager::writeSavegameInfo(index, info);
+    snapshot->info.version = Engine::SavegameManager::SavegameInfo::LATEST_KNOWN_VERSION;
+    snapshot->info.name = savegameName;
+    snapshot->info.world = Utils::stripExtension(mainWorld.getZenFile());
+    snapshot->info.timePlayed = gameEngine->getGameClock().getTotalSeconds();
 
     // export left worlds we visited in this session
     for (auto& pair : gameEngine->getSession().getInactiveWorlds())
     {
         std::string worldName = Utils::stripExtension(pair.first);
-        nlohmann::json& worldJson = pair.second;
-        SavegameManager::writeWorld(index, worldName, worldJson);
+        snapshot->files.push_back({"world_" + worldName + ".json", json(), std::move(pair.second)});
     }
     // no need to keep them in memory anymore and they would be unnecessarily saved each time
     gameEngine->getSession().getInactiveWorlds().clear();
 
     // export player
-    json playerJson = mainWorld.exportNPC(mainWorld.getScriptEngine().getPlayerEntity());
-    Engine::SavegameManager::writePlayer(index, "player", playerJson);
+    snapshot->files.push_back({"player.json", mainWorld.exportNPC(mainWorld.getScriptEngine().getPlayerEntity())});
 
     // export mainWorld, but skip the player
     json mainWorldjson;
     mainWorld.exportWorld(mainWorldjson, {mainWorld.getScriptEngine().getPlayerEntity()});
-    Engine::SavegameManager::writeWorld(index, info.world, mainWorldjson);
+    snapshot->files.push_back({"world_" + snapshot->info.world + ".json", std::move(mainWorldjson)});
 
     // export dialog info
     json dialogManager;
     mainWorld.getDialogManager().exportDialogManager(dialogManager);
-    Engine::SavegameManager::writeFileInSlot(index, "dialogmanager.json", Utils::iso_8859_1_to_utf8(dialogManager.dump(4)));
+    snapshot->files.push_back({"dialogmanager.json", std::move(dialogManager)});
 
     // export log info
     json logManager;
     gameEngine->getSession().getLogManager().exportLogManager(logManager);
-    Engine::SavegameManager::writeFileInSlot(index, "logmanager.json", Utils::iso_8859_1_to_utf8(logManager.dump(4)));
+    snapshot->files.push_back({"logmanager.json", std::move(logManager)});
 
     // export script engine
     json scriptEngine;
     mainWorld.getScriptEngine().exportScriptEngine(scriptEngine);
-    Engine::SavegameManager::writeFileInSlot(index, "scriptengine.json", Utils::iso_8859_1_to_utf8(scriptEngine.dump(4)));
+    snapshot->files.push_back({"scriptengine.json", std::move(scriptEngine)});
+
     gameEngine->getSession().setCurrentSlot(index);
+
+    double snapshotMs = 1000.0 * (bx::getHPCounter() - snapshotStart) / static_cast<double>(bx::getHPFrequency());
+    LogInfo() << "Took savegame-snapshot for slot " << index << " in " << snapshotMs << " ms, writing in background";
+
+    auto writeJob = [snapshot, callback](BaseEngine* engine) {
+        Utils::FrameProfiler::setThreadName("Savegame writer");
+
+        int64_t writeStart = bx::getHPCounter();
+        bool success = writeSnapshot(*snapshot, callback);
+        double writeMs = 1000.0 * (bx::getHPCounter() - writeStart) / static_cast<double>(bx::getHPFrequency());
+
+        if (success)
+            LogInfo() << "Savegame written to " << snapshot->slotPath << " in " << writeMs << " ms";
+        else
+            LogError() << "Failed to write savegame to " << snapshot->slotPath << ", previous save kept";
+
+        reportSaveProgress(callback, {snapshot->slot, 1.0f, true, success});
+    };
+
+    std::shared_future<void> save = gameEngine->getJobManager().executeInThread<void>(writeJob, ExecutionPolicy::NewThread).share();
+
+    std::lock_guard<std::mutex> guard(pendingSaveMutex);
+    pendingSave = save;
+    return true;
+}
+
+bool Engine::SavegameManager::isSaveInProgress()
+{
+    std::shared_future<void> save = getPendingSave();
+    return save.valid() && save.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+}
+
+void Engine::SavegameManager::waitForPendingSave()
+{
+    std::shared_future<void> save = getPendingSave();
+    if (save.valid())
+        save.wait();
 }
 
 std::string Engine::SavegameManager::gameSpecificSubFolderName()
@@ -348,12 +675,15 @@ std::string Engine::SavegameManager::gameSpecificSubFolderName()
 
 std::string Engine::SavegameManager::readFileInSlot(int idx, const std::string& relativePath)
 {
+    // Files might just be getting swapped
+    waitForPendingSave();
+
     std::string file = buildSavegamePath(idx) + "/" + relativePath;
 
     if (!Utils::getFileSize(file))
         return "";  // Not found or empty
 
-    LogInfo() << "Reading save-file: " << file;
+    RE_LOG_DEBUG(Savegame) << "Reading save-file: " << file;
     return Utils::readFileContents(file);
 }
 
@@ -362,7 +692,7 @@ bool Engine::SavegameManager::writeFileInSlot(int idx, const std::string& relati
     std::string file = buildSavegamePath(idx) + "/" + relativePath;
     ensureSavegameFolders(idx);
 
-    LogInfo() << "Writing save-file: " << file;
+    RE_LOG_DEBUG(Savegame) << "Writing save-file: " << file;
 
     std::ofstream f(file);
     if (!f.is_open())
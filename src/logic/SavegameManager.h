@@ -1,4 +1,5 @@
 #pragma once
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -137,11 +138,39 @@ namespace Engine
         std::string loadSaveGameSlot(int index);
 
         /**
-         * saves the current world to the given slot
+         * State of a save being written in the background
+         */
+        struct SaveProgress
+        {
+            int slot;
+            float progress;  // Share of files written so far, 0..1
+            bool done;       // Whether this is the last report for this save
+            bool success;    // Only meaningful when done. On failure, the slot still holds the previous save.
+        };
+
+        typedef std::function<void(const SaveProgress&)> SaveCallback;
+
+        /**
+         * Saves the current world to the given slot. Only a snapshot of the game-state is taken on the calling
+         * thread, which should be the main thread at frame-end. Serializing and writing happens in the background,
+         * into a temporary folder which replaces the slot once it is complete. A crash while saving therefore never
+         * destroys the previous save.
          * @param index slotindex
          * @param savegameName label of the savegame. If empty string, then "Slot <index>" is used as name
+         * @param callback Called on the main thread whenever a file got written, the last time with done set.
+         * @return false, if the game can't be saved right now (no world, inside a dialog, other save still running)
+         */
+        bool saveToSlot(int index, std::string savegameName, SaveCallback callback = nullptr);
+
+        /**
+         * @return Whether a save is still being written in the background
+         */
+        bool isSaveInProgress();
+
+        /**
+         * Blocks until the save being written in the background (if any) is done
          */
-        void saveToSlot(int index, std::string savegameName);
+        void waitForPendingSave();
 
         /**
          * Builds the path to a saved worldfile from the given slot
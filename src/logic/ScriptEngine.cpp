@@ -1,5 +1,6 @@
 #include "ScriptEngine.h"
 #include "PlayerController.h"
+#include <algorithm>
 #include <ZenLib/daedalus/DATFile.h>
 #include <components/VobClasses.h>
 #include <daedalus/DaedalusGameState.h>
@@ -9,20 +10,22 @@
 #include <handle/HandleDef.h>
 #include <logic/scriptExternals/Externals.h>
 #include <logic/scriptExternals/Stubs.h>
+#include <memory/AllocationTracker.h>
 #include <ui/PrintScreenMessages.h>
 #include <utils/logger.h>
 #include <utils/Utils.h>
 
 using namespace Logic;
 
-// Set to 1 to generate valid timing data for script-calls
-#define PROFILE_SCRIPT_CALLS 0
+const size_t ScriptEngine::INVALID_SYMBOL;
 
 ScriptEngine::ScriptEngine(World::WorldInstance& world)
     : m_World(world)
 {
     m_pVM = nullptr;
-    m_ProfilingDataFrame = 0;
+    m_NumNameLookups = 0;
+    m_NumNameLookupsLastFrame = 0;
+    m_CommonSymbols = {INVALID_SYMBOL, INVALID_SYMBOL, INVALID_SYMBOL, INVALID_SYMBOL, INVALID_SYMBOL, INVALID_SYMBOL, INVALID_SYMBOL};
 }
 
 ScriptEngine::~ScriptEngine()
@@ -32,6 +35,8 @@ ScriptEngine::~ScriptEngine()
 
 bool ScriptEngine::loadDAT(const uint8_t* pDatFile, size_t numBytes)
 {
+  RE_ALLOCATION_SCOPE(Tag_Script);
+
   delete m_pVM;
 
   m_pVM = new Daedalus::DaedalusVM(pDatFile, numBytes);
@@ -42,6 +47,8 @@ bool ScriptEngine::loadDAT(const uint8_t* pDatFile, size_t numBytes)
 
 bool ScriptEngine::loadDAT(const std::string& file)
 {
+    RE_ALLOCATION_SCOPE(Tag_Script);
+
     delete m_pVM;  // FIXME: Should support merging DATS?
 
     m_pVM = new Daedalus::DaedalusVM(file);
@@ -53,10 +60,10 @@ bool ScriptEngine::loadDAT(const std::string& file)
 bool ScriptEngine::initVMWithLoadedDAT()
 {
     // Register externals
-    const bool verbose = false;
-    Logic::ScriptExternals::registerStubs(*m_pVM, verbose);
+    // Per-call logging of the externals is done on the trace-level of the script-category, see "loglevel"
+    Logic::ScriptExternals::registerStubs(*m_pVM, m_Profiler);
     Daedalus::registerGothicEngineClasses(*m_pVM);
-    Logic::ScriptExternals::registerEngineExternals(m_World, m_pVM, verbose);
+    Logic::ScriptExternals::registerEngineExternals(m_World, m_pVM);
 
     // Register our externals
     Daedalus::GameState::DaedalusGameState::GameExternals ext;
@@ -67,9 +74,49 @@ bool ScriptEngine::initVMWithLoadedDAT()
 
     m_pVM->getGameState().setGameExternals(ext);
 
+    resolveCommonSymbols();
+
     return true;
 }
 
+void ScriptEngine::resolveCommonSymbols()
+{
+    Daedalus::DATFile& dat = m_pVM->getDATFile();
+
+    auto resolve = [&](const std::string& name) {
+        return dat.hasSymbolName(name) ? dat.getSymbolIndexByName(name) : INVALID_SYMBOL;
+    };
+
+    m_CommonSymbols.self = resolve("SELF");
+    m_CommonSymbols.other = resolve("OTHER");
+    m_CommonSymbols.victim = resolve("VICTIM");
+    m_CommonSymbols.item = resolve("ITEM");
+    m_CommonSymbols.hero = resolve("HERO");
+    m_CommonSymbols.guildAttitudes = resolve("GIL_ATTITUDES");
+    m_CommonSymbols.attHostile = resolve("ATT_HOSTILE");
+
+    m_StateFunctionsBySymbol.clear();
+}
+
+const ScriptEngine::StateFunctions& ScriptEngine::getStateFunctions(size_t symMain)
+{
+    auto it = m_StateFunctionsBySymbol.find(symMain);
+    if (it != m_StateFunctionsBySymbol.end())
+        return it->second;
+
+    Daedalus::DATFile& dat = m_pVM->getDATFile();
+    const std::string& name = dat.getSymbolByIndex(symMain).name;
+
+    StateFunctions fns = {0, 0};
+    if (dat.hasSymbolName(name + "_LOOP"))
+        fns.symLoop = dat.getSymbolIndexByName(name + "_LOOP");
+
+    if (dat.hasSymbolName(name + "_END"))
+        fns.symEnd = dat.getSymbolIndexByName(name + "_END");
+
+    return m_StateFunctionsBySymbol[symMain] = fns;
+}
+
 void ScriptEngine::prepareRunFunction()
 {
     // Clean the VM for this run
@@ -78,20 +125,31 @@ void ScriptEngine::prepareRunFunction()
 
 int32_t ScriptEngine::runFunction(const std::string& fname, bool clearDataStack)
 {
+    countNameLookup();
     assert(getVM().getDATFile().hasSymbolName(fname));
     return runFunctionBySymIndex(getVM().getDATFile().getSymbolIndexByName(fname), clearDataStack);
 }
 
 int32_t ScriptEngine::runFunctionBySymIndex(size_t symIdx, bool clearDataStack)
 {
-#if PROFILE_SCRIPT_CALLS
-    startProfiling(symIdx);
-#endif
-    int32_t ret = m_pVM->runFunctionBySymIndex(symIdx, clearDataStack);
-#if PROFILE_SCRIPT_CALLS
-    stopProfiling(symIdx);
-#endif
-    return ret;
+    RE_ALLOCATION_SCOPE(Tag_Script);
+
+    ScriptProfiler::Scope profile(m_Profiler, ScriptProfiler::EKind::Function, symIdx,
+                                  m_Profiler.isEnabled() ? getSelfInstanceSymbol() : ScriptProfiler::NO_SYMBOL);
+
+    return m_pVM->runFunctionBySymIndex(symIdx, clearDataStack);
+}
+
+size_t ScriptEngine::getSelfInstanceSymbol()
+{
+    if (m_CommonSymbols.self == INVALID_SYMBOL)
+        return ScriptProfiler::NO_SYMBOL;
+
+    Daedalus::GameState::NpcHandle self = getNPCFromSymbol(m_CommonSymbols.self);
+    if (!self.isValid())
+        return ScriptProfiler::NO_SYMBOL;
+
+    return getGameState().getNpc(self).instanceSymbol;
 }
 
 void ScriptEngine::pushInt(int32_t v)
@@ -111,11 +169,14 @@ void ScriptEngine::pushSymbol(size_t sym, uint32_t arrayIndex)
 
 void ScriptEngine::pushSymbol(const std::string& sname)
 {
+    countNameLookup();
     m_pVM->pushVar(sname);
 }
 
 void ScriptEngine::setInstance(const std::string& target, const std::string& source)
 {
+    countNameLookup();
+
     // Target is checked later
     assert(m_pVM->getDATFile().hasSymbolName(source));
 
@@ -125,6 +186,7 @@ void ScriptEngine::setInstance(const std::string& target, const std::string& sou
 
 void ScriptEngine::setInstance(const std::string& target, size_t source)
 {
+    countNameLookup();
     assert(m_pVM->getDATFile().hasSymbolName(target));
 
     auto& sym = m_pVM->getDATFile().getSymbolByIndex(source);
@@ -134,6 +196,7 @@ void ScriptEngine::setInstance(const std::string& target, size_t source)
 
 void ScriptEngine::setInstanceNPC(const std::string& target, Daedalus::GameState::NpcHandle npc)
 {
+    countNameLookup();
     assert(m_pVM->getDATFile().hasSymbolName(target));
 
     m_pVM->setInstance(target, ZMemory::toBigHandle(npc), Daedalus::EInstanceClass::IC_Npc);
@@ -141,11 +204,49 @@ void ScriptEngine::setInstanceNPC(const std::string& target, Daedalus::GameState
 
 void ScriptEngine::setInstanceItem(const std::string& target, Daedalus::GameState::ItemHandle item)
 {
+    countNameLookup();
     assert(m_pVM->getDATFile().hasSymbolName(target));
 
     m_pVM->setInstance(target, ZMemory::toBigHandle(item), Daedalus::EInstanceClass::IC_Item);
 }
 
+void ScriptEngine::setInstance(size_t target, size_t source)
+{
+    assert(target != INVALID_SYMBOL && source != INVALID_SYMBOL);
+    if (target == INVALID_SYMBOL || source == INVALID_SYMBOL)
+        return;
+
+    auto& sym = m_pVM->getDATFile().getSymbolByIndex(source);
+    auto& targetSym = m_pVM->getDATFile().getSymbolByIndex(target);
+
+    targetSym.instanceDataHandle = sym.instanceDataHandle;
+    targetSym.instanceDataClass = sym.instanceDataClass;
+}
+
+void ScriptEngine::setInstanceNPC(size_t target, Daedalus::GameState::NpcHandle npc)
+{
+    assert(target != INVALID_SYMBOL);
+    if (target == INVALID_SYMBOL)
+        return;
+
+    auto& sym = m_pVM->getDATFile().getSymbolByIndex(target);
+
+    sym.instanceDataHandle = ZMemory::toBigHandle(npc);
+    sym.instanceDataClass = Daedalus::EInstanceClass::IC_Npc;
+}
+
+void ScriptEngine::setInstanceItem(size_t target, Daedalus::GameState::ItemHandle item)
+{
+    assert(target != INVALID_SYMBOL);
+    if (target == INVALID_SYMBOL)
+        return;
+
+    auto& sym = m_pVM->getDATFile().getSymbolByIndex(target);
+
+    sym.instanceDataHandle = ZMemory::toBigHandle(item);
+    sym.instanceDataClass = Daedalus::EInstanceClass::IC_Item;
+}
+
 void ScriptEngine::initForWorld(const std::string& world, bool firstStart)
 {
     if (!m_World.getEngine()->getEngineArgs().cmdline.hasArg('c'))
@@ -204,6 +305,7 @@ Daedalus::GameState::DaedalusGameState& ScriptEngine::getGameState()
 
 size_t ScriptEngine::getSymbolIndexByName(const std::string& name)
 {
+    countNameLookup();
     return m_pVM->getDATFile().getSymbolIndexByName(name);
 }
 
@@ -245,6 +347,11 @@ void ScriptEngine::onInventoryItemInserted(Daedalus::GameState::ItemHandle item,
 
 void ScriptEngine::onNPCInitialized(Daedalus::GameState::NpcHandle npc)
 {
+    // The instance-constructor has run now, so the display-name is known
+    Handle::EntityHandle e = VobTypes::getEntityFromScriptInstance(m_World, npc);
+    if (e.isValid())
+        updateNpcName(e);
+
     // Initialize daily routine
     Daedalus::GEngineClasses::C_Npc& npcData = getGameState().getNpc(npc);
 
@@ -255,16 +362,16 @@ void ScriptEngine::onNPCInitialized(Daedalus::GameState::NpcHandle npc)
     {
         prepareRunFunction();
 
-        m_pVM->setInstance("self", ZMemory::toBigHandle(npc), Daedalus::IC_Npc);
-        m_pVM->setCurrentInstance(getSymbolIndexByName("self"));
+        setInstanceNPC(m_CommonSymbols.self, npc);
+        m_pVM->setCurrentInstance(m_CommonSymbols.self);
 
         runFunctionBySymIndex(npcData.daily_routine);
     }
 }
 
-std::set<Handle::EntityHandle> ScriptEngine::getNPCsInRadius(const Math::float3& center, float radius)
+Memory::FrameVector<Handle::EntityHandle> ScriptEngine::getNPCsInRadius(const Math::float3& center, float radius)
 {
-    std::set<Handle::EntityHandle> outSet;
+    Memory::FrameVector<Handle::EntityHandle> out;
     float radSq = radius * radius;
 
     for (const Handle::EntityHandle& e : m_WorldNPCs)
@@ -272,36 +379,76 @@ std::set<Handle::EntityHandle> ScriptEngine::getNPCsInRadius(const Math::float3&
         Math::float3 translation = m_World.getEntity<Components::PositionComponent>(e).m_WorldMatrix.Translation();
 
         if ((center - translation).lengthSquared() < radSq)
-            outSet.insert(e);
+            out.push_back(e);
     }
 
-    return outSet;
+    return out;
 }
 
 Handle::EntityHandle ScriptEngine::findWorldNPC(const std::string& name)
 {
-    auto& datFile = getVM().getDATFile();
-
-    for (const Handle::EntityHandle& npc : getWorldNPCs())
+    World::NameId id = m_World.getNameTable().find(name);
+    auto it = m_NPCsByName.find(id);
+    if (id != World::INVALID_NAME && it != m_NPCsByName.end())
     {
-        VobTypes::NpcVobInformation npcVobInfo = VobTypes::asNpcVob(m_World, npc);
-        if (!npcVobInfo.isValid())
-            continue;
+        // Copy, as dropping stale entries modifies the index
+        std::vector<Handle::EntityHandle> candidates = (*it).second;
+        for (Handle::EntityHandle e : candidates)
+        {
+            if (npcHasName(e, name))
+                return e;
 
-        Daedalus::GEngineClasses::C_Npc& npcScriptObject = npcVobInfo.playerController->getScriptInstance();
-        std::string npcDisplayName = npcScriptObject.name[0];
-        std::string npcDatFileName = datFile.getSymbolByIndex(npcScriptObject.instanceSymbol).name;
+            // The scripts renamed this one since it was indexed
+            updateNpcName(e);
+        }
+    }
 
-        for (auto npcName : {npcDisplayName, npcDatFileName})
+    // Scripts can assign display-names at any time without telling us, so fall back to the current ones
+    for (Handle::EntityHandle e : m_WorldNPCs)
+    {
+        if (npcHasName(e, name))
         {
-            std::replace(npcName.begin(), npcName.end(), ' ', '_');
-            if (Utils::stringEqualIngoreCase(name, npcName))
-            {
-                return npc;
-            }
+            updateNpcName(e);
+            return e;
         }
     }
-    return Handle::EntityHandle();
+
+    return Handle::EntityHandle::makeInvalidHandle();
+}
+
+Handle::EntityHandle ScriptEngine::findWorldMob(const std::string& name)
+{
+    return findInNameIndex(m_MobsByName, m_World.getNameTable().find(name));
+}
+
+void ScriptEngine::addToNameIndex(EntitiesByName& index, World::NameId name, Handle::EntityHandle e)
+{
+    if (name != World::INVALID_NAME)
+        index[name].push_back(e);
+}
+
+void ScriptEngine::removeFromNameIndex(EntitiesByName& index, World::NameId name, Handle::EntityHandle e)
+{
+    auto it = index.find(name);
+    if (it == index.end())
+        return;
+
+    std::vector<Handle::EntityHandle>& entities = (*it).second;
+    auto ite = std::find(entities.begin(), entities.end(), e);
+    if (ite != entities.end())
+        entities.erase(ite);
+
+    if (entities.empty())
+        index.erase(it);
+}
+
+Handle::EntityHandle ScriptEngine::findInNameIndex(const EntitiesByName& index, World::NameId name)
+{
+    auto it = index.find(name);
+    if (it == index.end() || (*it).second.empty())
+        return Handle::EntityHandle::makeInvalidHandle();
+
+    return (*it).second.front();
 }
 
 void ScriptEngine::onLogEntryAdded(const std::string& topic, const std::string& entry)
@@ -312,12 +459,28 @@ void ScriptEngine::onLogEntryAdded(const std::string& topic, const std::string&
 
 bool ScriptEngine::hasSymbol(const std::string& name)
 {
+    countNameLookup();
     return m_pVM->getDATFile().hasSymbolName(name);
 }
 
 Daedalus::GameState::NpcHandle ScriptEngine::getNPCFromSymbol(const std::string& symName)
 {
-    Daedalus::PARSymbol& sym = m_pVM->getDATFile().getSymbolByName(symName);
+    countNameLookup();
+    return getNPCFromSymbol(m_pVM->getDATFile().getSymbolIndexByName(symName));
+}
+
+Daedalus::GameState::ItemHandle ScriptEngine::getItemFromSymbol(const std::string& symName)
+{
+    countNameLookup();
+    return getItemFromSymbol(m_pVM->getDATFile().getSymbolIndexByName(symName));
+}
+
+Daedalus::GameState::NpcHandle ScriptEngine::getNPCFromSymbol(size_t symIdx)
+{
+    if (symIdx == INVALID_SYMBOL)
+        return Daedalus::GameState::NpcHandle();
+
+    Daedalus::PARSymbol& sym = m_pVM->getDATFile().getSymbolByIndex(symIdx);
 
     if (sym.instanceDataClass != Daedalus::IC_Npc)
         return Daedalus::GameState::NpcHandle();
@@ -325,9 +488,12 @@ Daedalus::GameState::NpcHandle ScriptEngine::getNPCFromSymbol(const std::string&
     return ZMemory::handleCast<Daedalus::GameState::NpcHandle>(sym.instanceDataHandle);
 }
 
-Daedalus::GameState::ItemHandle ScriptEngine::getItemFromSymbol(const std::string& symName)
+Daedalus::GameState::ItemHandle ScriptEngine::getItemFromSymbol(size_t symIdx)
 {
-    Daedalus::PARSymbol& sym = m_pVM->getDATFile().getSymbolByName(symName);
+    if (symIdx == INVALID_SYMBOL)
+        return Daedalus::GameState::ItemHandle();
+
+    Daedalus::PARSymbol& sym = m_pVM->getDATFile().getSymbolByIndex(symIdx);
 
     if (sym.instanceDataClass != Daedalus::IC_Item)
         return Daedalus::GameState::ItemHandle();
@@ -336,6 +502,7 @@ Daedalus::GameState::ItemHandle ScriptEngine::getItemFromSymbol(const std::strin
 }
 
 Daedalus::GameState::MusicThemeHandle ScriptEngine::getMusicThemeFromSymbol(const std::string& symName) {
+    countNameLookup();
     Daedalus::PARSymbol& sym = m_pVM->getDATFile().getSymbolByName(symName);
 
     if (sym.instanceDataClass != Daedalus::IC_MusicTheme)
@@ -362,6 +529,30 @@ void ScriptEngine::registerMob(Handle::EntityHandle e)
 void ScriptEngine::unregisterMob(Handle::EntityHandle e)
 {
     m_WorldMobs.erase(e);
+
+    auto it = m_NameIdByMob.find(e);
+    if (it != m_NameIdByMob.end())
+    {
+        removeFromNameIndex(m_MobsByName, (*it).second, e);
+        m_NameIdByMob.erase(it);
+    }
+}
+
+void ScriptEngine::setMobName(Handle::EntityHandle e, const std::string& name)
+{
+    auto it = m_NameIdByMob.find(e);
+    if (it != m_NameIdByMob.end())
+    {
+        removeFromNameIndex(m_MobsByName, (*it).second, e);
+        m_NameIdByMob.erase(it);
+    }
+
+    if (name.empty())
+        return;
+
+    World::NameId id = m_World.getNameTable().intern(name);
+    addToNameIndex(m_MobsByName, id, e);
+    m_NameIdByMob[e] = id;
 }
 
 bool ScriptEngine::useItemOn(Daedalus::GameState::ItemHandle hitem, Handle::EntityHandle hnpc)
@@ -391,81 +582,10 @@ bool ScriptEngine::useItemOn(Daedalus::GameState::ItemHandle hitem, Handle::Enti
     return true;
 }
 
-void ScriptEngine::startProfiling(size_t fnSym)
-{
-    const int64_t now = bx::getHPCounter();
-
-    // Store starting time
-    m_TimeStartStack.push(now);
-}
-
-void ScriptEngine::stopProfiling(size_t fnSym)
-{
-    const double freq = double(bx::getHPFrequency());
-
-    if (m_TimeByFunctionSymbol[m_ProfilingDataFrame].find(fnSym) == m_TimeByFunctionSymbol[m_ProfilingDataFrame].end())
-        m_TimeByFunctionSymbol[m_ProfilingDataFrame][fnSym] = 0.0;
-
-    // Make delta-time
-    m_TimeByFunctionSymbol[m_ProfilingDataFrame][fnSym] += (bx::getHPCounter() - m_TimeStartStack.top()) / freq;
-
-    m_TimeStartStack.pop();
-}
-
-void ScriptEngine::resetProfilingData()
-{
-    while (!m_TimeStartStack.empty())
-        m_TimeStartStack.pop();
-
-    m_TimeByFunctionSymbol[m_ProfilingDataFrame].clear();
-}
-
 void ScriptEngine::onFrameStart()
 {
-#if PROFILE_SCRIPT_CALLS
-    m_ProfilingDataFrame = (m_ProfilingDataFrame + 1) % 10;
-
-    resetProfilingData();
-#endif
-}
-
-void ScriptEngine::onFrameEnd()
-{
-#if PROFILE_SCRIPT_CALLS
-    // Get the 5 most costly calls
-    std::vector<std::pair<size_t, double>> calls;
-    std::map<size_t, double> combined;
-
-    volatile double sum = 0.0;
-    for (int i = 0; i < 10; i++)
-    {
-        for (auto& p : m_TimeByFunctionSymbol[i])
-        {
-            if (combined.find(p.first) == combined.end())
-                combined[p.first] = 0;
-
-            combined[p.first] += p.second / 10;
-        }
-    }
-
-    for (auto& p : combined)
-    {
-        sum += p.second;
-        calls.push_back(p);
-    }
-
-    // Sort descending
-    std::sort(calls.begin(), calls.end(), [](const std::pair<size_t, double>& a, const std::pair<size_t, double>& b) {
-        return a.second > b.second;
-    });
-
-    bgfx::dbgTextPrintf(60, 0, 0x0f, "Script profiling [ms] (Total: %.3f):", sum * 1000.0);
-    for (int i = 0; i < std::min(5, (int)calls.size()); i++)
-    {
-        std::string name = getVM().getDATFile().getSymbolByIndex(calls[i].first).name;
-        bgfx::dbgTextPrintf(60, 1 + i, 0x0f, "  %s: %.3f", name.c_str(), calls[i].second * 1000.0);
-    }
-#endif
+    m_NumNameLookupsLastFrame = m_NumNameLookups;
+    m_NumNameLookups = 0;
 }
 
 void ScriptEngine::exportScriptEngine(json& j)
@@ -541,9 +661,71 @@ void ScriptEngine::onNPCRemoved(Daedalus::GameState::NpcHandle npc)
 void ScriptEngine::registerNpc(Handle::EntityHandle e)
 {
     m_WorldNPCs.insert(e);
+
+    // The instance-constructor hasn't run yet at this point, so there is no display-name to index. That happens
+    // once the NPC got initialized, see updateNpcName().
+    updateNpcName(e);
+}
+
+void ScriptEngine::updateNpcName(Handle::EntityHandle e)
+{
+    VobTypes::NpcVobInformation npc = VobTypes::asNpcVob(m_World, e);
+    if (!npc.isValid())
+        return;
+
+    // Index by display-name (spaces given as underscores) and by the name of the instance-symbol
+    Daedalus::GEngineClasses::C_Npc& scriptObject = npc.playerController->getScriptInstance();
+    std::string displayName = scriptObject.name[0];
+    std::replace(displayName.begin(), displayName.end(), ' ', '_');
+
+    World::NameTable& names = m_World.getNameTable();
+    std::array<World::NameId, 2> ids = {{displayName.empty() ? World::INVALID_NAME : names.intern(displayName),
+                                         names.intern(getSymbolNameByIndex(scriptObject.instanceSymbol))}};
+
+    // Don't list an NPC twice if both names are the same
+    if (ids[0] == ids[1])
+        ids[0] = World::INVALID_NAME;
+
+    auto it = m_NameIdsByNPC.find(e);
+    if (it != m_NameIdsByNPC.end())
+    {
+        if ((*it).second == ids)
+            return;
+
+        for (World::NameId id : (*it).second)
+            removeFromNameIndex(m_NPCsByName, id, e);
+    }
+
+    for (World::NameId id : ids)
+        addToNameIndex(m_NPCsByName, id, e);
+
+    m_NameIdsByNPC[e] = ids;
+}
+
+bool ScriptEngine::npcHasName(Handle::EntityHandle e, const std::string& name)
+{
+    VobTypes::NpcVobInformation npc = VobTypes::asNpcVob(m_World, e);
+    if (!npc.isValid())
+        return false;
+
+    Daedalus::GEngineClasses::C_Npc& scriptObject = npc.playerController->getScriptInstance();
+    std::string displayName = scriptObject.name[0];
+    std::replace(displayName.begin(), displayName.end(), ' ', '_');
+
+    return Utils::stringEqualIngoreCase(name, displayName)
+           || Utils::stringEqualIngoreCase(name, getSymbolNameByIndex(scriptObject.instanceSymbol));
 }
 
 void ScriptEngine::unregisterNpc(Handle::EntityHandle e)
 {
     m_WorldNPCs.erase(e);
+
+    auto it = m_NameIdsByNPC.find(e);
+    if (it != m_NameIdsByNPC.end())
+    {
+        for (World::NameId id : (*it).second)
+            removeFromNameIndex(m_NPCsByName, id, e);
+
+        m_NameIdsByNPC.erase(it);
+    }
 }
@@ -1,11 +1,18 @@
 #pragma once
+#include <array>
+#include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include <json.hpp>
 #include <daedalus/DaedalusGameState.h>
 #include <daedalus/DaedalusVM.h>
+#include <engine/NameTable.h>
 #include <handle/HandleDef.h>
+#include <logic/ScriptProfiler.h>
 #include <math/mathlib.h>
+#include <memory/FrameArena.h>
 using json = nlohmann::json;
 
 namespace Daedalus
@@ -23,6 +30,33 @@ namespace Logic
     class ScriptEngine
     {
     public:
+        /**
+         * Symbols the engine accesses all the time. These are resolved once after a DAT-file has been
+         * loaded, so engine-code doesn't need to look them up by name.
+         * Symbols missing in the loaded scripts are set to INVALID_SYMBOL.
+         */
+        struct CommonSymbols
+        {
+            size_t self;
+            size_t other;
+            size_t victim;
+            size_t item;
+            size_t hero;
+            size_t guildAttitudes;  // GIL_ATTITUDES
+            size_t attHostile;      // ATT_HOSTILE
+        };
+
+        /**
+         * Loop- and end-functions of an AI-state (ZS_*). 0, if the state doesn't have the function.
+         */
+        struct StateFunctions
+        {
+            size_t symLoop;
+            size_t symEnd;
+        };
+
+        static const size_t INVALID_SYMBOL = static_cast<size_t>(-1);
+
         ScriptEngine(World::WorldInstance& world);
         ScriptEngine(World::WorldInstance& world, ScriptEngine&& other);
         virtual ~ScriptEngine();
@@ -59,7 +93,6 @@ namespace Logic
          * Frame-functions
          */
         void onFrameStart();
-        void onFrameEnd();
 
         /**
          * Saves the state of the VM and prepares it for a call to runFunction.
@@ -83,6 +116,14 @@ namespace Logic
         void setInstanceNPC(const std::string& target, Daedalus::GameState::NpcHandle npc);
         void setInstanceItem(const std::string& target, Daedalus::GameState::NpcHandle npc);
 
+        /**
+         * Same as above, but without looking up the target-symbol by name. See getCommonSymbols().
+         * Must not be passed INVALID_SYMBOL, release-builds ignore the call then.
+         */
+        void setInstance(size_t target, size_t source);
+        void setInstanceNPC(size_t target, Daedalus::GameState::NpcHandle npc);
+        void setInstanceItem(size_t target, Daedalus::GameState::ItemHandle item);
+
         /**
          * Runs a complete function with the arguments given by pushing onto the stack
          * Note: Must be prepared first, using prepareRunFunction.
@@ -128,22 +169,29 @@ namespace Logic
          * Returns a list of all npcs found inside the given sphere
          * @param center Center of the search-sphere
          * @param radius Radius of the search-sphere
-         * @return List of found NPCs
+         * @return List of found NPCs, sorted by handle. Only valid until the end of the next frame.
          */
-        std::set<Handle::EntityHandle> getNPCsInRadius(const Math::float3& center, float radius);
+        Memory::FrameVector<Handle::EntityHandle> getNPCsInRadius(const Math::float3& center, float radius);
 
         /**
          * @return List of all registered NPCs in the world
          */
         const std::set<Handle::EntityHandle>& getWorldNPCs() { return m_WorldNPCs; }
         /**
-         * Searches the current world for NPCs with the given display-name or DATFile-name
-         * Comparison is case insensitive
-         * @param namePart full or partial name to be looked for
-         * @return List of all NPCs whose names are similar to namePart
+         * Searches the current world for an NPC with the given display-name or DATFile-name.
+         * Comparison is case insensitive, spaces inside display-names are to be given as underscores.
+         * @param name Name to look for
+         * @return First NPC registered with that name, invalid handle if none
          */
         Handle::EntityHandle findWorldNPC(const std::string& name);
 
+        /**
+         * Searches the current world for a mob with the given focus-name. Comparison is case insensitive.
+         * @param name Name to look for
+         * @return First mob registered with that name, invalid handle if none
+         */
+        Handle::EntityHandle findWorldMob(const std::string& name);
+
         /**
          * Looks up the handle currently stored inside the given symbol. If it doesn't hold the right type or nothing
          * at all, an invalid handle is returned
@@ -153,6 +201,24 @@ namespace Logic
         Daedalus::GameState::NpcHandle getNPCFromSymbol(const std::string& symName);
         Daedalus::GameState::ItemHandle getItemFromSymbol(const std::string& symName);
         Daedalus::GameState::MusicThemeHandle getMusicThemeFromSymbol(const std::string& symName);
+        Daedalus::GameState::NpcHandle getNPCFromSymbol(size_t sym);
+        Daedalus::GameState::ItemHandle getItemFromSymbol(size_t sym);
+
+        /**
+         * @return Indices of frequently used symbols of the loaded scripts
+         */
+        const CommonSymbols& getCommonSymbols() { return m_CommonSymbols; }
+
+        /**
+         * Looks up the loop- and end-functions of the AI-state with the given main-function.
+         * Results are cached until the next DAT-file gets loaded.
+         */
+        const StateFunctions& getStateFunctions(size_t symMain);
+
+        /**
+         * @return Number of symbol-lookups by name done during the last frame
+         */
+        size_t getNumNameLookupsLastFrame() { return m_NumNameLookupsLastFrame; }
 
         /**
          * (Un)Registers an item-instance currently sitting inside the world
@@ -164,9 +230,20 @@ namespace Logic
         void registerMob(Handle::EntityHandle e);
         void unregisterMob(Handle::EntityHandle e);
 
+        /**
+         * Sets the name the given mob can be found by, see findWorldMob(). To be called whenever its focus-name changes.
+         */
+        void setMobName(Handle::EntityHandle e, const std::string& name);
+
         void registerNpc(Handle::EntityHandle e);
         void unregisterNpc(Handle::EntityHandle e);
 
+        /**
+         * Re-indexes the given NPC under its current display-name, see findWorldNPC(). To be called whenever the
+         * display-name may have changed, ie. after running the instance-constructor or importing the NPC.
+         */
+        void updateNpcName(Handle::EntityHandle e);
+
         /**
          * Applies the given items effects on the given NPC or equips it. Does not delete the item or anything else.
          * @param item Item to apply the effects from
@@ -184,13 +261,9 @@ namespace Logic
          */
         const std::set<Handle::EntityHandle>& getWorldMobs() { return m_WorldMobs; }
         /**
-         * @return Profile data for this frame. (Time by function-symbol)
-         */
-        const std::map<size_t, double>& getProfilingData() { return m_TimeByFunctionSymbol[m_ProfilingDataFrame]; };
-        /**
-         * Resets profiling data for the current frame
+         * @return Profiler measuring the time spent inside the VM
          */
-        void resetProfilingData();
+        ScriptProfiler& getProfiler() { return m_Profiler; }
 
         /**
          * Called when a log-entry was inserted
@@ -205,10 +278,32 @@ namespace Logic
         bool initVMWithLoadedDAT();
 
         /**
-         * Starts/stops profiling on the given function-symbol
+         * Fills m_CommonSymbols and drops symbols cached for the previous DAT-file
+         */
+        void resolveCommonSymbols();
+
+        /**
+         * Must be called by every method taking a symbol-name, for the statistics
+         */
+        void countNameLookup() { m_NumNameLookups++; }
+
+        /**
+         * @return Instance-symbol of the NPC currently stored in 'self', NO_SYMBOL if none
+         */
+        size_t getSelfInstanceSymbol();
+
+        /**
+         * Name-indices of NPCs and mobs. Multiple entities may share a name, the first one registered is found first.
          */
-        void startProfiling(size_t fnSym);
-        void stopProfiling(size_t fnSym);
+        typedef std::unordered_map<World::NameId, std::vector<Handle::EntityHandle>> EntitiesByName;
+        static void addToNameIndex(EntitiesByName& index, World::NameId name, Handle::EntityHandle e);
+        static void removeFromNameIndex(EntitiesByName& index, World::NameId name, Handle::EntityHandle e);
+        static Handle::EntityHandle findInNameIndex(const EntitiesByName& index, World::NameId name);
+
+        /**
+         * @return Whether the current display- or instance-name of the given NPC matches, see findWorldNPC()
+         */
+        bool npcHasName(Handle::EntityHandle e, const std::string& name);
 
         /**
          * Called when an npc got inserted into the world
@@ -247,16 +342,35 @@ namespace Logic
         std::set<Handle::EntityHandle> m_WorldItems;
         std::set<Handle::EntityHandle> m_WorldMobs;
 
+        /**
+         * NPCs by display- and instance-name, mobs by focus-name. The names each entity was indexed with are
+         * remembered, so they can be removed again even if the entity got renamed in the meantime.
+         */
+        EntitiesByName m_NPCsByName;
+        std::map<Handle::EntityHandle, std::array<World::NameId, 2>> m_NameIdsByNPC;
+        EntitiesByName m_MobsByName;
+        std::map<Handle::EntityHandle, World::NameId> m_NameIdByMob;
+
         /**
          * NPC-Entity of the player
          */
         Handle::EntityHandle m_PlayerEntity;
 
+        /**
+         * Resolved symbols, see getCommonSymbols() and getStateFunctions()
+         */
+        CommonSymbols m_CommonSymbols;
+        std::unordered_map<size_t, StateFunctions> m_StateFunctionsBySymbol;
+
+        /**
+         * Symbol-lookups by name done in the current/last frame
+         */
+        size_t m_NumNameLookups;
+        size_t m_NumNameLookupsLastFrame;
+
         /**
          * Profiling
          */
-        std::map<size_t, double> m_TimeByFunctionSymbol[10];
-        std::stack<int64_t> m_TimeStartStack;
-        int m_ProfilingDataFrame;
+        ScriptProfiler m_Profiler;
     };
 }
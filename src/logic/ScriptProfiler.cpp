@@ -0,0 +1,173 @@
+#include "ScriptProfiler.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <bx/timer.h>
+#include <daedalus/DaedalusVM.h>
+#include <ZenLib/daedalus/DATFile.h>
+
+using namespace Logic;
+
+const size_t ScriptProfiler::NO_SYMBOL;
+const uint32_t ScriptProfiler::NO_NODE;
+
+ScriptProfiler::ScriptProfiler()
+    : m_Enabled(false)
+{
+}
+
+void ScriptProfiler::setEnabled(bool enabled)
+{
+    if (enabled && !m_Enabled)
+    {
+        m_Nodes.clear();
+        m_Nodes.push_back({EKind::Function, NO_SYMBOL, NO_SYMBOL, NO_NODE, NO_NODE, NO_NODE, 0, 0});
+    }
+
+    // Calls still running won't be closed
+    m_OpenNodes.clear();
+    m_Enabled = enabled;
+}
+
+void ScriptProfiler::enter(EKind kind, size_t symbol, size_t npcSymbol)
+{
+    if (!m_Enabled)
+        return;
+
+    uint32_t parent = m_OpenNodes.empty() ? 0 : m_OpenNodes.back().node;
+
+    if (npcSymbol == NO_SYMBOL)
+        npcSymbol = m_Nodes[parent].npcSymbol;
+
+    // Children are few, a linear search beats any map here
+    uint32_t node = m_Nodes[parent].firstChild;
+    while (node != NO_NODE)
+    {
+        const Node& n = m_Nodes[node];
+        if (n.kind == kind && n.symbol == symbol && n.npcSymbol == npcSymbol)
+            break;
+
+        node = n.nextSibling;
+    }
+
+    if (node == NO_NODE)
+    {
+        node = (uint32_t)m_Nodes.size();
+        m_Nodes.push_back({kind, symbol, npcSymbol, parent, NO_NODE, m_Nodes[parent].firstChild, 0, 0});
+        m_Nodes[parent].firstChild = node;
+    }
+
+    m_OpenNodes.push_back({node, bx::getHPCounter()});
+}
+
+void ScriptProfiler::leave()
+{
+    // Could happen if the profiler was enabled in the middle of a call
+    if (!m_Enabled || m_OpenNodes.empty())
+        return;
+
+    Node& n = m_Nodes[m_OpenNodes.back().node];
+    n.totalTicks += bx::getHPCounter() - m_OpenNodes.back().start;
+    n.numCalls++;
+
+    m_OpenNodes.pop_back();
+}
+
+void ScriptProfiler::registerExternal(Daedalus::DaedalusVM& vm, const std::string& name, const std::function<void(Daedalus::DaedalusVM&)>& fn)
+{
+    Daedalus::DATFile& dat = vm.getDATFile();
+    size_t symbol = dat.hasSymbolName(name) ? dat.getSymbolIndexByName(name) : NO_SYMBOL;
+
+    vm.registerExternalFunction(name, [this, symbol, fn](Daedalus::DaedalusVM& vm) {
+        Scope scope(*this, EKind::External, symbol, NO_SYMBOL);
+        fn(vm);
+    });
+}
+
+std::string ScriptProfiler::getNodeName(const Node& node, Daedalus::DATFile& dat) const
+{
+    std::string name = node.symbol != NO_SYMBOL ? dat.getSymbolByIndex(node.symbol).name : "<unknown>";
+
+    switch (node.kind)
+    {
+        case EKind::External:
+            return name + " [external]";
+        case EKind::AIState:
+            return name + " [state]";
+        case EKind::Perception:
+            return name + " [perception]";
+        default:
+            return name;
+    }
+}
+
+bool ScriptProfiler::writeFlameGraph(const std::string& file, Daedalus::DATFile& dat) const
+{
+    std::ofstream f(file);
+    if (!f.is_open())
+        return false;
+
+    const double toUs = 1000000.0 / double(bx::getHPFrequency());
+
+    // Walk the tree depth-first, keeping the stack as string
+    std::function<void(uint32_t, const std::string&)> writeNode = [&](uint32_t idx, const std::string& parentStack) {
+        const Node& n = m_Nodes[idx];
+
+        std::string stack;
+        if (n.parent == 0)
+        {
+            // Top-level: Group by NPC first
+            stack = (n.npcSymbol != NO_SYMBOL ? dat.getSymbolByIndex(n.npcSymbol).name : "<global>") + ";";
+        }
+        else
+        {
+            stack = parentStack + ";";
+        }
+
+        stack += getNodeName(n, dat);
+
+        int64_t selfTicks = n.totalTicks;
+        for (uint32_t c = n.firstChild; c != NO_NODE; c = m_Nodes[c].nextSibling)
+        {
+            selfTicks -= m_Nodes[c].totalTicks;
+            writeNode(c, stack);
+        }
+
+        f << stack << " " << (int64_t)(std::max<int64_t>(0, selfTicks) * toUs) << "\n";
+    };
+
+    if (!m_Nodes.empty())
+    {
+        for (uint32_t c = m_Nodes[0].firstChild; c != NO_NODE; c = m_Nodes[c].nextSibling)
+            writeNode(c, "");
+    }
+
+    return true;
+}
+
+std::string ScriptProfiler::getSummary(Daedalus::DATFile& dat, size_t maxEntries) const
+{
+    if (m_Nodes.empty())
+        return "No data recorded";
+
+    std::vector<uint32_t> topLevel;
+    for (uint32_t c = m_Nodes[0].firstChild; c != NO_NODE; c = m_Nodes[c].nextSibling)
+        topLevel.push_back(c);
+
+    std::sort(topLevel.begin(), topLevel.end(), [this](uint32_t a, uint32_t b) {
+        return m_Nodes[a].totalTicks > m_Nodes[b].totalTicks;
+    });
+
+    const double toMs = 1000.0 / double(bx::getHPFrequency());
+
+    std::stringstream ss;
+    for (size_t i = 0; i < std::min(maxEntries, topLevel.size()); i++)
+    {
+        const Node& n = m_Nodes[topLevel[i]];
+
+        ss << (n.npcSymbol != NO_SYMBOL ? dat.getSymbolByIndex(n.npcSymbol).name : "<global>")
+           << ": " << getNodeName(n, dat) << " - " << n.totalTicks * toMs << "ms (" << n.numCalls << " calls)" << std::endl;
+    }
+
+    return ss.str();
+}
@@ -0,0 +1,130 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Daedalus
+{
+    class DaedalusVM;
+    class DATFile;
+}
+
+namespace Logic
+{
+    /**
+     * Measures time spent inside the script-VM. Every call made by the engine into the VM, every external called
+     * by the scripts and every AI-state update is recorded as a node in a call-tree, which is attributed to the NPC
+     * the call was made for. The tree is kept across frames, so repeated calls only update existing nodes.
+     *
+     * Disabled by default. When disabled, every hook costs a single branch.
+     */
+    class ScriptProfiler
+    {
+    public:
+        enum class EKind : uint8_t
+        {
+            Function,
+            External,
+            AIState,
+            Perception
+        };
+
+        /**
+         * RAII-helper for enter/leave
+         */
+        class Scope
+        {
+        public:
+            Scope(ScriptProfiler& profiler, EKind kind, size_t symbol, size_t npcSymbol)
+                : m_Profiler(profiler)
+                , m_Active(profiler.isEnabled())
+            {
+                if (m_Active)
+                    m_Profiler.enter(kind, symbol, npcSymbol);
+            }
+
+            ~Scope()
+            {
+                if (m_Active)
+                    m_Profiler.leave();
+            }
+
+        private:
+            ScriptProfiler& m_Profiler;
+            bool m_Active;
+        };
+
+        static const size_t NO_SYMBOL = static_cast<size_t>(-1);
+
+        ScriptProfiler();
+
+        /**
+         * Starting clears all previously recorded data
+         */
+        void setEnabled(bool enabled);
+        bool isEnabled() const { return m_Enabled; }
+
+        /**
+         * Opens a new node below the currently open one
+         * @param symbol Function, external or state-function
+         * @param npcSymbol Instance-symbol of the NPC this is done for. NO_SYMBOL to inherit it from the parent.
+         */
+        void enter(EKind kind, size_t symbol, size_t npcSymbol = NO_SYMBOL);
+        void leave();
+
+        /**
+         * Registers an external on the given VM which is timed by this profiler whenever it is called
+         */
+        void registerExternal(Daedalus::DaedalusVM& vm, const std::string& name, const std::function<void(Daedalus::DaedalusVM&)>& fn);
+
+        /**
+         * Writes the recorded call-tree in the "collapsed stacks" format, as understood by flamegraph.pl,
+         * speedscope and others. One line per node: NPC;[State;]Function;...;Function <self-time in µs>
+         * @return false, if the file could not be written
+         */
+        bool writeFlameGraph(const std::string& file, Daedalus::DATFile& dat) const;
+
+        /**
+         * @return Summary of the most expensive top-level nodes, for display on the console
+         */
+        std::string getSummary(Daedalus::DATFile& dat, size_t maxEntries) const;
+
+    private:
+
+        struct Node
+        {
+            EKind kind;
+            size_t symbol;
+            size_t npcSymbol;
+
+            uint32_t parent;
+            uint32_t firstChild;
+            uint32_t nextSibling;
+
+            uint32_t numCalls;
+            int64_t totalTicks;
+        };
+
+        struct OpenNode
+        {
+            uint32_t node;
+            int64_t start;
+        };
+
+        static const uint32_t NO_NODE = 0xFFFFFFFF;
+
+        /**
+         * @return Symbol-name for the given node, with a suffix marking its kind
+         */
+        std::string getNodeName(const Node& node, Daedalus::DATFile& dat) const;
+
+        bool m_Enabled;
+
+        /**
+         * Call-tree. Node 0 is the root, children are stored as linked lists.
+         */
+        std::vector<Node> m_Nodes;
+        std::vector<OpenNode> m_OpenNodes;
+    };
+}
@@ -3,6 +3,7 @@
 //
 
 #include "EventManager.h"
+#include <cassert>
 #include <json.hpp>
 #include <ZenLib/utils/logger.h>
 #include <components/Vob.h>
@@ -13,19 +14,30 @@ using namespace Logic;
 using SharedEMessage = std::shared_ptr<Logic::EventMessages::EventMessage>;
 
 EventManager::EventManager(World::WorldInstance& world, Handle::EntityHandle hostVob)
-    : m_World(world)
+    : m_QueueHead(nullptr)
+    , m_QueueTail(nullptr)
     , m_HostVob(hostVob)
+    , m_World(world)
 {
 }
 
+EventManager::~EventManager()
+{
+    // Drop the references the queue holds
+    while (m_QueueHead)
+        unlink(m_QueueHead);
+}
+
 void EventManager::handleMessage(SharedEMessage message, Handle::EntityHandle sourceVob)
 {
 
     message->isFirstRun = true;
 
     // Check if we shall execute this right away
-    if (!message->isJob && (message->isHighPriority || m_EventQueue.empty()))
+    if (!message->isJob && (message->isHighPriority || !m_QueueHead))
     {
+        EventMessages::MessagePools::countMessage(false);
+
         // Pass the message to the host
         sendMessageToHost(message);
 
@@ -44,11 +56,51 @@ void EventManager::handleMessage(SharedEMessage message, Handle::EntityHandle so
             }
         }*/
 
+        EventMessages::MessagePools::countMessage(true);
+
         // Queue this
-        m_EventQueue.push_back(message);
+        enqueue(message);
     }
 }
 
+void EventManager::enqueue(SharedEMessage message)
+{
+    EventMessages::EventMessage* m = message.get();
+    assert(!m->queueHook.self);
+
+    m->queueHook.prev = m_QueueTail;
+    m->queueHook.next = nullptr;
+    m->queueHook.self = std::move(message);
+
+    if (m_QueueTail)
+        m_QueueTail->queueHook.next = m;
+    else
+        m_QueueHead = m;
+
+    m_QueueTail = m;
+}
+
+void EventManager::unlink(EventMessages::EventMessage* message)
+{
+    EventMessages::EventMessage::QueueHook& hook = message->queueHook;
+
+    if (hook.prev)
+        hook.prev->queueHook.next = hook.next;
+    else
+        m_QueueHead = hook.next;
+
+    if (hook.next)
+        hook.next->queueHook.prev = hook.prev;
+    else
+        m_QueueTail = hook.prev;
+
+    hook.prev = nullptr;
+    hook.next = nullptr;
+
+    // Must be last, as this may destroy the message
+    SharedEMessage self = std::move(hook.self);
+}
+
 void EventManager::sendMessageToHost(SharedEMessage message, Handle::EntityHandle sourceVob)
 {
     Vob::VobInformation vob = Vob::asVob(m_World, m_HostVob);
@@ -60,40 +112,40 @@ void EventManager::sendMessageToHost(SharedEMessage message, Handle::EntityHandl
 
 void EventManager::processMessageQueue()
 {
-    // Not using iterators here, because a message might get pushed inside a callback, which
-    // would make them invalid. This has to be done before deleting the message for this very reason.
-    for (size_t i = 0, end = m_EventQueue.size(); i < end; i++)
+    // Messages might get pushed inside a callback. Those are appended to the queue, so only go as far as
+    // the queue reached before. This has to be done before deleting the message for this very reason.
+    EventMessages::EventMessage* last = m_QueueTail;
+    for (EventMessages::EventMessage* ev = m_QueueHead; ev; ev = ev->queueHook.next)
     {
-        if (m_EventQueue[i]->deleted)
+        if (ev->deleted)
         {
-            // Trigger done-callbacks
-            for (auto cb : m_EventQueue[i]->onMessageDone)
+            // Trigger done-callbacks. Callbacks may add more of them, so don't hold on to the vector.
+            for (size_t i = 0; i < ev->onMessageDone.size(); i++)
             {
-                cb.second(cb.first, m_EventQueue[i]);
+                auto cb = ev->onMessageDone[i];
+                cb.second(cb.first, ev->queueHook.self);
             }
         }
+
+        if (ev == last)
+            break;
     }
 
     // Remove deleted messages from last time
-    for (auto it = m_EventQueue.begin(); it != m_EventQueue.end();)
+    for (EventMessages::EventMessage* ev = m_QueueHead; ev;)
     {
-        if ((*it)->deleted)
-        {
-            it = m_EventQueue.erase(it);
-        }
-        else
-        {
-            it++;
-        }
-    }
+        EventMessages::EventMessage* next = ev->queueHook.next;
+
+        if (ev->deleted)
+            unlink(ev);
 
-    if (m_EventQueue.empty())
-        return;
+        ev = next;
+    }
 
-    // Process messages as far as we can
-    for (SharedEMessage ev : m_EventQueue)
+    // Process messages as far as we can. Messages pushed in response are appended and reached by this, too.
+    for (EventMessages::EventMessage* ev = m_QueueHead; ev; ev = ev->queueHook.next)
     {
-        sendMessageToHost(ev);
+        sendMessageToHost(ev->queueHook.self);
 
         // FIXME: This event manager could have been deleted as a reaction to the message! Take care of that!
 
@@ -108,24 +160,17 @@ void EventManager::processMessageQueue()
 
 SharedEMessage EventManager::findLastConvMessageWith(Handle::EntityHandle other)
 {
-    auto begin = m_EventQueue.rbegin();
-    auto end = m_EventQueue.rend();
-    auto lastConvMessageIterator = std::find_if(begin, end, [&](SharedEMessage ev) {
+    for (EventMessages::EventMessage* ev = m_QueueTail; ev; ev = ev->queueHook.prev)
+    {
         if (!ev->isOverlay && ev->messageType == EventMessages::EventMessageType::Conversation)
         {
-            auto conv = std::dynamic_pointer_cast<EventMessages::ConversationMessage>(ev);
-            return conv->target == other;
+            // Type is known from the tag, no need for RTTI
+            if (static_cast<EventMessages::ConversationMessage*>(ev)->target == other)
+                return ev->queueHook.self;
         }
-        return false;
-    });
-    if (lastConvMessageIterator == end)
-    {
-        return nullptr;
-    }
-    else
-    {
-        return *lastConvMessageIterator;
     }
+
+    return nullptr;
 }
 
 bool EventManager::hasConvMessageWith(Handle::EntityHandle other)
@@ -150,7 +195,7 @@ void EventManager::waitForMessage(SharedEMessage other)
 
 void EventManager::clear()
 {
-    for (SharedEMessage ev : m_EventQueue)
+    for (EventMessages::EventMessage* ev = m_QueueHead; ev; ev = ev->queueHook.next)
     {
         ev->deleted = true;
     }
@@ -158,7 +203,7 @@ void EventManager::clear()
 
 bool EventManager::isEmpty()
 {
-    for (SharedEMessage ev : m_EventQueue)
+    for (EventMessages::EventMessage* ev = m_QueueHead; ev; ev = ev->queueHook.next)
     {
         if (!ev->deleted)
             return false;
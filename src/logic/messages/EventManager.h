@@ -3,6 +3,7 @@
 #include <list>
 #include <memory>
 #include "EventMessage.h"
+#include "MessagePool.h"
 #include <handle/HandleDef.h>
 
 namespace World
@@ -18,12 +19,16 @@ namespace Logic
 
     public:
         EventManager(World::WorldInstance& world, Handle::EntityHandle hostVob);
+        ~EventManager();
+
+        EventManager(const EventManager&) = delete;
+        EventManager& operator=(const EventManager&) = delete;
 
         template <typename T>
         std::shared_ptr<T> onMessage(const T& msg, Handle::EntityHandle sourceVob = Handle::EntityHandle::makeInvalidHandle())
         {
-            // Copy over the data from the given message
-            std::shared_ptr<T> copyDerived = std::make_shared<T>(msg);
+            // Copy over the data from the given message, into memory recycled from earlier messages of this type
+            std::shared_ptr<T> copyDerived = std::allocate_shared<T>(EventMessages::PoolAllocator<T>(), msg);
 
             // Handle the message and potentially add it to the queue
             handleMessage(copyDerived, sourceVob);
@@ -86,9 +91,20 @@ namespace Logic
         void sendMessageToHost(SharedEMessage message, Handle::EntityHandle sourceVob = Handle::EntityHandle::makeInvalidHandle());
 
         /**
-         * Events registered and managed here.
+         * Appends the message to the queue
+         */
+        void enqueue(SharedEMessage message);
+
+        /**
+         * Removes the message from the queue. Might destroy the message, if the queue held the last reference.
+         */
+        void unlink(EventMessages::EventMessage* message);
+
+        /**
+         * Events registered and managed here. Intrusive list, linked through EventMessage::queueHook.
          */
-        std::vector<SharedEMessage> m_EventQueue;
+        EventMessages::EventMessage* m_QueueHead;
+        EventMessages::EventMessage* m_QueueTail;
 
         /**
          * Vob this belongs to
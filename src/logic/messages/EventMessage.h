@@ -1,6 +1,9 @@
 #pragma once
 
+#include <functional>
 #include <list>
+#include <memory>
+#include <vector>
 #include "../LogicDef.h"
 #include <ZenLib/daedalus/DaedalusGameState.h>
 #include <audio/AudioWorld.h>
@@ -117,7 +120,25 @@ namespace Logic
             /**
              * External callbacks to trigger if this message gets processed. Must also store the waiting entity.
              */
-            std::list<std::pair<Handle::EntityHandle, std::function<void(Handle::EntityHandle, SharedEMessage)>>> onMessageDone;
+            std::vector<std::pair<Handle::EntityHandle, std::function<void(Handle::EntityHandle, SharedEMessage)>>> onMessageDone;
+
+            /**
+             * Links of the EventManager-queue this message is waiting in. Never copied along with the message.
+             */
+            struct QueueHook
+            {
+                QueueHook() = default;
+                QueueHook(const QueueHook&) {}
+                QueueHook& operator=(const QueueHook&) { return *this; }
+
+                EventMessage* prev = nullptr;
+                EventMessage* next = nullptr;
+
+                /**
+                 * Reference held by the queue while the message is inside
+                 */
+                SharedEMessage self;
+            } queueHook;
         };
 
         struct NpcMessage : public EventMessage
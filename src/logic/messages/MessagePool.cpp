@@ -0,0 +1,38 @@
+#include "MessagePool.h"
+
+using namespace Logic::EventMessages;
+
+std::atomic<uint32_t> MessagePools::s_NumMessages(0);
+std::atomic<uint32_t> MessagePools::s_NumQueued(0);
+std::atomic<uint32_t> MessagePools::s_NumPoolHits(0);
+std::atomic<uint32_t> MessagePools::s_NumAllocations(0);
+MessageStats MessagePools::s_LastFrameStats;
+
+void MessagePools::countMessage(bool queued)
+{
+    s_NumMessages.fetch_add(1, std::memory_order_relaxed);
+
+    if (queued)
+        s_NumQueued.fetch_add(1, std::memory_order_relaxed);
+}
+
+void MessagePools::countAllocation(bool fromPool)
+{
+    if (fromPool)
+        s_NumPoolHits.fetch_add(1, std::memory_order_relaxed);
+    else
+        s_NumAllocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+void MessagePools::endFrame()
+{
+    s_LastFrameStats.numMessages = s_NumMessages.exchange(0, std::memory_order_relaxed);
+    s_LastFrameStats.numQueued = s_NumQueued.exchange(0, std::memory_order_relaxed);
+    s_LastFrameStats.numPoolHits = s_NumPoolHits.exchange(0, std::memory_order_relaxed);
+    s_LastFrameStats.numAllocations = s_NumAllocations.exchange(0, std::memory_order_relaxed);
+}
+
+const MessageStats& MessagePools::getLastFrameStats()
+{
+    return s_LastFrameStats;
+}
@@ -0,0 +1,153 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+namespace Logic
+{
+    namespace EventMessages
+    {
+        /**
+         * Counters of the message-system, summed up over all event-managers
+         */
+        struct MessageStats
+        {
+            // Messages passed to an event-manager
+            uint32_t numMessages = 0;
+
+            // Messages which had to wait in a queue
+            uint32_t numQueued = 0;
+
+            // Messages stored in memory recycled from an earlier message
+            uint32_t numPoolHits = 0;
+
+            // Messages which needed new memory from the heap
+            uint32_t numAllocations = 0;
+        };
+
+        /**
+         * Global bookkeeping of the message-pools
+         */
+        class MessagePools
+        {
+        public:
+            static void countMessage(bool queued);
+            static void countAllocation(bool fromPool);
+
+            /**
+             * Publishes the counters of the current frame and resets them. To be called once per frame.
+             */
+            static void endFrame();
+
+            /**
+             * @return Counters of the last full frame
+             */
+            static const MessageStats& getLastFrameStats();
+
+        private:
+            static std::atomic<uint32_t> s_NumMessages;
+            static std::atomic<uint32_t> s_NumQueued;
+            static std::atomic<uint32_t> s_NumPoolHits;
+            static std::atomic<uint32_t> s_NumAllocations;
+            static MessageStats s_LastFrameStats;
+        };
+
+        /**
+         * Allocator to create messages with std::allocate_shared. Memory of freed messages is kept in a free-list
+         * and handed out again to the next message of the same type, so sending messages doesn't touch the heap
+         * once the pools are warmed up. As allocate_shared places the reference-counts next to the message,
+         * this covers the whole shared_ptr.
+         *
+         * Every type of message gets its own pool. Pools are per thread.
+         */
+        template <typename T>
+        class PoolAllocator
+        {
+        public:
+            using value_type = T;
+
+            PoolAllocator() = default;
+
+            template <typename U>
+            PoolAllocator(const PoolAllocator<U>&)
+            {
+            }
+
+            T* allocate(size_t n)
+            {
+                if (n == 1)
+                {
+                    FreeList& list = getFreeList();
+                    if (!list.blocks.empty())
+                    {
+                        void* p = list.blocks.back();
+                        list.blocks.pop_back();
+
+                        MessagePools::countAllocation(true);
+                        return static_cast<T*>(p);
+                    }
+                }
+
+                MessagePools::countAllocation(false);
+                return static_cast<T*>(::operator new(n * sizeof(T)));
+            }
+
+            void deallocate(T* p, size_t n)
+            {
+                if (n == 1)
+                {
+                    FreeList& list = getFreeList();
+                    if (list.blocks.size() < MAX_FREE_BLOCKS)
+                    {
+                        list.blocks.push_back(p);
+                        return;
+                    }
+                }
+
+                ::operator delete(p);
+            }
+
+            template <typename U>
+            bool operator==(const PoolAllocator<U>&) const
+            {
+                return true;
+            }
+
+            template <typename U>
+            bool operator!=(const PoolAllocator<U>&) const
+            {
+                return false;
+            }
+
+        private:
+            /**
+             * Blocks kept per type. Anything above is given back to the heap.
+             */
+            static const size_t MAX_FREE_BLOCKS = 256;
+
+            struct FreeList
+            {
+                FreeList()
+                {
+                    blocks.reserve(MAX_FREE_BLOCKS);
+                }
+
+                ~FreeList()
+                {
+                    for (void* p : blocks)
+                        ::operator delete(p);
+                }
+
+                std::vector<void*> blocks;
+            };
+
+            static FreeList& getFreeList()
+            {
+                static thread_local FreeList list;
+                return list;
+            }
+        };
+    }
+}
@@ -3,27 +3,36 @@
 //
 
 #include "Externals.h"
+#include <algorithm>
 #include <components/VobClasses.h>
 #include <daedalus/DaedalusStdlib.h>
 #include <daedalus/DaedalusVM.h>
 #include <debugdraw/debugdraw.h>
 #include <engine/GameEngine.h>
+#include <logic/PerceptionSystem.h>
 #include <logic/PlayerController.h>
 #include <logic/visuals/ModelVisual.h>
 #include <ui/Hud.h>
 #include <ui/PrintScreenMessages.h>
 #include <ui/IntroduceChapterView.h>
+#include <utils/EngineLog.h>
 #include <utils/logger.h>
 #include <logic/ScriptEngine.h>
 #include <logic/DialogManager.h>
 
-void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& world, Daedalus::DaedalusVM* vm, bool verbose)
+void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& world, Daedalus::DaedalusVM* vm)
 {
     Engine::BaseEngine* engine = world.getEngine();
     World::WorldInstance* pWorld = &world;
     using Daedalus::GameState::NpcHandle;
     using Daedalus::GameState::ItemHandle;
 
+    // Let the profiler see how much time is spent inside our externals
+    ScriptProfiler& profiler = world.getScriptEngine().getProfiler();
+    auto registerExternal = [vm, &profiler](const std::string& name, const std::function<void(Daedalus::DaedalusVM&)>& fn) {
+        profiler.registerExternal(*vm, name, fn);
+    };
+
     auto isSymInstanceValid = [vm](size_t instance) {
         return vm->getDATFile().getSymbolByIndex(instance).instanceDataHandle.isValid();
     };
@@ -101,12 +110,12 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
     /**
      * Mdl_SetVisual
      */
-    vm->registerExternalFunction("Mdl_SetVisual", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("Mdl_SetVisual", [=](Daedalus::DaedalusVM& vm) {
         std::string visual = vm.popString();
 
         uint32_t arr_self;
         int32_t self = vm.popVar(arr_self);
-        if (verbose) LogInfo() << "self: " << self;
+        RE_LOG_TRACE(Script) << "self: " << self;
 
         // TODO: Need a better API for this
         NpcHandle hnpc = ZMemory::handleCast<NpcHandle>(vm.getDATFile().getSymbolByIndex(self).instanceDataHandle);
@@ -127,7 +136,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
     /**
      * Mdl_SetVisualBody
      */
-    vm->registerExternalFunction("Mdl_SetVisualBody", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("Mdl_SetVisualBody", [=](Daedalus::DaedalusVM& vm) {
 
         int32_t armorInstance = vm.popDataValue();
         int teethTexNr = static_cast<int>(vm.popDataValue());
@@ -139,7 +148,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
 
         uint32_t arr_self;
         int32_t self = vm.popVar(arr_self);
-        if (verbose) LogInfo() << "self: " << self;
+        RE_LOG_TRACE(Script) << "self: " << self;
 
         // TODO: Need a better API for this
         NpcHandle hnpc = ZMemory::handleCast<NpcHandle>(vm.getDATFile().getSymbolByIndex(self).instanceDataHandle);
@@ -153,7 +162,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         {
             VobTypes::ScriptInstanceUserData* userData = reinterpret_cast<VobTypes::ScriptInstanceUserData*>(npcData.userPtr);
 
-            if (verbose) LogInfo() << "Setting visual to: " << body;
+            RE_LOG_TRACE(Script) << "Setting visual to: " << body;
 
             World::WorldInstance& world = engine->getWorldInstance(userData->world);
             VobTypes::NpcVobInformation vob = VobTypes::asNpcVob(world, userData->vobEntity);
@@ -177,22 +186,22 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
     /**
      * ta_min
      */
-    vm->registerExternalFunction("ta_min", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("ta_min", [=](Daedalus::DaedalusVM& vm) {
         std::string waypoint = vm.popString();
-        if (verbose) LogInfo() << "waypoint: " << waypoint;
+        RE_LOG_TRACE(Script) << "waypoint: " << waypoint;
 
         uint32_t action = vm.popDataValue();
         int32_t stop_m = vm.popDataValue();
-        if (verbose) LogInfo() << "stop_m: " << stop_m;
+        RE_LOG_TRACE(Script) << "stop_m: " << stop_m;
         int32_t stop_h = vm.popDataValue();
-        if (verbose) LogInfo() << "stop_h: " << stop_h;
+        RE_LOG_TRACE(Script) << "stop_h: " << stop_h;
         int32_t start_m = vm.popDataValue();
-        if (verbose) LogInfo() << "start_m: " << start_m;
+        RE_LOG_TRACE(Script) << "start_m: " << start_m;
         int32_t start_h = vm.popDataValue();
-        if (verbose) LogInfo() << "start_h: " << start_h;
+        RE_LOG_TRACE(Script) << "start_h: " << start_h;
         uint32_t arr_self;
         int32_t self = vm.popVar(arr_self);
-        if (verbose) LogInfo() << "self: " << self;
+        RE_LOG_TRACE(Script) << "self: " << self;
 
         VobTypes::NpcVobInformation npc = getNPCByInstance(self);
 
@@ -205,7 +214,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
     /**
      * EquipItem
      */
-    vm->registerExternalFunction("equipitem", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("equipitem", [=](Daedalus::DaedalusVM& vm) {
         uint32_t instance = static_cast<uint32_t>(vm.popDataValue());
         uint32_t self = vm.popVar();
 
@@ -226,13 +235,13 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
     /**
      * GetDistTo...
      */
-    vm->registerExternalFunction("npc_getdisttonpc", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("npc_getdisttonpc", [=](Daedalus::DaedalusVM& vm) {
         uint32_t arr_npc2;
         uint32_t npc2 = vm.popVar(arr_npc2);
-        if (verbose) LogInfo() << "npc2: " << npc2;
+        RE_LOG_TRACE(Script) << "npc2: " << npc2;
         uint32_t arr_npc1;
         uint32_t npc1 = vm.popVar(arr_npc1);
-        if (verbose) LogInfo() << "npc1: " << npc1;
+        RE_LOG_TRACE(Script) << "npc1: " << npc1;
 
         if (!isSymInstanceValid(npc1) || !isSymInstanceValid(npc2))
             vm.setReturn(INT32_MAX);
@@ -257,12 +266,12 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
 
     });
 
-    vm->registerExternalFunction("npc_getdisttowp", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("npc_getdisttowp", [=](Daedalus::DaedalusVM& vm) {
         std::string wpname = vm.popString();
-        if (verbose) LogInfo() << "wpname: " << wpname;
+        RE_LOG_TRACE(Script) << "wpname: " << wpname;
         uint32_t arr_self;
         uint32_t self = vm.popVar(arr_self);
-        if (verbose) LogInfo() << "self: " << self;
+        RE_LOG_TRACE(Script) << "self: " << self;
 
         VobTypes::NpcVobInformation vob = getNPCByInstance(self);
 
@@ -294,12 +303,12 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
 
     });
 
-    vm->registerExternalFunction("npc_getdisttoitem", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("npc_getdisttoitem", [=](Daedalus::DaedalusVM& vm) {
 
         uint32_t item = vm.popVar();
         uint32_t arr_npc;
         int32_t npc = vm.popVar(arr_npc);
-        if (verbose) LogInfo() << "npc: " << npc;
+        RE_LOG_TRACE(Script) << "npc: " << npc;
 
         VobTypes::NpcVobInformation npcvob = getNPCByInstance(npc);
         Vob::VobInformation itemvob = getItemByInstance(item);
@@ -318,10 +327,10 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         vm.setReturn(static_cast<int32_t>(dist));
     });
 
-    vm->registerExternalFunction("npc_getdisttoplayer", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("npc_getdisttoplayer", [=](Daedalus::DaedalusVM& vm) {
         uint32_t arr_npc1;
         uint32_t npc1 = vm.popVar(arr_npc1);
-        if (verbose) LogInfo() << "npc1: " << npc1;
+        RE_LOG_TRACE(Script) << "npc1: " << npc1;
 
         VobTypes::NpcVobInformation vob1 = getNPCByInstance(npc1);
         VobTypes::NpcVobInformation vob2 = getNPCByInstance(vm.getDATFile().getSymbolIndexByName("hero"));
@@ -335,7 +344,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         vm.setReturn(static_cast<int32_t>(dist));
     });
 
-    vm->registerExternalFunction("printdebuginstch", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("printdebuginstch", [=](Daedalus::DaedalusVM& vm) {
 
         uint32_t arr_npc;
         std::string s = vm.popString();
@@ -350,7 +359,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         LogInfo() << "DEBUG: " << s;
     });
 
-    vm->registerExternalFunction("ai_teleport", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("ai_teleport", [=](Daedalus::DaedalusVM& vm) {
         std::string waypoint = vm.popString();
         int32_t self = vm.popVar();
 
@@ -361,13 +370,13 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
 
     });
 
-    vm->registerExternalFunction("ai_turntonpc", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("ai_turntonpc", [=](Daedalus::DaedalusVM& vm) {
         uint32_t arr_n1;
         int32_t target = vm.popVar(arr_n1);
-        if (verbose) LogInfo() << "target: " << target;
+        RE_LOG_TRACE(Script) << "target: " << target;
         uint32_t arr_n0;
         int32_t self = vm.popVar(arr_n0);
-        if (verbose) LogInfo() << "self: " << self;
+        RE_LOG_TRACE(Script) << "self: " << self;
 
         if (!isSymInstanceValid(self) || !isSymInstanceValid(target))
             return;
@@ -384,25 +393,25 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         selfvob.playerController->getEM().onMessage(msg);
     });
 
-    /*vm->registerExternalFunction("snd_getdisttosource", [=](Daedalus::DaedalusVM& vm){
+    /*registerExternal("snd_getdisttosource", [=](Daedalus::DaedalusVM& vm){
         uint32_t arr_self;
-        int32_t self = vm.popVar(arr_self); if(verbose) LogInfo() << "self: " << self;
+        int32_t self = vm.popVar(arr_self); RE_LOG_TRACE(Script) << "self: " << self;
         vm.setReturn(0);
     });*/
 
-    vm->registerExternalFunction("printscreen", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("printscreen", [=](Daedalus::DaedalusVM& vm) {
         int32_t timesec = vm.popDataValue();
-        if (verbose) LogInfo() << "timesec: " << timesec;
+        RE_LOG_TRACE(Script) << "timesec: " << timesec;
         std::string font = vm.popString();
-        if (verbose) LogInfo() << "font: " << font;
+        RE_LOG_TRACE(Script) << "font: " << font;
         int32_t posy = vm.popDataValue();
-        if (verbose) LogInfo() << "posy: " << posy;
+        RE_LOG_TRACE(Script) << "posy: " << posy;
         int32_t posx = vm.popDataValue();
-        if (verbose) LogInfo() << "posx: " << posx;
+        RE_LOG_TRACE(Script) << "posx: " << posx;
         std::string msg = vm.popString();
-        if (verbose) LogInfo() << "msg: " << msg;
+        RE_LOG_TRACE(Script) << "msg: " << msg;
         int32_t dialognr = vm.popDataValue();
-        if (verbose) LogInfo() << "dialognr: " << dialognr;
+        RE_LOG_TRACE(Script) << "dialognr: " << dialognr;
 
         pWorld->getPrintScreenManager().printMessageTimed(posx / 100.0f,
                                                           posy / 100.0f,
@@ -410,7 +419,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
                                                           static_cast<double>(timesec));
     });
 
-    vm->registerExternalFunction("hlp_getinstanceid", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("hlp_getinstanceid", [=](Daedalus::DaedalusVM& vm) {
         int32_t sym = vm.popVar();
 
         // Lookup what's behind this symbol. Could be a reference!
@@ -426,9 +435,9 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         }
     });
 
-    vm->registerExternalFunction("npc_isplayer", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("npc_isplayer", [=](Daedalus::DaedalusVM& vm) {
         uint32_t player = vm.popVar();
-        if (verbose) LogInfo() << "player: " << player;
+        RE_LOG_TRACE(Script) << "player: " << player;
 
         VobTypes::NpcVobInformation npc = getNPCByInstance(player);
 
@@ -443,7 +452,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         }
     });
 
-    vm->registerExternalFunction("npc_canseenpc", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("npc_canseenpc", [=](Daedalus::DaedalusVM& vm) {
         uint32_t other = vm.popVar();
         uint32_t self = vm.popVar();
 
@@ -463,7 +472,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
 
     });
 
-    vm->registerExternalFunction("npc_canseenpcfreelos", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("npc_canseenpcfreelos", [=](Daedalus::DaedalusVM& vm) {
         uint32_t other = vm.popVar();
         uint32_t self = vm.popVar();
 
@@ -476,7 +485,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
             vm.setReturn(0);
     });
 
-    vm->registerExternalFunction("npc_canseeitem", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("npc_canseeitem", [=](Daedalus::DaedalusVM& vm) {
 
         uint32_t other = vm.popVar();
         uint32_t self = vm.popVar();
@@ -490,7 +499,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
             vm.setReturn(0);
     });
 
-    vm->registerExternalFunction("npc_clearaiqueue", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("npc_clearaiqueue", [=](Daedalus::DaedalusVM& vm) {
         uint32_t self = vm.popVar();
 
         VobTypes::NpcVobInformation npc = getNPCByInstance(self);
@@ -499,7 +508,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
             npc.playerController->getEM().clear();
     });
 
-    vm->registerExternalFunction("ai_standup", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("ai_standup", [=](Daedalus::DaedalusVM& vm) {
         uint32_t self = vm.popVar();
 
         VobTypes::NpcVobInformation npc = getNPCByInstance(self);
@@ -516,7 +525,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         }
     });
 
-    vm->registerExternalFunction("ai_standupquick", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("ai_standupquick", [=](Daedalus::DaedalusVM& vm) {
         uint32_t self = vm.popVar();
 
         VobTypes::NpcVobInformation npc = getNPCByInstance(self);
@@ -533,12 +542,12 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         }
     });
 
-    vm->registerExternalFunction("npc_exchangeroutine", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("npc_exchangeroutine", [=](Daedalus::DaedalusVM& vm) {
         std::string routinename = vm.popString();
-        if (verbose) LogInfo() << "routinename: " << routinename;
+        RE_LOG_TRACE(Script) << "routinename: " << routinename;
         uint32_t arr_self;
         uint32_t self = vm.popVar(arr_self);
-        if (verbose) LogInfo() << "self: " << self;
+        RE_LOG_TRACE(Script) << "self: " << self;
 
         VobTypes::NpcVobInformation npc = getNPCByInstance(self);
 
@@ -548,7 +557,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         }
     });
 
-    vm->registerExternalFunction("ai_gotowp", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("ai_gotowp", [=](Daedalus::DaedalusVM& vm) {
         std::string wp = vm.popString();
         int32_t self = vm.popVar();
 
@@ -568,7 +577,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         }
     });
 
-    vm->registerExternalFunction("ai_gotonextfp", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("ai_gotonextfp", [=](Daedalus::DaedalusVM& vm) {
         std::string fpname = vm.popString(true);
         int32_t self = vm.popVar();
 
@@ -578,7 +587,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         if (npc.isValid())
         {
             // Find closest fp
-            std::vector<Handle::EntityHandle> fp = pWorld->getFreepointsInRange(npc.position->m_WorldMatrix.Translation(), 20.0f, fpname, true);
+            Memory::FrameVector<Handle::EntityHandle> fp = pWorld->getFreepointsInRange(npc.position->m_WorldMatrix.Translation(), 20.0f, fpname, true);
 
             if(!fp.empty())
             {
@@ -590,7 +599,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         }
     });
 
-    vm->registerExternalFunction("ai_gotofp", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("ai_gotofp", [=](Daedalus::DaedalusVM& vm) {
         std::string fpname = vm.popString(true);
         int32_t self = vm.popVar();
 
@@ -599,7 +608,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         if (npc.isValid())
         {
             // Find closest fp
-            std::vector<Handle::EntityHandle> fp = pWorld->getFreepointsInRange(npc.position->m_WorldMatrix.Translation(), 20.0f, fpname, true);
+            Memory::FrameVector<Handle::EntityHandle> fp = pWorld->getFreepointsInRange(npc.position->m_WorldMatrix.Translation(), 20.0f, fpname, true);
 
             if(!fp.empty())
             {
@@ -612,7 +621,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
 
     });
 
-    vm->registerExternalFunction("ai_gotonpc", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("ai_gotonpc", [=](Daedalus::DaedalusVM& vm) {
         uint32_t other = vm.popVar();
         uint32_t self = vm.popVar();
 
@@ -630,14 +639,14 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         }
     });
 
-    vm->registerExternalFunction("infomanager_hasfinished", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("infomanager_hasfinished", [=](Daedalus::DaedalusVM& vm) {
         vm.setReturn(pWorld->getDialogManager().isDialogActive() ? 0 : 1);
     });
 
-    vm->registerExternalFunction("npc_getnearestwp", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("npc_getnearestwp", [=](Daedalus::DaedalusVM& vm) {
         uint32_t arr_self;
         int32_t self = vm.popVar(arr_self);
-        if (verbose) LogInfo() << "self: " << self;
+        RE_LOG_TRACE(Script) << "self: " << self;
 
         VobTypes::NpcVobInformation npc = getNPCByInstance(self);
 
@@ -655,10 +664,10 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         vm.setReturn("");
     });
 
-    vm->registerExternalFunction("npc_getnextwp", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("npc_getnextwp", [=](Daedalus::DaedalusVM& vm) {
         uint32_t arr_self;
         int32_t self = vm.popVar(arr_self);
-        if (verbose) LogInfo() << "self: " << self;
+        RE_LOG_TRACE(Script) << "self: " << self;
 
         VobTypes::NpcVobInformation npc = getNPCByInstance(self);
 
@@ -676,7 +685,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         vm.setReturn("");
     });
 
-    vm->registerExternalFunction("npc_hasitems", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("npc_hasitems", [=](Daedalus::DaedalusVM& vm) {
         uint32_t iteminstance = vm.popDataValue();
         int32_t owner = vm.popVar();
 
@@ -693,7 +702,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         }
     });
 
-    vm->registerExternalFunction("npc_removeinvitem", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("npc_removeinvitem", [=](Daedalus::DaedalusVM& vm) {
         uint32_t iteminstance = vm.popDataValue();
         uint32_t owner = vm.popVar();
 
@@ -707,7 +716,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         vm.setReturn(0);
     });
 
-    vm->registerExternalFunction("npc_removeinvitems", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("npc_removeinvitems", [=](Daedalus::DaedalusVM& vm) {
         uint32_t amount = vm.popDataValue();
         uint32_t iteminstance = vm.popDataValue();
         uint32_t owner = vm.popVar();
@@ -722,7 +731,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         vm.setReturn(0);
     });
 
-    vm->registerExternalFunction("ai_startstate", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("ai_startstate", [=](Daedalus::DaedalusVM& vm) {
         std::string wpname = vm.popString();
         int32_t statebehaviour = vm.popDataValue();
         uint32_t fnSym = vm.popVar();
@@ -743,7 +752,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         }
     });
 
-    vm->registerExternalFunction("npc_getstatetime", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("npc_getstatetime", [=](Daedalus::DaedalusVM& vm) {
         uint32_t self = vm.popVar();
 
         VobTypes::NpcVobInformation npc = getNPCByInstance(self);
@@ -759,19 +768,19 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         }
     });
 
-    vm->registerExternalFunction("npc_setstatetime", [=](Daedalus::DaedalusVM& vm) {
-        if (verbose) LogInfo() << "npc_setstatetime";
+    registerExternal("npc_setstatetime", [=](Daedalus::DaedalusVM& vm) {
+        RE_LOG_TRACE(Script) << "npc_setstatetime";
         int seconds = vm.popDataValue();
-        if (verbose) LogInfo() << "seconds: " << seconds;
+        RE_LOG_TRACE(Script) << "seconds: " << seconds;
         uint32_t arr_self;
         int32_t self = vm.popVar(arr_self);
-        if (verbose) LogInfo() << "self: " << self;
+        RE_LOG_TRACE(Script) << "self: " << self;
 
         VobTypes::NpcVobInformation npc = getNPCByInstance(self);
         npc.playerController->getAIStateMachine().setCurrentStateTime(seconds);
     });
 
-    vm->registerExternalFunction("wld_detectnpc", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("wld_detectnpc", [=](Daedalus::DaedalusVM& vm) {
         int32_t guild = vm.popDataValue();
         int32_t aiState = vm.popDataValue();
         int32_t instance = vm.popDataValue();
@@ -831,7 +840,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         }
     });
 
-    vm->registerExternalFunction("wld_istime", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("wld_istime", [=](Daedalus::DaedalusVM& vm) {
         int32_t min2 = vm.popDataValue();
         int32_t hour2 = vm.popDataValue();
         int32_t min1 = vm.popDataValue();
@@ -870,7 +879,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         vm.setReturn(inside);
     });
 
-    vm->registerExternalFunction("ai_wait", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("ai_wait", [=](Daedalus::DaedalusVM& vm) {
         float duration = vm.popFloatValue();
         int32_t self = vm.popVar();
 
@@ -886,7 +895,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         }
     });
 
-    vm->registerExternalFunction("ai_playani", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("ai_playani", [=](Daedalus::DaedalusVM& vm) {
         std::string ani = vm.popString();
         uint32_t self = vm.popVar();
 
@@ -913,7 +922,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         }
     });
 
-    vm->registerExternalFunction("ai_setwalkmode", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("ai_setwalkmode", [=](Daedalus::DaedalusVM& vm) {
         using EventMessages::MovementMessage;
 
         int32_t walkmode = vm.popDataValue();
@@ -931,7 +940,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         }
     });
 
-    vm->registerExternalFunction("mdl_applyoverlaymds", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("mdl_applyoverlaymds", [=](Daedalus::DaedalusVM& vm) {
         std::string overlayname = vm.popString();
         uint32_t self = vm.popVar();
 
@@ -943,7 +952,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         }
     });
 
-    vm->registerExternalFunction("mdl_removeoverlaymds", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("mdl_removeoverlaymds", [=](Daedalus::DaedalusVM& vm) {
         std::string overlayname = vm.popString();
         uint32_t self = vm.popVar();
 
@@ -956,7 +965,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         }
     });
 
-    vm->registerExternalFunction("wld_isfpavailable", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("wld_isfpavailable", [=](Daedalus::DaedalusVM& vm) {
         std::string fpname = vm.popString(true);
         int32_t self = vm.popVar();
 
@@ -965,7 +974,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         if (npc.isValid())
         {
             // Find closest fp
-            std::vector<Handle::EntityHandle> fp = pWorld->getFreepointsInRange(npc.position->m_WorldMatrix.Translation(), 20.0f, fpname, true);
+            Memory::FrameVector<Handle::EntityHandle> fp = pWorld->getFreepointsInRange(npc.position->m_WorldMatrix.Translation(), 20.0f, fpname, true);
 
             vm.setReturn(!fp.empty());
         }
@@ -975,7 +984,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         }
     });
 
-    vm->registerExternalFunction("wld_isnextfpavailable", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("wld_isnextfpavailable", [=](Daedalus::DaedalusVM& vm) {
         std::string fpname = vm.popString(true);
         int32_t self = vm.popVar();
 
@@ -984,7 +993,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         if (npc.isValid())
         {
             // Find closest fp
-            std::vector<Handle::EntityHandle> fp = pWorld->getFreepointsInRange(npc.position->m_WorldMatrix.Translation(), 20.0f, fpname, true, npc.entity);
+            Memory::FrameVector<Handle::EntityHandle> fp = pWorld->getFreepointsInRange(npc.position->m_WorldMatrix.Translation(), 20.0f, fpname, true, npc.entity);
 
             vm.setReturn(!fp.empty());
         }
@@ -994,7 +1003,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         }
     });
 
-    vm->registerExternalFunction("npc_isdead", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("npc_isdead", [=](Daedalus::DaedalusVM& vm) {
         int32_t n = vm.popVar();
 
         VobTypes::NpcVobInformation npc = getNPCByInstance(n);
@@ -1009,7 +1018,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         }
     });
 
-    vm->registerExternalFunction("npc_isonfp", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("npc_isonfp", [=](Daedalus::DaedalusVM& vm) {
         std::string fpname = vm.popString(true);
         int32_t self = vm.popVar();
 
@@ -1031,7 +1040,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         }
     });
 
-    vm->registerExternalFunction("npc_gettrueguild", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("npc_gettrueguild", [=](Daedalus::DaedalusVM& vm) {
         int32_t n = vm.popVar();
 
         VobTypes::NpcVobInformation npc = getNPCByInstance(n);
@@ -1047,7 +1056,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         }
     });
 
-    vm->registerExternalFunction("npc_settrueguild", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("npc_settrueguild", [=](Daedalus::DaedalusVM& vm) {
         int32_t guild = vm.popDataValue();
         int32_t n = vm.popVar();
 
@@ -1057,7 +1066,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         vm.setReturn(0);
     });
 
-    vm->registerExternalFunction("info_addchoice", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("info_addchoice", [=](Daedalus::DaedalusVM& vm) {
         uint32_t func = vm.popVar();
         std::string text = vm.popString();
         uint32_t infoInstance = vm.popDataValue();
@@ -1069,7 +1078,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         cInfo.addChoice(Daedalus::GEngineClasses::SubChoice{text, func});
     });
 
-    vm->registerExternalFunction("info_clearchoices", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("info_clearchoices", [=](Daedalus::DaedalusVM& vm) {
         uint32_t infoInstance = vm.popDataValue();
 
         Daedalus::GameState::InfoHandle hInfo = ZMemory::handleCast<Daedalus::GameState::InfoHandle>(
@@ -1079,7 +1088,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         cInfo.subChoices.clear();
     });
 
-    vm->registerExternalFunction("ai_stopprocessinfos", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("ai_stopprocessinfos", [=](Daedalus::DaedalusVM& vm) {
         // the self argument is the NPC, the player is talking with
         uint32_t self = vm.popVar();
         NpcHandle hself = ZMemory::handleCast<NpcHandle>(vm.getDATFile().getSymbolByIndex(self).instanceDataHandle);
@@ -1088,7 +1097,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         pWorld->getDialogManager().queueDialogEndEvent(hself);
     });
 
-    vm->registerExternalFunction("npc_checkinfo", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("npc_checkinfo", [=](Daedalus::DaedalusVM& vm) {
         int important = vm.popDataValue();
         int32_t npc = vm.popVar();
         NpcHandle npcHandle = ZMemory::handleCast<NpcHandle>(vm.getDATFile().getSymbolByIndex(npc).instanceDataHandle);
@@ -1096,7 +1105,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         vm.setReturn(hasInfos);
     });
 
-    vm->registerExternalFunction("wld_insertnpc", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("wld_insertnpc", [=](Daedalus::DaedalusVM& vm) {
         std::string spawnpoint = vm.popString();
         uint32_t npcinstance = vm.popDataValue();
 
@@ -1113,7 +1122,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         vm.getGameState().insertNPC(npcinstance, spawnpoint);
     });
 
-    vm->registerExternalFunction("wld_insertitem", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("wld_insertitem", [=](Daedalus::DaedalusVM& vm) {
         std::string spawnpoint = vm.popString(true);
         uint32_t iteminstance = vm.popDataValue();
 
@@ -1151,7 +1160,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         Vob::setPosition(vob, position);
     });
 
-    vm->registerExternalFunction("npc_changeattribute", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("npc_changeattribute", [=](Daedalus::DaedalusVM& vm) {
         int32_t value = vm.popDataValue();
         int32_t atr = vm.popDataValue();
         uint32_t self = vm.popVar();
@@ -1164,15 +1173,15 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         }
     });
 
-    vm->registerExternalFunction("npc_giveitem", [=](Daedalus::DaedalusVM& vm) {
-        if (verbose) LogInfo() << "npc_giveitem";
+    registerExternal("npc_giveitem", [=](Daedalus::DaedalusVM& vm) {
+        RE_LOG_TRACE(Script) << "npc_giveitem";
 
         uint32_t fromNpcId = vm.popVar();
-        if (verbose) LogInfo() << "from" << fromNpcId;
+        RE_LOG_TRACE(Script) << "from" << fromNpcId;
         uint32_t itemInstance = vm.popVar();
-        if (verbose) LogInfo() << "item" << itemInstance;
+        RE_LOG_TRACE(Script) << "item" << itemInstance;
         uint32_t toNpcId = vm.popVar();
-        if (verbose) LogInfo() << "to" << toNpcId;
+        RE_LOG_TRACE(Script) << "to" << toNpcId;
 
         VobTypes::NpcVobInformation fromNpc = getNPCByInstance(fromNpcId);
         VobTypes::NpcVobInformation toNpc = getNPCByInstance(toNpcId);
@@ -1185,9 +1194,9 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         toNpc.playerController->getInventory().addItem(itemInstance);
     });
 
-    vm->registerExternalFunction("npc_clearinventory", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("npc_clearinventory", [=](Daedalus::DaedalusVM& vm) {
         uint32_t npcId = vm.popVar();
-        if (verbose) LogInfo() << "npc_clearinventory " << npcId;
+        RE_LOG_TRACE(Script) << "npc_clearinventory " << npcId;
 
         VobTypes::NpcVobInformation npc = getNPCByInstance(npcId);
 
@@ -1196,16 +1205,16 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         npc.playerController->getInventory().clear();
     });
 
-    vm->registerExternalFunction("snd_play", [=](Daedalus::DaedalusVM& vm) {
-        if (verbose) LogInfo() << "snd_play";
+    registerExternal("snd_play", [=](Daedalus::DaedalusVM& vm) {
+        RE_LOG_TRACE(Script) << "snd_play";
         std::string s0 = vm.popString();
-        if (verbose) LogInfo() << "s0: " << s0;
+        RE_LOG_TRACE(Script) << "s0: " << s0;
 
         pWorld->getAudioWorld().playSound(s0);
 
     });
 
-    vm->registerExternalFunction("npc_setrefusetalk", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("npc_setrefusetalk", [=](Daedalus::DaedalusVM& vm) {
         // the self argument is the NPC, the player is talking with
         int32_t timeSec = vm.popDataValue();
         uint32_t self = vm.popVar();
@@ -1213,7 +1222,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         npc.playerController->setRefuseTalkTime(timeSec);
     });
 
-    vm->registerExternalFunction("npc_refusetalk", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("npc_refusetalk", [=](Daedalus::DaedalusVM& vm) {
         // the self argument is the NPC, the player is talking with
         uint32_t self = vm.popVar();
 
@@ -1222,8 +1231,8 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         vm.setReturn(isRefusingTalk);
     });
 
-    vm->registerExternalFunction("mob_hasitems", [=](Daedalus::DaedalusVM& vm) {
-        if (verbose) LogInfo() << "mob_hasitems";
+    registerExternal("mob_hasitems", [=](Daedalus::DaedalusVM& vm) {
+        RE_LOG_TRACE(Script) << "mob_hasitems";
         uint32_t iteminstance = (uint32_t)vm.popDataValue();
         std::string mobname = vm.popString();
 
@@ -1240,8 +1249,8 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         }
     });
 
-    vm->registerExternalFunction("npc_isinstate", [=](Daedalus::DaedalusVM& vm) {
-        if (verbose) LogInfo() << "npc_isinstate";
+    registerExternal("npc_isinstate", [=](Daedalus::DaedalusVM& vm) {
+        RE_LOG_TRACE(Script) << "npc_isinstate";
         uint32_t state = (uint32_t)vm.popVar();
         int32_t self = vm.popVar();
 
@@ -1255,12 +1264,20 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         vm.setReturn(v);
     });
 
-    vm->registerExternalFunction("wld_getday", [=](Daedalus::DaedalusVM& vm) {
-        if (verbose) LogInfo() << "wld_getday";
+    registerExternal("wld_getday", [=](Daedalus::DaedalusVM& vm) {
+        RE_LOG_TRACE(Script) << "wld_getday";
         vm.setReturn(pWorld->getEngine()->getGameClock().getDay());
     });
 
-    vm->registerExternalFunction("wld_getguildattitude", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("wld_settime", [=](Daedalus::DaedalusVM& vm) {
+        int32_t min = vm.popDataValue();
+        int32_t hour = vm.popDataValue();
+
+        // Routines notice this through the clock and will be re-evaluated on the next frame
+        pWorld->getEngine()->getGameClock().setTimeOfDay((hour + 24) % 24, min);
+    });
+
+    registerExternal("wld_getguildattitude", [=](Daedalus::DaedalusVM& vm) {
         int32_t victimGuild = vm.popDataValue();
         int32_t aggressorGuild = vm.popDataValue();
         const uint32_t numGuilds = 16;
@@ -1270,8 +1287,81 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         vm.setReturn(attitude);
     });
 
-    vm->registerExternalFunction("npc_hasequippedmeleeweapon", [=](Daedalus::DaedalusVM& vm) {
-        if (verbose) LogInfo() << "npc_hasequippedmeleeweapon";
+    registerExternal("perc_setrange", [=](Daedalus::DaedalusVM& vm) {
+        int32_t range = vm.popDataValue();
+        int32_t percid = vm.popDataValue();
+
+        // Scripts use centimeters
+        pWorld->getPerceptionSystem().setRange(percid, range / 100.0f);
+    });
+
+    registerExternal("npc_percenable", [=](Daedalus::DaedalusVM& vm) {
+        uint32_t fnSym = vm.popVar();
+        int32_t percid = vm.popDataValue();
+        int32_t self = vm.popVar();
+
+        VobTypes::NpcVobInformation npc = getNPCByInstance(self);
+
+        if (npc.isValid())
+            npc.playerController->getPerceptions().functions[percid] = fnSym;
+    });
+
+    registerExternal("npc_percdisable", [=](Daedalus::DaedalusVM& vm) {
+        int32_t percid = vm.popDataValue();
+        int32_t self = vm.popVar();
+
+        VobTypes::NpcVobInformation npc = getNPCByInstance(self);
+
+        if (npc.isValid())
+            npc.playerController->getPerceptions().functions.erase(percid);
+    });
+
+    registerExternal("npc_setperctime", [=](Daedalus::DaedalusVM& vm) {
+        float seconds = vm.popFloatValue();
+        int32_t self = vm.popVar();
+
+        VobTypes::NpcVobInformation npc = getNPCByInstance(self);
+
+        if (npc.isValid())
+        {
+            Logic::NpcPerceptions& p = npc.playerController->getPerceptions();
+            p.interval = seconds;
+            p.timeLeft = std::min(p.timeLeft, seconds);
+        }
+    });
+
+    registerExternal("npc_sendpassiveperc", [=](Daedalus::DaedalusVM& vm) {
+        uint32_t victim = vm.popVar();
+        uint32_t other = vm.popVar();
+        int32_t percid = vm.popDataValue();
+        int32_t self = vm.popVar();
+
+        VobTypes::NpcVobInformation npc = getNPCByInstance(self);
+
+        if (npc.isValid())
+        {
+            Logic::ScriptEngine& s = pWorld->getScriptEngine();
+            pWorld->getPerceptionSystem().sendPassivePerception(npc.entity, percid,
+                                                                s.getNPCFromSymbol(other),
+                                                                s.getNPCFromSymbol(victim));
+        }
+    });
+
+    registerExternal("npc_sendsingleperc", [=](Daedalus::DaedalusVM& vm) {
+        int32_t percid = vm.popDataValue();
+        int32_t target = vm.popVar();
+        uint32_t self = vm.popVar();
+
+        VobTypes::NpcVobInformation npc = getNPCByInstance(target);
+
+        // The sender becomes "other" for the target
+        if (npc.isValid())
+            pWorld->getPerceptionSystem().sendSinglePerception(npc.entity, percid,
+                                                               pWorld->getScriptEngine().getNPCFromSymbol(self));
+    });
+
+    registerExternal("npc_hasequippedmeleeweapon", [=](Daedalus::DaedalusVM& vm) {
+        RE_LOG_TRACE(Script) << "npc_hasequippedmeleeweapon";
         int32_t self = vm.popVar();
 
         VobTypes::NpcVobInformation npc = getNPCByInstance(self);
@@ -1285,7 +1375,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         vm.setReturn(npc.playerController->hasEquippedMeleeWeapon());
     });
 
-    vm->registerExternalFunction("ai_output", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("ai_output", [=](Daedalus::DaedalusVM& vm) {
         std::string outputname = vm.popString();
         uint32_t target = vm.popVar();
         uint32_t self = vm.popVar();
@@ -1298,7 +1388,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         dialogManager.onAIOutput(hself, htarget, message);
     });
 
-    vm->registerExternalFunction("ai_outputsvm", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("ai_outputsvm", [=](Daedalus::DaedalusVM& vm) {
         std::string svmname = vm.popString();
         int32_t target = vm.popVar();
         int32_t self = vm.popVar();
@@ -1321,7 +1411,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
 
     });
 
-    vm->registerExternalFunction("AI_ProcessInfos", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("AI_ProcessInfos", [=](Daedalus::DaedalusVM& vm) {
         uint32_t self = vm.popVar();
 
         NpcHandle hself = ZMemory::handleCast<NpcHandle>(vm.getDATFile().getSymbolByIndex(self).instanceDataHandle);
@@ -1330,7 +1420,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         pWorld->getDialogManager().startDialog(hself, player.playerController->getScriptHandle());
     });
 
-    vm->registerExternalFunction("npc_knowsinfo", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("npc_knowsinfo", [=](Daedalus::DaedalusVM& vm) {
         int32_t infoinstance = vm.popDataValue();
         int32_t self = vm.popVar();
 
@@ -1345,9 +1435,9 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         vm.setReturn(knows);
     });
 
-    vm->registerExternalFunction("createinvitem", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("createinvitem", [=](Daedalus::DaedalusVM& vm) {
         uint32_t itemInstance = (uint32_t)vm.popDataValue();
-        if (verbose) LogInfo() << "itemInstance: " << itemInstance;
+        RE_LOG_TRACE(Script) << "itemInstance: " << itemInstance;
         uint32_t arr_n0;
         int32_t npc = vm.popVar(arr_n0);
 
@@ -1364,10 +1454,10 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
          */
     });
 
-    vm->registerExternalFunction("createinvitems", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("createinvitems", [=](Daedalus::DaedalusVM& vm) {
         uint32_t num = (uint32_t)vm.popDataValue();
         uint32_t itemInstance = (uint32_t)vm.popDataValue();
-        if (verbose) LogInfo() << "itemInstance: " << itemInstance;
+        RE_LOG_TRACE(Script) << "itemInstance: " << itemInstance;
         uint32_t arr_n0;
         int32_t npc = vm.popVar(arr_n0);
 
@@ -1376,9 +1466,9 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         vm.getGameState().createInventoryItem(itemInstance, hnpc, num);
     });
 
-    vm->registerExternalFunction("hlp_getnpc", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("hlp_getnpc", [=](Daedalus::DaedalusVM& vm) {
         int32_t instancename = vm.popDataValue();
-        if (verbose) LogInfo() << "instancename: " << instancename;
+        RE_LOG_TRACE(Script) << "instancename: " << instancename;
 
         /*if(!vm.getDATFile().getSymbolByIndex(instancename).instanceDataHandle.isValid())
         {
@@ -1393,7 +1483,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         vm.setReturnVar(instancename);
     });
 
-    vm->registerExternalFunction("hlp_isvalidnpc", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("hlp_isvalidnpc", [=](Daedalus::DaedalusVM& vm) {
         int32_t self = vm.popVar();
 
         if (vm.getDATFile().getSymbolByIndex(self).instanceDataHandle.isValid())
@@ -1406,7 +1496,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         }
     });
 
-    vm->registerExternalFunction("Log_CreateTopic", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("Log_CreateTopic", [=](Daedalus::DaedalusVM& vm) {
         int32_t section = vm.popDataValue();
         std::string topicName = vm.popString();
 
@@ -1414,7 +1504,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         logManager.createTopic(topicName, static_cast<Daedalus::GameState::LogTopic::ESection>(section));
     });
 
-    vm->registerExternalFunction("Log_SetTopicStatus", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("Log_SetTopicStatus", [=](Daedalus::DaedalusVM& vm) {
         int32_t status = vm.popDataValue();
         std::string topicName = vm.popString();
 
@@ -1422,7 +1512,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         logManager.setTopicStatus(topicName, static_cast<Daedalus::GameState::LogTopic::ELogStatus>(status));
     });
 
-    vm->registerExternalFunction("Log_AddEntry", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("Log_AddEntry", [=](Daedalus::DaedalusVM& vm) {
         std::string entry = vm.popString();
         std::string topicName = vm.popString();
 
@@ -1437,45 +1527,45 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         pWorld->getScriptEngine().onLogEntryAdded(topicName, entry);
     });
 
-    vm->registerExternalFunction("inttostring", [](Daedalus::DaedalusVM& vm) {
+    registerExternal("inttostring", [](Daedalus::DaedalusVM& vm) {
         int32_t x = vm.popDataValue();
 
         vm.setReturn(std::to_string(x));
     });
 
-    vm->registerExternalFunction("floattoint", [](Daedalus::DaedalusVM& vm) {
+    registerExternal("floattoint", [](Daedalus::DaedalusVM& vm) {
         int32_t x = vm.popDataValue();
         float f = reinterpret_cast<float&>(x);
         vm.setReturn(static_cast<int32_t>(f));
     });
 
-    vm->registerExternalFunction("inttofloat", [](Daedalus::DaedalusVM& vm) {
+    registerExternal("inttofloat", [](Daedalus::DaedalusVM& vm) {
         int32_t x = vm.popDataValue();
         float f = static_cast<float>(x);
         vm.setReturn(reinterpret_cast<int32_t&>(f));
     });
 
-    vm->registerExternalFunction("concatstrings", [](Daedalus::DaedalusVM& vm) {
+    registerExternal("concatstrings", [](Daedalus::DaedalusVM& vm) {
         std::string s2 = vm.popString();
         std::string s1 = vm.popString();
 
         vm.setReturn(s1 + s2);
     });
 
-    vm->registerExternalFunction("hlp_strcmp", [](Daedalus::DaedalusVM& vm) {
+    registerExternal("hlp_strcmp", [](Daedalus::DaedalusVM& vm) {
         std::string s1 = vm.popString();
         std::string s2 = vm.popString();
 
         vm.setReturn(s1 == s2 ? 1 : 0);
     });
 
-    vm->registerExternalFunction("hlp_random", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("hlp_random", [=](Daedalus::DaedalusVM& vm) {
         int32_t n0 = vm.popDataValue();
 
         vm.setReturn(rand() % n0);
     });
 
-    vm->registerExternalFunction("npc_settofightmode", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("npc_settofightmode", [=](Daedalus::DaedalusVM& vm) {
         size_t weaponSymbol = (size_t)vm.popDataValue();
         size_t self = (size_t)vm.popVar();
 
@@ -1494,7 +1584,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         }
     });
 
-    vm->registerExternalFunction("npc_settofistmode", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("npc_settofistmode", [=](Daedalus::DaedalusVM& vm) {
         uint32_t arr_self;
         int32_t self = vm.popVar(arr_self);
 
@@ -1506,7 +1596,7 @@ void ::Logic::ScriptExternals::registerEngineExternals(World::WorldInstance& wor
         }
     });
 
-    vm->registerExternalFunction("introducechapter", [=](Daedalus::DaedalusVM& vm) {
+    registerExternal("introducechapter", [=](Daedalus::DaedalusVM& vm) {
 
         double waittime = vm.popDataValue();
         std::string sound = vm.popString();
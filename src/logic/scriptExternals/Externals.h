@@ -21,6 +21,6 @@ namespace Logic
         /**
          * Registers our externals
          */
-        void registerEngineExternals(World::WorldInstance& world, Daedalus::DaedalusVM* vm, bool verbose = false);
+        void registerEngineExternals(World::WorldInstance& world, Daedalus::DaedalusVM* vm);
     }
 }
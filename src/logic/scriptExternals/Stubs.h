@@ -7,11 +7,14 @@ namespace Daedalus
 
 namespace Logic
 {
+    class ScriptProfiler;
+
     namespace ScriptExternals
     {
         /**
          * Registers stubs for most known script externals
+         * @param profiler Profiler timing the calls to the stubs
          */
-        void registerStubs(Daedalus::DaedalusVM& vm, bool verbose = false);
+        void registerStubs(Daedalus::DaedalusVM& vm, ScriptProfiler& profiler);
     }
 }
\ No newline at end of file
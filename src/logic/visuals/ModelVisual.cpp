@@ -3,7 +3,7 @@
 #include <components/EntityActions.h>
 #include <components/Vob.h>
 #include <content/ContentLoad.h>
-#include <content/SkeletalMeshAllocator.h>
+#include <content/AssetCache.h>
 #include <engine/BaseEngine.h>
 #include <engine/GameEngine.h>
 #include <engine/World.h>
@@ -7,6 +7,7 @@
 #include <ZenLib/utils/logger.h>
 #include <bx/math.h>
 #include <components/EntityActions.h>
+#include <content/AssetCache.h>
 #include <debugdraw/debugdraw.h>
 #include <engine/BaseEngine.h>
 #include <engine/World.h>
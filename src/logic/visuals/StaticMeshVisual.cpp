@@ -1,6 +1,7 @@
 #include "StaticMeshVisual.h"
 #include <components/EntityActions.h>
 #include <components/Vob.h>
+#include <content/AssetCache.h>
 #include <content/ContentLoad.h>
 #include <engine/GameEngine.h>
 #include <engine/World.h>
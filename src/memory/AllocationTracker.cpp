@@ -0,0 +1,261 @@
+#include "AllocationTracker.h"
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <new>
+#include <sstream>
+
+using namespace Memory;
+
+namespace
+{
+    struct TagCounters
+    {
+        std::atomic<uint64_t> liveBytes;
+        std::atomic<uint64_t> peakBytes;
+        std::atomic<uint64_t> numAllocations;
+        std::atomic<uint32_t> numFrameAllocations;
+        std::atomic<uint64_t> numFrameBytes;
+    };
+
+    /**
+     * Zero-initialized before any constructor runs, so allocations made during static initialization are safe to count
+     */
+    TagCounters s_Counters[AllocationTracker::Tag_Count];
+
+    /**
+     * Published by endFrame(), main-thread only
+     */
+    AllocationTracker::TagStats s_LastFrame[AllocationTracker::Tag_Count];
+    uint32_t s_Frame = 0;
+
+    thread_local AllocationTracker::ETag s_CurrentTag = AllocationTracker::Tag_Other;
+}
+
+#ifdef RE_TRACK_ALLOCATIONS
+namespace
+{
+    /**
+     * Placed in front of every block. Padded, so the memory handed out keeps the alignment malloc guarantees.
+     */
+    struct Header
+    {
+        uint64_t size;
+        AllocationTracker::ETag tag;
+    };
+
+    const size_t HEADER_SIZE = 16;
+    static_assert(sizeof(Header) <= HEADER_SIZE, "Header doesn't fit");
+
+    void* trackedAlloc(size_t size)
+    {
+        void* p;
+        while (!(p = std::malloc(size + HEADER_SIZE)))
+        {
+            std::new_handler handler = std::get_new_handler();
+            if (!handler)
+                return nullptr;
+
+            handler();
+        }
+
+        Header* h = static_cast<Header*>(p);
+        h->size = size;
+        h->tag = s_CurrentTag;
+
+        TagCounters& c = s_Counters[h->tag];
+        uint64_t live = c.liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+        c.numAllocations.fetch_add(1, std::memory_order_relaxed);
+        c.numFrameAllocations.fetch_add(1, std::memory_order_relaxed);
+        c.numFrameBytes.fetch_add(size, std::memory_order_relaxed);
+
+        uint64_t peak = c.peakBytes.load(std::memory_order_relaxed);
+        while (live > peak && !c.peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+        {
+        }
+
+        return static_cast<uint8_t*>(p) + HEADER_SIZE;
+    }
+
+    void trackedFree(void* p)
+    {
+        if (!p)
+            return;
+
+        Header* h = reinterpret_cast<Header*>(static_cast<uint8_t*>(p) - HEADER_SIZE);
+        s_Counters[h->tag].liveBytes.fetch_sub(h->size, std::memory_order_relaxed);
+
+        std::free(h);
+    }
+}
+
+// Replacements of the global operators. These live in the same file as the rest of the tracker, so the linker pulls
+// them out of the static engine-library along with AllocationTracker::endFrame().
+
+void* operator new(size_t size)
+{
+    void* p = trackedAlloc(size);
+    if (!p)
+        throw std::bad_alloc();
+
+    return p;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return trackedAlloc(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return trackedAlloc(size);
+}
+
+void operator delete(void* p) noexcept
+{
+    trackedFree(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    trackedFree(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+    trackedFree(p);
+}
+
+void operator delete[](void* p, size_t) noexcept
+{
+    trackedFree(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+    trackedFree(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+    trackedFree(p);
+}
+#endif
+
+AllocationTracker::Scope::Scope(ETag tag)
+    : m_Previous(s_CurrentTag)
+{
+    s_CurrentTag = tag;
+}
+
+AllocationTracker::Scope::~Scope()
+{
+    s_CurrentTag = m_Previous;
+}
+
+bool AllocationTracker::isEnabled()
+{
+#ifdef RE_TRACK_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+const char* AllocationTracker::getTagName(ETag tag)
+{
+    switch (tag)
+    {
+        case Tag_Other:
+            return "Other";
+        case Tag_WorldLoad:
+            return "World loading";
+        case Tag_Render:
+            return "Rendering";
+        case Tag_Audio:
+            return "Audio";
+        case Tag_Script:
+            return "Scripts";
+        case Tag_Physics:
+            return "Physics";
+        default:
+            return "Unknown";
+    }
+}
+
+void AllocationTracker::endFrame()
+{
+    s_Frame++;
+
+    for (int i = 0; i < Tag_Count; i++)
+    {
+        TagStats& s = s_LastFrame[i];
+        s.numFrameAllocations = s_Counters[i].numFrameAllocations.exchange(0, std::memory_order_relaxed);
+        s.numFrameBytes = s_Counters[i].numFrameBytes.exchange(0, std::memory_order_relaxed);
+
+        if (s.numFrameAllocations > s.maxFrameAllocations)
+        {
+            s.maxFrameAllocations = s.numFrameAllocations;
+            s.maxFrame = s_Frame;
+        }
+    }
+}
+
+AllocationTracker::TagStats AllocationTracker::getStats(ETag tag)
+{
+    TagStats s = s_LastFrame[tag];
+    s.liveBytes = s_Counters[tag].liveBytes.load(std::memory_order_relaxed);
+    s.peakBytes = s_Counters[tag].peakBytes.load(std::memory_order_relaxed);
+    s.numAllocations = s_Counters[tag].numAllocations.load(std::memory_order_relaxed);
+
+    return s;
+}
+
+std::string AllocationTracker::getReport()
+{
+    if (!isEnabled())
+        return "Allocation-tracking is disabled, build with REGOTH_TRACK_ALLOCATIONS";
+
+    std::stringstream ss;
+    ss << std::left << std::setw(16) << "Tag"
+       << std::right << std::setw(12) << "Live KB"
+       << std::setw(12) << "Peak KB"
+       << std::setw(14) << "Allocations"
+       << std::setw(12) << "Last frame"
+       << std::setw(12) << "Frame KB"
+       << std::setw(20) << "Worst frame" << std::endl;
+
+    for (int i = 0; i < Tag_Count; i++)
+    {
+        TagStats s = getStats(static_cast<ETag>(i));
+
+        ss << std::left << std::setw(16) << getTagName(static_cast<ETag>(i))
+           << std::right << std::setw(12) << s.liveBytes / 1024
+           << std::setw(12) << s.peakBytes / 1024
+           << std::setw(14) << s.numAllocations
+           << std::setw(12) << s.numFrameAllocations
+           << std::setw(12) << s.numFrameBytes / 1024
+           << std::setw(20) << (std::to_string(s.maxFrameAllocations) + " (#" + std::to_string(s.maxFrame) + ")") << std::endl;
+    }
+
+    return ss.str();
+}
+
+bool AllocationTracker::writeReport(const std::string& file)
+{
+    std::ofstream f(file);
+    if (!f)
+        return false;
+
+    f << "Allocations after " << s_Frame << " frames" << std::endl
+      << std::endl
+      << getReport();
+
+    return f.good();
+}
@@ -0,0 +1,104 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+/**
+ * Attributes all heap-allocations of the calling thread to the given tag, until the end of the current block.
+ * The innermost scope wins. Compiles to nothing unless the engine is built with REGOTH_TRACK_ALLOCATIONS.
+ */
+#define RE_ALLOCATION_CONCAT_INNER(a, b) a##b
+#define RE_ALLOCATION_CONCAT(a, b) RE_ALLOCATION_CONCAT_INNER(a, b)
+
+#ifdef RE_TRACK_ALLOCATIONS
+#define RE_ALLOCATION_SCOPE(tag) Memory::AllocationTracker::Scope RE_ALLOCATION_CONCAT(_allocationScope, __LINE__)(Memory::AllocationTracker::tag)
+#else
+#define RE_ALLOCATION_SCOPE(tag)
+#endif
+
+namespace Memory
+{
+    /**
+     * Counts every allocation going through operator new/delete, split up by the subsystem it was made for.
+     *
+     * Opt-in at compile time via the CMake-option REGOTH_TRACK_ALLOCATIONS, which replaces the global operators
+     * new and delete. Every block then carries a small header remembering its size and tag, so freeing it later
+     * is subtracted from the right subsystem, no matter which thread or scope does it. Bullet is routed through
+     * operator new as well. Without the option, nothing is replaced and all functions here report empty stats.
+     */
+    namespace AllocationTracker
+    {
+        enum ETag : uint8_t
+        {
+            Tag_Other,  // Anything outside of a scope
+            Tag_WorldLoad,
+            Tag_Render,
+            Tag_Audio,
+            Tag_Script,
+            Tag_Physics,
+
+            Tag_Count
+        };
+
+        struct TagStats
+        {
+            // Currently allocated
+            uint64_t liveBytes = 0;
+            uint64_t peakBytes = 0;
+
+            // Since the start of the program
+            uint64_t numAllocations = 0;
+
+            // During the last full frame
+            uint32_t numFrameAllocations = 0;
+            uint64_t numFrameBytes = 0;
+
+            // Frame with the most allocations so far, to find allocation-storms
+            uint32_t maxFrameAllocations = 0;
+            uint32_t maxFrame = 0;
+        };
+
+        /**
+         * RAII-helper, see RE_ALLOCATION_SCOPE
+         */
+        class Scope
+        {
+        public:
+            Scope(ETag tag);
+            ~Scope();
+
+        private:
+            ETag m_Previous;
+        };
+
+        /**
+         * @return Whether the engine was built with allocation-tracking
+         */
+        bool isEnabled();
+
+        /**
+         * @return Readable name of the given tag
+         */
+        const char* getTagName(ETag tag);
+
+        /**
+         * Publishes the per-frame counters and resets them. To be called once per frame.
+         */
+        void endFrame();
+
+        /**
+         * @return Current counters of the given tag
+         */
+        TagStats getStats(ETag tag);
+
+        /**
+         * @return Table of the counters of all tags, for the console and the report
+         */
+        std::string getReport();
+
+        /**
+         * Writes getReport() to the given file
+         * @return false, if the file couldn't be written
+         */
+        bool writeReport(const std::string& file);
+    }
+}
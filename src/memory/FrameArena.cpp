@@ -0,0 +1,169 @@
+#include "FrameArena.h"
+#include <algorithm>
+#include <new>
+
+using namespace Memory;
+
+std::atomic<uint32_t> FrameArena::s_Frame(0);
+std::atomic<uint32_t> FrameArena::s_NumAllocations(0);
+std::atomic<uint64_t> FrameArena::s_NumBytes(0);
+std::atomic<uint32_t> FrameArena::s_NumHeapBlocks(0);
+FrameArenaStats FrameArena::s_LastFrameStats;
+
+namespace
+{
+    /**
+     * Size of the first block of an arena. Most threads never need more than that.
+     */
+    const size_t MIN_BLOCK_SIZE = 64 * 1024;
+
+    class Arena
+    {
+    public:
+        ~Arena()
+        {
+            for (Block& b : m_Blocks)
+                ::operator delete(b.data);
+        }
+
+        /**
+         * @param newBlock Set to true, if a block had to be taken from the heap
+         */
+        void* allocate(size_t size, size_t alignment, bool& newBlock)
+        {
+            if (!m_Blocks.empty())
+            {
+                Block& b = m_Blocks.back();
+                size_t offset = (m_Used + alignment - 1) & ~(alignment - 1);
+                if (offset + size <= b.size)
+                {
+                    m_Used = offset + size;
+                    return b.data + offset;
+                }
+            }
+
+            // Operator new aligns for any fundamental type, which covers everything the allocator is used with
+            size_t blockSize = std::max(MIN_BLOCK_SIZE, size);
+            if (!m_Blocks.empty())
+                blockSize = std::max(blockSize, m_Blocks.back().size * 2);
+
+            m_Blocks.push_back({static_cast<uint8_t*>(::operator new(blockSize)), blockSize});
+            m_Used = size;
+            newBlock = true;
+
+            return m_Blocks.back().data;
+        }
+
+        void deallocate(void* p, size_t size)
+        {
+            if (m_Blocks.empty())
+                return;
+
+            uint8_t* top = m_Blocks.back().data + m_Used;
+            if (size <= m_Used && static_cast<uint8_t*>(p) + size == top)
+                m_Used -= size;
+        }
+
+        /**
+         * Forgets everything allocated so far. Multiple blocks are merged into one, so the next frame fits.
+         * @param newBlock Set to true, if a block had to be taken from the heap
+         */
+        void reset(bool& newBlock)
+        {
+            if (m_Blocks.size() > 1)
+            {
+                size_t total = 0;
+                for (Block& b : m_Blocks)
+                {
+                    total += b.size;
+                    ::operator delete(b.data);
+                }
+
+                m_Blocks.clear();
+                m_Blocks.push_back({static_cast<uint8_t*>(::operator new(total)), total});
+                newBlock = true;
+            }
+
+            m_Used = 0;
+        }
+
+    private:
+        struct Block
+        {
+            uint8_t* data;
+            size_t size;
+        };
+
+        std::vector<Block> m_Blocks;
+
+        /**
+         * Bytes used of the last block
+         */
+        size_t m_Used = 0;
+    };
+
+    struct ThreadArenas
+    {
+        Arena arenas[2];
+        unsigned current = 0;
+
+        /**
+         * Value of FrameArena::s_Frame when the current arena was last reset
+         */
+        uint32_t frame = 0;
+    };
+
+    ThreadArenas& getThreadArenas()
+    {
+        static thread_local ThreadArenas arenas;
+        return arenas;
+    }
+}
+
+void* FrameArena::allocate(size_t size, size_t alignment)
+{
+    ThreadArenas& t = getThreadArenas();
+    bool newBlock = false;
+
+    // Threads which didn't allocate for a while still only flip once, which keeps more than needed alive, but never less
+    uint32_t frame = s_Frame.load(std::memory_order_relaxed);
+    if (t.frame != frame)
+    {
+        t.frame = frame;
+        t.current ^= 1;
+        t.arenas[t.current].reset(newBlock);
+    }
+
+    void* p = t.arenas[t.current].allocate(std::max(size, size_t(1)), alignment, newBlock);
+
+    s_NumAllocations.fetch_add(1, std::memory_order_relaxed);
+    s_NumBytes.fetch_add(size, std::memory_order_relaxed);
+
+    if (newBlock)
+        s_NumHeapBlocks.fetch_add(1, std::memory_order_relaxed);
+
+    return p;
+}
+
+void FrameArena::deallocate(void* p, size_t size)
+{
+    ThreadArenas& t = getThreadArenas();
+
+    // Memory of the previous frame or another thread can't be the top of the current arena
+    if (t.frame == s_Frame.load(std::memory_order_relaxed))
+        t.arenas[t.current].deallocate(p, std::max(size, size_t(1)));
+}
+
+void FrameArena::endFrame()
+{
+    s_LastFrameStats.numAllocations = s_NumAllocations.exchange(0, std::memory_order_relaxed);
+    s_LastFrameStats.numBytes = s_NumBytes.exchange(0, std::memory_order_relaxed);
+    s_LastFrameStats.numHeapBlocks = s_NumHeapBlocks.exchange(0, std::memory_order_relaxed);
+
+    s_Frame.fetch_add(1, std::memory_order_relaxed);
+}
+
+const FrameArenaStats& FrameArena::getLastFrameStats()
+{
+    return s_LastFrameStats;
+}
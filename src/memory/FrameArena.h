@@ -0,0 +1,117 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Memory
+{
+    /**
+     * Counters of the frame-arenas, summed up over all threads
+     */
+    struct FrameArenaStats
+    {
+        // Allocations served by an arena, which would have gone to the heap otherwise
+        uint32_t numAllocations = 0;
+
+        // Bytes handed out by the arenas
+        uint64_t numBytes = 0;
+
+        // Blocks the arenas had to take from the heap, because they ran full
+        uint32_t numHeapBlocks = 0;
+    };
+
+    /**
+     * Linear allocator for short-lived containers of hot paths, like search-results which are only looked at by the
+     * caller. Allocating is a pointer-bump inside a block kept from frame to frame, freeing does nothing, except for
+     * the most recent allocation, which is taken back so a growing vector doesn't waste its old storage.
+     *
+     * Every thread has its own pair of arenas. One is handed out from during the current frame, the other still holds
+     * what was allocated during the last frame. At the start of the next frame, the older one is reset and becomes the
+     * current one. So memory taken from here stays valid until the end of the frame after the one it was allocated in,
+     * and must not be kept any longer than that.
+     *
+     * Should an arena run full, it takes another block from the heap. Once reset, it replaces its blocks by a single
+     * one large enough for all of them, so the heap isn't touched anymore once the arenas have grown to fit a frame.
+     */
+    class FrameArena
+    {
+    public:
+        /**
+         * @return Memory from the arena of the calling thread, valid until the end of the next frame
+         */
+        static void* allocate(size_t size, size_t alignment);
+
+        /**
+         * Takes the memory back, if it was the last allocation made by the calling thread. Does nothing otherwise.
+         */
+        static void deallocate(void* p, size_t size);
+
+        /**
+         * Publishes the counters of the current frame, resets them and moves all threads on to their other arena.
+         * To be called once per frame.
+         */
+        static void endFrame();
+
+        /**
+         * @return Counters of the last full frame
+         */
+        static const FrameArenaStats& getLastFrameStats();
+
+    private:
+        /**
+         * Incremented by every endFrame(). Threads compare it to the frame they last allocated in.
+         */
+        static std::atomic<uint32_t> s_Frame;
+
+        static std::atomic<uint32_t> s_NumAllocations;
+        static std::atomic<uint64_t> s_NumBytes;
+        static std::atomic<uint32_t> s_NumHeapBlocks;
+        static FrameArenaStats s_LastFrameStats;
+    };
+
+    /**
+     * STL-allocator taking its memory from the FrameArena. Containers using it must not outlive the next frame.
+     */
+    template <typename T>
+    class FrameAllocator
+    {
+    public:
+        using value_type = T;
+
+        FrameAllocator() = default;
+
+        template <typename U>
+        FrameAllocator(const FrameAllocator<U>&)
+        {
+        }
+
+        T* allocate(size_t n)
+        {
+            return static_cast<T*>(FrameArena::allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T* p, size_t n)
+        {
+            FrameArena::deallocate(p, n * sizeof(T));
+        }
+
+        template <typename U>
+        bool operator==(const FrameAllocator<U>&) const
+        {
+            return true;
+        }
+
+        template <typename U>
+        bool operator!=(const FrameAllocator<U>&) const
+        {
+            return false;
+        }
+    };
+
+    /**
+     * Vector for results which are only needed during the current frame
+     */
+    template <typename T>
+    using FrameVector = std::vector<T, FrameAllocator<T>>;
+}
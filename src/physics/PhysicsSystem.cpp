@@ -6,18 +6,53 @@
 #include "DebugDrawer.h"
 #include <BulletCollision/CollisionShapes/btConvexHullShape.h>
 #include <BulletCollision/CollisionShapes/btShapeHull.h>
+#include <bx/timer.h>
+#include <content/BakeCache.h>
 #include <components/EntityActions.h>
+#include <engine/BaseEngine.h>
 #include <engine/World.h>
 #include <logic/Controller.h>
 #include <logic/VisualController.h>
+#include <memory/AllocationTracker.h>
+#include <utils/FrameProfiler.h>
+#include <utils/logger.h>
 
 using namespace Physics;
 
 const int NUM_MAX_SUB_STEPS = 3;
 
+#ifdef RE_TRACK_ALLOCATIONS
+namespace
+{
+    /**
+     * Bullet allocates through malloc by default. Route it through operator new instead, so the allocation-tracker
+     * sees its memory. Installed during static initialization, before bullet allocates anything.
+     */
+    struct BulletAllocationHook
+    {
+        BulletAllocationHook()
+        {
+            btAlignedAllocSetCustom(&allocate, &free);
+        }
+
+        static void* allocate(size_t size)
+        {
+            return ::operator new(size);
+        }
+
+        static void free(void* p)
+        {
+            ::operator delete(p);
+        }
+    } s_BulletAllocationHook;
+}
+#endif
+
 PhysicsSystem::PhysicsSystem(World::WorldInstance& world, float gravity)
     : m_World(world)
 {
+    RE_ALLOCATION_SCOPE(Tag_Physics);
+
     m_pPairCache = new btSortedOverlappingPairCache;
     m_pBroadphase = new btDbvtBroadphase(m_pPairCache);
     m_pCollisionConfiguration = new btDefaultCollisionConfiguration;
@@ -65,7 +100,13 @@ void PhysicsSystem::debugDraw()
 
 void PhysicsSystem::update(double dt)
 {
-    m_pDynamicsWorld->stepSimulation(static_cast<btScalar>(dt));
+    RE_PROFILE_SCOPE("PhysicsSystem::update");
+    RE_ALLOCATION_SCOPE(Tag_Physics);
+
+    {
+        RE_PROFILE_SCOPE("btDiscreteDynamicsWorld::stepSimulation");
+        m_pDynamicsWorld->stepSimulation(static_cast<btScalar>(dt));
+    }
 
     const auto& ctuple = m_World.getComponentDataBundle().m_Data;
     size_t num = m_World.getComponentDataBundle().m_NumElements;
@@ -108,6 +149,8 @@ void PhysicsSystem::removeRigidBody(btRigidBody* body)
 
 Handle::CollisionShapeHandle PhysicsSystem::makeCollisionShapeFromMesh(const Meshes::WorldStaticMesh& mesh, CollisionShape::ECollisionType type, const std::string& name)
 {
+    RE_ALLOCATION_SCOPE(Tag_Physics);
+
     if (m_ShapeCache.find(name) != m_ShapeCache.end())
         return m_ShapeCache[name];
 
@@ -160,12 +203,17 @@ Handle::CollisionShapeHandle PhysicsSystem::makeCollisionShapeFromMesh(const std
                                                                        CollisionShape::ECollisionType type,
                                                                        const std::string& name)
 {
+    RE_ALLOCATION_SCOPE(Tag_Physics);
+
     if (m_ShapeCache.find(name) != m_ShapeCache.end())
         return m_ShapeCache[name];
 
     // Init collision
     btTriangleMesh* wm = new btTriangleMesh;
 
+    // The BVH refers to triangles by index, so a baked one is only usable for exactly the same triangles
+    uint64_t triangleHash = Content::BakeCache::hashString(name);
+
     wm->preallocateVertices((int)triangles.size() * 3);
     for (size_t i = 0; i < triangles.size(); i++)
     {
@@ -176,6 +224,12 @@ Handle::CollisionShapeHandle PhysicsSystem::makeCollisionShapeFromMesh(const std
             {triangles[i].vertices[2].Position.x, triangles[i].vertices[2].Position.y, triangles[i].vertices[2].Position.z}};
 
         wm->addTriangle(v[0], v[1], v[2]);
+
+        if (!name.empty())
+        {
+            for (const btVector3& p : v)
+                triangleHash = Content::BakeCache::hashData(reinterpret_cast<const uint8_t*>(p.m_floats), sizeof(btScalar) * 3, triangleHash);
+        }
     }
 
     if (wm->getNumTriangles() == 0)
@@ -184,11 +238,37 @@ Handle::CollisionShapeHandle PhysicsSystem::makeCollisionShapeFromMesh(const std
         return Handle::CollisionShapeHandle::makeInvalidHandle();
     }
 
+    int64_t start = bx::getHPCounter();
+    void* bvhBuffer = nullptr;
+    btBvhTriangleMeshShape* shape = nullptr;
+
+    if (!name.empty())
+        shape = loadBakedBvhShape(wm, name, triangleHash, bvhBuffer);
+
+    if (shape)
+    {
+        LogInfo() << "Loaded BVH of " << name << " (" << wm->getNumTriangles() << " triangles) from the bake-cache in "
+                  << (bx::getHPCounter() - start) * 1000.0 / bx::getHPFrequency() << "ms";
+    }
+    else
+    {
+        shape = new btBvhTriangleMeshShape(wm, true);
+
+        if (!name.empty())
+        {
+            LogInfo() << "Built BVH of " << name << " (" << wm->getNumTriangles() << " triangles) in "
+                      << (bx::getHPCounter() - start) * 1000.0 / bx::getHPFrequency() << "ms";
+
+            storeBakedBvh(*shape, wm->getNumTriangles(), name, triangleHash);
+        }
+    }
+
     Handle::CollisionShapeHandle csh = m_CollisionShapeAllocator.createObject();
     CollisionShape& cs = getCollisionShape(csh);
-    cs.collisionShape = new btBvhTriangleMeshShape(wm, true);
+    cs.collisionShape = shape;
     cs.shapeType = CollisionShape::TriangleMesh;
     cs.collisionType = type;
+    cs.bvhBuffer = bvhBuffer;
 
     cs.collisionShape->setUserIndex(csh.index);
 
@@ -198,8 +278,78 @@ Handle::CollisionShapeHandle PhysicsSystem::makeCollisionShapeFromMesh(const std
     return csh;
 }
 
+btBvhTriangleMeshShape* PhysicsSystem::loadBakedBvhShape(btTriangleMesh* mesh, const std::string& name, uint64_t triangleHash, void*& bvhBuffer)
+{
+    Content::BakeCache::Entry entry;
+    if (!m_World.getEngine()->getBakeCache().find(Content::BakeCache::EKind::CollisionMesh, name, triangleHash, entry))
+        return nullptr;
+
+    Content::BakeCache::Reader r = entry.getReader();
+
+    uint64_t storedHash;
+    uint32_t scalarSize;
+    uint32_t numTriangles;
+    if (!r.read(storedHash) || !r.read(scalarSize) || !r.read(numTriangles))
+        return nullptr;
+
+    // Always check the triangles, not only when the archives have changed
+    if (storedHash != triangleHash || scalarSize != sizeof(btScalar) || numTriangles != (uint32_t)mesh->getNumTriangles())
+        return nullptr;
+
+    size_t size;
+    const uint8_t* data = r.getRemaining(size);
+    if (!data || size == 0)
+        return nullptr;
+
+    // Bullet fixes up the pointers inside the BVH in place, which needs aligned, writable memory
+    bvhBuffer = btAlignedAlloc(size, 16);
+    memcpy(bvhBuffer, data, size);
+
+    btOptimizedBvh* bvh = btOptimizedBvh::deSerializeInPlace(bvhBuffer, static_cast<unsigned>(size), false);
+    if (!bvh)
+    {
+        btAlignedFree(bvhBuffer);
+        bvhBuffer = nullptr;
+        return nullptr;
+    }
+
+    btBvhTriangleMeshShape* shape = new btBvhTriangleMeshShape(mesh, true, false);
+    shape->setOptimizedBvh(bvh);
+
+    return shape;
+}
+
+void PhysicsSystem::storeBakedBvh(btBvhTriangleMeshShape& shape, int numTriangles, const std::string& name, uint64_t triangleHash)
+{
+    Content::BakeCache& cache = m_World.getEngine()->getBakeCache();
+    const btOptimizedBvh* bvh = shape.getOptimizedBvh();
+
+    if (!cache.isEnabled() || !bvh)
+        return;
+
+    unsigned size = bvh->calculateSerializeBufferSize();
+    void* buffer = btAlignedAlloc(size, 16);
+
+    if (bvh->serializeInPlace(buffer, size, false))
+    {
+        Content::BakeCache::Writer w;
+        w.write<uint64_t>(triangleHash);
+        w.write<uint32_t>(sizeof(btScalar));
+        w.write<uint32_t>(static_cast<uint32_t>(numTriangles));
+
+        std::vector<uint8_t> payload = w.getData();
+        payload.insert(payload.end(), reinterpret_cast<uint8_t*>(buffer), reinterpret_cast<uint8_t*>(buffer) + size);
+
+        cache.store(Content::BakeCache::EKind::CollisionMesh, name, triangleHash, payload);
+    }
+
+    btAlignedFree(buffer);
+}
+
 Handle::CollisionShapeHandle PhysicsSystem::makeCompoundCollisionShape(CollisionShape::ECollisionType type, const std::string& name)
 {
+    RE_ALLOCATION_SCOPE(Tag_Physics);
+
     if (m_ShapeCache.find(name) != m_ShapeCache.end())
         return m_ShapeCache[name];
 
@@ -247,20 +397,27 @@ Handle::CollisionShapeHandle PhysicsSystem::makeBoxCollisionShape(const Math::fl
     return csh;
 }
 
-std::vector<RayTestResult> PhysicsSystem::raytraceAll(const Math::float3& from, const Math::float3& to, CollisionShape::ECollisionType filtertype)
+Memory::FrameVector<RayTestResult> PhysicsSystem::raytraceAll(const Math::float3& from, const Math::float3& to, CollisionShape::ECollisionType filtertype)
 {
+    /**
+     * Writes every hit straight into the result, instead of collecting them in arrays of its own first
+     */
     struct FilteredAllHitsRayResultCallback : public btCollisionWorld::RayResultCallback
     {
-        FilteredAllHitsRayResultCallback(const btVector3& rayFromWorld, const btVector3& rayToWorld)
+        FilteredAllHitsRayResultCallback(const btVector3& rayFromWorld, const btVector3& rayToWorld, Memory::FrameVector<RayTestResult>& results)
             : m_rayFromWorld(rayFromWorld)
             , m_rayToWorld(rayToWorld)
+            , m_Results(results)
         {
         }
 
         btScalar addSingleResult(btCollisionWorld::LocalRayResult& rayResult, bool normalInWorldSpace) override
         {
             const btRigidBody* rb = btRigidBody::upcast(rayResult.m_collisionObject);
+            if (!rb)
+                return 0;
 
+            uint32_t hitFlags = CollisionShape::CT_Any;
             if (rb->getCollisionShape()->getUserIndex() != -1)
             {
                 // We don't have the generation of the handle here, but it should be okay!
@@ -273,72 +430,40 @@ std::vector<RayTestResult> PhysicsSystem::raytraceAll(const Math::float3& from,
                 if ((s.collisionType & m_filterType) == 0)
                     return 0;
 
-                m_hitCollisionTypes.push_back(s.collisionType);
+                hitFlags = s.collisionType;
             }
 
-            if (rb)
-                return addSingleResult_close(rayResult, normalInWorldSpace);
+            m_collisionObject = rayResult.m_collisionObject;
 
-            return 0;
+            btVector3 hitPointWorld;
+            hitPointWorld.setInterpolate3(m_rayFromWorld, m_rayToWorld, rayResult.m_hitFraction);
+
+            RayTestResult result;
+            result.hitFlags = hitFlags;
+            result.hitPosition = Math::float3(hitPointWorld.x(), hitPointWorld.y(), hitPointWorld.z());
+            result.hitTriangleIndex = static_cast<uint32_t>(rayResult.m_localShapeInfo->m_triangleIndex);
+            result.hasHit = true;
+            m_Results.push_back(result);
+
+            return m_closestHitFraction;
         }
-        btAlignedObjectArray<const btCollisionObject*> m_collisionObjects;
 
         btVector3 m_rayFromWorld;  //used to calculate hitPointWorld from hitFraction
         btVector3 m_rayToWorld;
 
-        btAlignedObjectArray<btVector3> m_hitNormalWorld;
-        btAlignedObjectArray<btVector3> m_hitPointWorld;
-        btAlignedObjectArray<btScalar> m_hitFractions;
-
-        std::vector<uint32_t> m_hitTriangleIndex;
-        std::vector<CollisionShape::ECollisionType> m_hitCollisionTypes;
+        Memory::FrameVector<RayTestResult>& m_Results;
         CollisionShape::ECollisionType m_filterType;
         CollisionShapeAllocator* m_ShapeAlloc;
+    };
 
-        virtual btScalar addSingleResult_close(btCollisionWorld::LocalRayResult& rayResult, bool normalInWorldSpace)
-        {
-            m_collisionObject = rayResult.m_collisionObject;
-            m_collisionObjects.push_back(rayResult.m_collisionObject);
-            btVector3 hitNormalWorld;
-            if (normalInWorldSpace)
-            {
-                hitNormalWorld = rayResult.m_hitNormalLocal;
-            }
-            else
-            {
-                ///need to transform normal into worldspace
-                hitNormalWorld = m_collisionObject->getWorldTransform().getBasis() * rayResult.m_hitNormalLocal;
-            }
-            m_hitNormalWorld.push_back(hitNormalWorld);
-            btVector3 hitPointWorld;
-            hitPointWorld.setInterpolate3(m_rayFromWorld, m_rayToWorld, rayResult.m_hitFraction);
-            m_hitPointWorld.push_back(hitPointWorld);
-            m_hitFractions.push_back(rayResult.m_hitFraction);
-            m_hitTriangleIndex.push_back(static_cast<uint32_t>(rayResult.m_localShapeInfo->m_triangleIndex));
+    Memory::FrameVector<RayTestResult> resultout;
 
-            return m_closestHitFraction;
-        }
-    };
-    FilteredAllHitsRayResultCallback r(btVector3(from.x, from.y, from.z), btVector3(to.x, to.y, to.z));
-    r.m_rayFromWorld = btVector3(from.x, from.y, from.z);
-    r.m_rayToWorld = btVector3(to.x, to.y, to.z);
+    FilteredAllHitsRayResultCallback r(btVector3(from.x, from.y, from.z), btVector3(to.x, to.y, to.z), resultout);
     r.m_filterType = filtertype;
     r.m_ShapeAlloc = &m_CollisionShapeAllocator;
 
     m_pDynamicsWorld->rayTest(r.m_rayFromWorld, r.m_rayToWorld, r);
 
-    unsigned outputsize = r.m_hitFractions.size();
-
-    std::vector<RayTestResult> resultout;
-    for (unsigned i = 0; i < r.m_hitTriangleIndex.size(); i++)
-    {
-        RayTestResult result;
-        result.hitFlags = r.m_hitCollisionTypes[i];
-        result.hitPosition = Math::float3(r.m_hitPointWorld[i].x(), r.m_hitPointWorld[i].y(), r.m_hitPointWorld[i].z());
-        result.hitTriangleIndex = r.m_hitTriangleIndex[i];
-        result.hasHit = r.hasHit();
-        resultout.push_back(result);
-    }
     return resultout;
 }
 
@@ -432,8 +557,54 @@ RayTestResult PhysicsSystem::raytrace(const Math::float3& from, const Math::floa
     return result;
 }
 
+void PhysicsSystem::raytraceOcclusion(const std::vector<std::pair<Math::float3, Math::float3>>& rays,
+                                      std::vector<uint8_t>& occluded,
+                                      CollisionShape::ECollisionType filtertype)
+{
+    struct AnyHitRayResultCallback : public btCollisionWorld::RayResultCallback
+    {
+        btScalar addSingleResult(btCollisionWorld::LocalRayResult& rayResult, bool normalInWorldSpace) override
+        {
+            int userIndex = rayResult.m_collisionObject->getCollisionShape()->getUserIndex();
+            if (userIndex != -1)
+            {
+                Handle::CollisionShapeHandle csh;
+                csh.index = static_cast<uint32_t>(userIndex);
+
+                if ((m_ShapeAlloc->getElementForce(csh).collisionType & m_filterType) == 0)
+                    return m_closestHitFraction;
+            }
+
+            // Any hit will do, stop tracing this ray
+            m_collisionObject = rayResult.m_collisionObject;
+            m_closestHitFraction = 0;
+            return 0;
+        }
+
+        CollisionShape::ECollisionType m_filterType;
+        CollisionShapeAllocator* m_ShapeAlloc;
+    };
+
+    occluded.assign(rays.size(), 0);
+
+    for (size_t i = 0; i < rays.size(); i++)
+    {
+        AnyHitRayResultCallback r;
+        r.m_filterType = filtertype;
+        r.m_ShapeAlloc = &m_CollisionShapeAllocator;
+
+        btVector3 from(rays[i].first.x, rays[i].first.y, rays[i].first.z);
+        btVector3 to(rays[i].second.x, rays[i].second.y, rays[i].second.z);
+        m_pDynamicsWorld->rayTest(from, to, r);
+
+        occluded[i] = r.hasHit() ? 1 : 0;
+    }
+}
+
 Handle::CollisionShapeHandle PhysicsSystem::makeConvexCollisionShapeFromMesh(const Meshes::WorldStaticMesh& mesh, const std::string& name)
 {
+    RE_ALLOCATION_SCOPE(Tag_Physics);
+
     if (m_ShapeCache.find(name) != m_ShapeCache.end())
         return m_ShapeCache[name];
 
@@ -500,6 +671,8 @@ PhysicsSystem::makeRigidBody(Handle::CollisionShapeHandle shape, const Math::Mat
 
 void PhysicsSystem::compoundShapeAddChild(Handle::CollisionShapeHandle target, Handle::CollisionShapeHandle childShape, const Math::Matrix& localTransform)
 {
+    RE_ALLOCATION_SCOPE(Tag_Physics);
+
     CollisionShape& ts = getCollisionShape(target);
     CollisionShape& cs = getCollisionShape(childShape);
 
@@ -2,6 +2,7 @@
 #include <btBulletDynamicsCommon.h>
 #include <BulletCollision/Gimpact/btGImpactCollisionAlgorithm.h>
 #include <content/StaticMeshAllocator.h>
+#include <memory/FrameArena.h>
 
 namespace World
 {
@@ -43,13 +44,21 @@ namespace Physics
         EShapeType shapeType;
         ECollisionType collisionType;
 
+        /**
+         * Aligned memory holding a BVH loaded from the bake-cache, which the shape doesn't own
+         */
+        void* bvhBuffer = nullptr;
+
         static void clean(CollisionShape& s)
         {
             auto btTriangleMeshShape = dynamic_cast<btBvhTriangleMeshShape*>(s.collisionShape);
             btStridingMeshInterface* mesh = btTriangleMeshShape ? btTriangleMeshShape->getMeshInterface() : nullptr;
             // delete in reverse order of creation
             delete s.collisionShape;
+            btAlignedFree(s.bvhBuffer);
             delete mesh;
+
+            s.bvhBuffer = nullptr;
         }
     };
 
@@ -127,6 +136,13 @@ namespace Physics
          * @return Static collision-shape using this mesh
          */
         Handle::CollisionShapeHandle makeCollisionShapeFromMesh(const Meshes::WorldStaticMesh& mesh, CollisionShape::ECollisionType type = CollisionShape::CT_Any, const std::string& name = "");
+
+        /**
+         * Creates a new collisionshape from the given triangles. If a name is given and the bake-cache is enabled,
+         * the BVH of the shape is kept in there and reused the next time the same triangles are passed under that name.
+         * @param triangles Triangles to use, in world-space
+         * @return Static collision-shape using these triangles
+         */
         Handle::CollisionShapeHandle makeCollisionShapeFromMesh(const std::vector<ZenLoad::WorldTriangle>& triangles, CollisionShape::ECollisionType type = CollisionShape::CT_Any, const std::string& name = "");
 
         /**
@@ -184,9 +200,19 @@ namespace Physics
          * Does a simple multi-raytrace
          * @param from Source
          * @param to Destination
-         * @return Vector of all RayTestResults assosiated with colissionshapes hit by the ray
+         * @return Vector of all RayTestResults assosiated with colissionshapes hit by the ray, only valid until the end of the next frame
+         */
+        Memory::FrameVector<RayTestResult> raytraceAll(const Math::float3& from, const Math::float3& to, CollisionShape::ECollisionType filtertype = CollisionShape::CT_Any);
+
+        /**
+         * Checks a batch of rays for whether anything is in between their start- and end-points. Cheaper than
+         * calling raytrace() for each of them, as tracing stops at the first hit instead of searching the closest.
+         * @param rays Pairs of start- and end-points
+         * @param occluded Output. One entry per ray, 1 if something was hit.
          */
-        std::vector<RayTestResult> raytraceAll(const Math::float3& from, const Math::float3& to, CollisionShape::ECollisionType filtertype = CollisionShape::CT_Any);
+        void raytraceOcclusion(const std::vector<std::pair<Math::float3, Math::float3>>& rays,
+                               std::vector<uint8_t>& occluded,
+                               CollisionShape::ECollisionType filtertype = CollisionShape::CT_Any);
 
         /**
          * @return Physics-object of the given handle
@@ -225,6 +251,21 @@ namespace Physics
          */
         void removeRigidBody(btRigidBody* body);
 
+        /**
+         * Tries to load the BVH for the given triangle-mesh from the bake-cache
+         * @param name Name the BVH was stored under
+         * @param triangleHash Hash of the triangles the BVH must have been built from
+         * @param bvhBuffer Output. Aligned memory holding the BVH, to be freed using btAlignedFree after the shape is gone.
+         * @return Shape using the loaded BVH, nullptr if there was no matching one
+         */
+        btBvhTriangleMeshShape* loadBakedBvhShape(btTriangleMesh* mesh, const std::string& name, uint64_t triangleHash, void*& bvhBuffer);
+
+        /**
+         * Stores the BVH of the given shape in the bake-cache
+         * @param numTriangles Number of triangles in the mesh of the shape
+         */
+        void storeBakedBvh(btBvhTriangleMeshShape& shape, int numTriangles, const std::string& name, uint64_t triangleHash);
+
         /**
          * Bullet engine
          */
@@ -43,12 +43,37 @@ namespace Render
             Math::Matrix cameraWorld;
             Math::Matrix viewProj;
             float drawDistanceSquared;
+            float lodBias;
             float farPlane;
             uint32_t viewWidth;
             uint32_t viewHeight;
         } state;
     };
 
+    /**
+     * Counters of what has been submitted during the last drawWorld()
+     */
+    struct FrameStats
+    {
+        size_t numDrawcalls = 0;
+        size_t numTriangles = 0;
+        size_t numSubmeshesDrawn = 0;
+
+        // Worldmesh-cells and their triangles skipped by distance- or frustum-culling
+        size_t numWorldCellsCulled = 0;
+        size_t numWorldTrianglesCulled = 0;
+        size_t numWorldTrianglesDrawn = 0;
+
+        // Triangles not drawn because a simplified level of detail was used instead
+        size_t numTrianglesSavedByLod = 0;
+
+        // Changes between consecutive draws of the main renderpass, after sorting them
+        size_t numProgramChanges = 0;
+        size_t numTextureChanges = 0;
+        size_t numMeshChanges = 0;
+        size_t numRenderStateChanges = 0;
+    };
+
     class RenderSystem
     {
     public:
@@ -92,6 +117,11 @@ namespace Render
          */
         void loadShaders();
 
+        /**
+         * @return Counters of the last drawn frame
+         */
+        FrameStats& getFrameStats() { return m_FrameStats; }
+
     protected:
 
         /**
@@ -104,6 +134,11 @@ namespace Render
          */
         RenderConfig m_Config;
 
+        /**
+         * Counters of the last drawn frame
+         */
+        FrameStats m_FrameStats;
+
         Engine::BaseEngine& m_Engine;
 
         /**
@@ -3,17 +3,20 @@
 #include "ViewList.h"
 #include "bgfx_utils.h"
 #include "common.h"
+#include <algorithm>
+#include <cmath>
 #include <bgfx/bgfx.h>
 #include <debugdraw/debugdraw.h>
 #include <engine/Waynet.h>
 #include <engine/World.h>
+#include <memory/FrameArena.h>
 #include <utils/logger.h>
+#include <utils/FrameProfiler.h>
 
 #include <logic/Controller.h>
 #include <content/Sky.h>
 #include "SkyRendering.h"
-#include <content/SkeletalMeshAllocator.h>
-#include <content/StaticMeshAllocator.h>
+#include <content/AssetCache.h>
 #include <components/AnimHandler.h>
 #include <engine/BaseEngine.h>
 
@@ -79,20 +82,108 @@ namespace Render
         bgfx::setUniform(config.uniforms.skyColors, (float*)skyColors, 2);
 
     }
+
+    /**
+     * Layers of the main renderpass, in the order they are drawn
+     */
+    enum EDrawLayer : uint8_t
+    {
+        DrawLayer_Opaque,
+        DrawLayer_Alpha,
+        DrawLayer_AlphaAdditive,
+    };
+
+    enum EDrawProgram : uint8_t
+    {
+        DrawProgram_World,
+        DrawProgram_Skinned,
+        DrawProgram_Particle,
+    };
+
+    /**
+     * A single draw collected while culling, submitted once all of them are sorted by their key
+     */
+    struct DrawRecord
+    {
+        /**
+         * From most to least significant bits:
+         *  - 4 bits layer
+         *  - 8 bits depth-bucket, front to back for opaque layers, back to front for blended ones
+         *  - 4 bits program
+         *  - 16 bits texture
+         *  - 16 bits mesh
+         *  - 16 bits unused
+         */
+        uint64_t key;
+        uint32_t entity;
+        Meshes::SubmeshVxInfo submesh;
+        bgfx::TextureHandle texture;
+
+        bool operator<(const DrawRecord& r) const
+        {
+            // Entity as tie-breaker, so the order doesn't flicker between frames
+            return key != r.key ? key < r.key : entity < r.entity;
+        }
+    };
+
+    uint64_t makeDrawKey(EDrawLayer layer, uint8_t depth, EDrawProgram program, uint16_t texture, uint16_t mesh)
+    {
+        return (uint64_t(layer & 0xF) << 60)
+               | (uint64_t(depth) << 52)
+               | (uint64_t(program & 0xF) << 48)
+               | (uint64_t(texture) << 32)
+               | (uint64_t(mesh) << 16);
+    }
+
+    EDrawProgram getDrawProgram(uint64_t key)
+    {
+        return static_cast<EDrawProgram>((key >> 48) & 0xF);
+    }
+
+    uint8_t getDepthBucket(uint64_t key)
+    {
+        return static_cast<uint8_t>(key >> 52);
+    }
+
+    uint16_t getDrawMesh(uint64_t key)
+    {
+        return static_cast<uint16_t>(key >> 16);
+    }
+
+    /**
+     * Quantizes the distance to the camera. The buckets are coarse enough for draws of the same program and texture
+     * to end up next to each other, and get finer towards the camera, where overdraw matters most.
+     * @param backToFront Inverts the order, for blended draws
+     */
+    uint8_t depthBucket(float distance2, float drawDistance2, bool backToFront)
+    {
+        float d = std::sqrt(std::sqrt(std::min(1.0f, distance2 / std::max(drawDistance2, 1.0f))));
+        uint8_t bucket = static_cast<uint8_t>(d * 255.0f);
+
+        return backToFront ? static_cast<uint8_t>(255 - bucket) : bucket;
+    }
+
     /**
      * @brief Draws the main renderpass of the given world
      */
     void drawWorld(World::WorldInstance& world, const RenderConfig& config, RenderSystem& system)
     {
+        RE_PROFILE_SCOPE("Render::drawWorld");
+
         Plane frustumPlanes[6];
         buildFrustumPlanes(frustumPlanes, config.state.viewProj.mv);
 
         // Setup sky and fog
-        setupSky(world, config);
+        {
+            RE_PROFILE_SCOPE("Render::setupSky");
+            setupSky(world, config);
+        }
 
         // Extract camera position
         const Math::float3 cameraPosition = config.state.cameraWorld.Translation();
         const float drawDistance2 = config.state.drawDistanceSquared;
+        const float drawDistance = std::sqrt(drawDistance2);
+        const float lodBias = config.state.lodBias;
 
         // Draw all components
         const auto& ctuple = world.getComponentDataBundle().m_Data;
@@ -140,6 +231,14 @@ namespace Render
         size_t numDrawcalls = 0;
         size_t numIndices = 0;
         size_t numSubmeshesDrawn = 0;
+        size_t numWorldCellsCulled = 0;
+        size_t numWorldTrianglesCulled = 0;
+        size_t numWorldTrianglesDrawn = 0;
+        size_t numTrianglesSavedByLod = 0;
+
+        // Everything visible, sorted and submitted after culling
+        Memory::FrameVector<DrawRecord> drawRecords;
+        drawRecords.reserve(num);
 
         std::uint32_t textureFlags = BGFX_TEXTURE_MIN_ANISOTROPIC | BGFX_TEXTURE_MAG_ANISOTROPIC;
 
@@ -172,10 +271,31 @@ namespace Render
                     continue;
             }
 
+            // Worldmesh-cells can be huge, so check the distance to their nearest point instead of their center
+            bool isWorldMeshCell = (mask & Components::StaticMeshComponent::MASK) != 0 && sms[i].m_IsWorldMeshCell;
+            if (isWorldMeshCell)
+            {
+                float reach = drawDistance + bboxes[i].m_SphereRadius;
+                if (distance2 > reach * reach)
+                {
+                    numWorldCellsCulled++;
+                    numWorldTrianglesCulled += sms[i].m_SubmeshInfo.m_NumIndices / 3;
+                    continue;
+                }
+            }
+
             if ((mask & Components::BBoxComponent::MASK) != 0)
             {
                 if(frustrumContainsSphere(frustumPlanes, pos.Translation(), bboxes[i].m_SphereRadius) == ECameraClipType::Out)
+                {
+                    if (isWorldMeshCell)
+                    {
+                        numWorldCellsCulled++;
+                        numWorldTrianglesCulled += sms[i].m_SubmeshInfo.m_NumIndices / 3;
+                    }
+
                     continue;
+                }
                 else
                 {
                     /*ddPush();
@@ -205,69 +325,29 @@ namespace Render
                 if (!sms[i].m_StaticMeshVisual.isValid())
                     continue;
 
+                bgfx::TextureHandle texture = BGFX_INVALID_HANDLE;
+                if (sms[i].m_Texture.isValid())
+                    texture = world.getTextureAllocator().getTexture(sms[i].m_Texture).m_TextureHandle;
+
                 if ((mask & Components::AnimationComponent::MASK) != 0)
                 {
-                    auto& mesh = skelmeshes.getMesh(sms[i].m_StaticMeshVisual);
-
                     // Could happen if this was loaded on another thread
                     if (!skelmeshes.isLoaded(sms[i].m_StaticMeshVisual))
                         continue;
 
-                    if ((mask & Components::PositionComponent::MASK) != 0)
-                    {
-                        // Set model matrix for rendering.
-                        bgfx::setTransform(pos.m);
-                    }
-
-                    bgfx::setState(BGFX_STATE_DEFAULT);
+                    auto& mesh = skelmeshes.getMesh(sms[i].m_StaticMeshVisual);
 
                     numIndices += sms[i].m_SubmeshInfo.m_NumIndices;
                     numDrawcalls++;
                     numSubmeshesDrawn++;
 
-                    if (sms[i].m_Texture.isValid())
-                    {
-                        Textures::Texture& texture = world.getTextureAllocator().getTexture(sms[i].m_Texture);
-                        bgfx::setTexture(0, config.uniforms.diffuseTexture, texture.m_TextureHandle, textureFlags);
-                    }
-
-                    // Set object-color
-                    Math::float4 color;
-                    color.fromRGBA8(sms[i].m_Color);
-                    bgfx::setUniform(config.uniforms.objectColor, color.v);
-
-                    Components::AnimHandler* animHandler = nullptr;
-                    if (animations[i].m_ParentAnimHandler.isValid())
-                    {
-                        Components::AnimationComponent& pac = world.getEntity<Components::AnimationComponent>(animations[i].m_ParentAnimHandler);
-                        animHandler = &pac.getAnimHandler();
-                    }
-                    else
-                    {
-                        animHandler = &animations[i].getAnimHandler();
-                    }
-
-                    //animHandler->debugDrawSkeleton(pos);
-
-                    // Copy everything to the temporary skeletal instance
-                    Math::Matrix nodeMat[ZenLoad::MAX_NUM_SKELETAL_NODES + 1];
-                    animHandler->updateSkeletalMeshInfo(nodeMat + 1, ZenLoad::MAX_NUM_SKELETAL_NODES);
-                    nodeMat[0] = pos;
-
-                    // They are vec4 inside the shader, thus numMatrices * 4
-                    //bgfx::setUniform(config.uniforms.nodeTransforms, tmpSkelInstance.nodeTransforms,
-                    //				 4 * ZenLoad::MAX_NUM_SKELETAL_NODES);
-
-                    //float f[] = {1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f};
-                    //bgfx::setUniform(config.uniforms.nodeTransforms, f, 2);
-                    bgfx::setTransform(nodeMat, static_cast<uint16_t>(animHandler->getNumNodes() + 1));
-
-                    bgfx::setVertexBuffer(0, mesh.m_VertexBufferHandle);
-                    bgfx::setIndexBuffer(mesh.m_IndexBufferHandle,
-                                         sms[i].m_SubmeshInfo.m_StartIndex,
-                                         sms[i].m_SubmeshInfo.m_NumIndices);
-
-                    bgfx::submit(RenderViewList::DEFAULT, config.programs.mainSkinnedMeshProgram);
+                    DrawRecord r;
+                    r.key = makeDrawKey(DrawLayer_Opaque, depthBucket(distance2, drawDistance2, false), DrawProgram_Skinned,
+                                        texture.idx, mesh.m_VertexBufferHandle.idx);
+                    r.entity = static_cast<uint32_t>(i);
+                    r.submesh = sms[i].m_SubmeshInfo;
+                    r.texture = texture;
+                    drawRecords.push_back(r);
                 }
                 else
                 {
@@ -307,59 +387,39 @@ namespace Render
                             kind.instances.back().world = pos;
                             kind.instances.back().color.fromRGBA8(sms[i].m_Color);
                         }
-
-                        //uint32_t idx = mesh.instanceDataBufferIndex;
-
-                        /*bgfx::setVertexBuffer(mesh.mesh.m_VertexBufferHandle);
-                        bgfx::setIndexBuffer(mesh.mesh.m_IndexBufferHandle,
-                                             sms[i].m_SubmeshInfo.m_StartIndex,
-                                             sms[i].m_SubmeshInfo.m_NumIndices);*/
                     }
                     else
                     {
-                        if ((mask & Components::PositionComponent::MASK) != 0)
+                        // Pick the coarsest level of detail which is still fine enough for the size on screen
+                        Meshes::SubmeshVxInfo submeshInfo = sms[i].m_SubmeshInfo;
+                        if (!mesh.lods.empty() && lodBias > 0.0f)
                         {
-                            // Set model matrix for rendering.
-                            bgfx::setTransform(pos.m);
-                        }
+                            float screenSize = mesh.boundingSphereRadius / std::max(0.001f, std::sqrt(distance2));
+                            for (const Meshes::WorldStaticMeshLod& lod : mesh.lods)
+                            {
+                                if (screenSize < lod.maxScreenSize * lodBias)
+                                    submeshInfo = lod.submeshes[sms[i].m_SubmeshIdx];
+                            }
 
-                        bgfx::setState(BGFX_STATE_DEFAULT);
+                            numTrianglesSavedByLod += (sms[i].m_SubmeshInfo.m_NumIndices - submeshInfo.m_NumIndices) / 3;
+                        }
 
-                        numIndices += sms[i].m_SubmeshInfo.m_NumIndices;
+                        numIndices += submeshInfo.m_NumIndices;
                         numDrawcalls++;
                         numSubmeshesDrawn++;
 
-                        if (sms[i].m_Texture.isValid())
-                        {
-                            Textures::Texture& texture = world.getTextureAllocator().getTexture(sms[i].m_Texture);
-                            bgfx::setTexture(0, config.uniforms.diffuseTexture, texture.m_TextureHandle, textureFlags);
-                        }
-
-                        // Set object-color
-                        Math::float4 color;
-                        color.fromRGBA8(sms[i].m_Color);
-                        bgfx::setUniform(config.uniforms.objectColor, color.v);
-
-                        auto& mesh = meshes.getMesh(sms[i].m_StaticMeshVisual);
+                        if (isWorldMeshCell)
+                            numWorldTrianglesDrawn += submeshInfo.m_NumIndices / 3;
 
-                        if (mesh.mesh.m_IndexBufferHandle.idx != bgfx::kInvalidHandle)
-                        {
-                            bgfx::setVertexBuffer(0, mesh.mesh.m_VertexBufferHandle);
-                            bgfx::setIndexBuffer(mesh.mesh.m_IndexBufferHandle,
-                                                 sms[i].m_SubmeshInfo.m_StartIndex,
-                                                 sms[i].m_SubmeshInfo.m_NumIndices);
-                        }
-                        else
-                        {
-                            bgfx::setVertexBuffer(0, mesh.mesh.m_VertexBufferHandle,
-                                                  sms[i].m_SubmeshInfo.m_StartIndex,
-                                                  sms[i].m_SubmeshInfo.m_NumIndices);
-                        }
-                        bgfx::submit(RenderViewList::DEFAULT, config.programs.mainWorldProgram);
+                        DrawRecord r;
+                        r.key = makeDrawKey(DrawLayer_Opaque, depthBucket(distance2, drawDistance2, false), DrawProgram_World,
+                                            texture.idx, mesh.mesh.m_VertexBufferHandle.idx);
+                        r.entity = static_cast<uint32_t>(i);
+                        r.submesh = submeshInfo;
+                        r.texture = texture;
+                        drawRecords.push_back(r);
                     }
                 }
-
-                //bgfx::submit(0, config.programs.mainWorldProgram);
             }
 
             if ((mask & Components::BBoxComponent::MASK) != 0)
@@ -387,11 +447,150 @@ namespace Render
                 }
             }
 
-            // Draw pfx
+            // Particles are blended, so they go into their own layer and are drawn back to front
             if ((mask & Components::PfxComponent::MASK) != 0)
             {
-                drawPfx(world, pfxs[i], config);
+                bgfx::TextureHandle texture = BGFX_INVALID_HANDLE;
+                if (pfxs[i].m_Texture.isValid())
+                    texture = world.getTextureAllocator().getTexture(pfxs[i].m_Texture).m_TextureHandle;
+
+                // Make sure to draw additive blended particles last. (Fire over smoke)
+                EDrawLayer layer = DrawLayer_Alpha;
+                if ((pfxs[i].m_bgfxRenderState & BGFX_STATE_BLEND_ADD) == BGFX_STATE_BLEND_ADD)
+                    layer = DrawLayer_AlphaAdditive;
+
+                DrawRecord r;
+                r.key = makeDrawKey(layer, depthBucket(distance2, drawDistance2, true), DrawProgram_Particle,
+                                    texture.idx, pfxs[i].m_ParticleVB.idx);
+                r.entity = static_cast<uint32_t>(i);
+                r.submesh = {0, 0};
+                r.texture = texture;
+                drawRecords.push_back(r);
+            }
+        }
+
+        {
+            RE_PROFILE_SCOPE("Render::submitDrawRecords");
+
+            std::sort(drawRecords.begin(), drawRecords.end());
+
+            // Opaque draws are only ever submitted with the default-state, which is what bgfx resets to after every draw
+            uint64_t lastState = BGFX_STATE_DEFAULT;
+            int lastProgram = -1;
+            uint32_t lastTexture = 0xFFFFFFFF;
+            uint32_t lastMesh = 0xFFFFFFFF;
+
+            size_t numProgramChanges = 0;
+            size_t numTextureChanges = 0;
+            size_t numMeshChanges = 0;
+            size_t numRenderStateChanges = 0;
+
+            for (const DrawRecord& r : drawRecords)
+            {
+                size_t i = r.entity;
+                EDrawProgram program = getDrawProgram(r.key);
+                uint64_t state = program == DrawProgram_Particle ? pfxs[i].m_bgfxRenderState : BGFX_STATE_DEFAULT;
+
+                if (program != lastProgram)
+                    numProgramChanges++;
+
+                if (r.texture.idx != lastTexture)
+                    numTextureChanges++;
+
+                if (getDrawMesh(r.key) != lastMesh)
+                    numMeshChanges++;
+
+                if (state != lastState)
+                    numRenderStateChanges++;
+
+                lastProgram = program;
+                lastTexture = r.texture.idx;
+                lastMesh = getDrawMesh(r.key);
+                lastState = state;
+
+                if (program == DrawProgram_Particle)
+                {
+                    drawPfx(world, pfxs[i], config);
+                    continue;
+                }
+
+                auto& pos = psc[i].m_WorldMatrix;
+                Components::ComponentMask mask = ents[i].m_ComponentMask;
+
+                if (bgfx::isValid(r.texture))
+                    bgfx::setTexture(0, config.uniforms.diffuseTexture, r.texture, textureFlags);
+
+                // Set object-color
+                Math::float4 color;
+                color.fromRGBA8(sms[i].m_Color);
+                bgfx::setUniform(config.uniforms.objectColor, color.v);
+
+                // Keeps the order within a bucket, as bgfx sorts by program and depth on its own
+                int32_t depth = getDepthBucket(r.key);
+
+                if (program == DrawProgram_Skinned)
+                {
+                    auto& mesh = skelmeshes.getMesh(sms[i].m_StaticMeshVisual);
+
+                    Components::AnimHandler* animHandler = nullptr;
+                    if (animations[i].m_ParentAnimHandler.isValid())
+                    {
+                        Components::AnimationComponent& pac = world.getEntity<Components::AnimationComponent>(animations[i].m_ParentAnimHandler);
+                        animHandler = &pac.getAnimHandler();
+                    }
+                    else
+                    {
+                        animHandler = &animations[i].getAnimHandler();
+                    }
+
+                    //animHandler->debugDrawSkeleton(pos);
+
+                    // Copy everything to the temporary skeletal instance
+                    Math::Matrix nodeMat[ZenLoad::MAX_NUM_SKELETAL_NODES + 1];
+                    animHandler->updateSkeletalMeshInfo(nodeMat + 1, ZenLoad::MAX_NUM_SKELETAL_NODES);
+                    nodeMat[0] = pos;
+
+                    bgfx::setTransform(nodeMat, static_cast<uint16_t>(animHandler->getNumNodes() + 1));
+
+                    bgfx::setVertexBuffer(0, mesh.m_VertexBufferHandle);
+                    bgfx::setIndexBuffer(mesh.m_IndexBufferHandle,
+                                         r.submesh.m_StartIndex,
+                                         r.submesh.m_NumIndices);
+
+                    bgfx::submit(RenderViewList::DEFAULT, config.programs.mainSkinnedMeshProgram, depth);
+                }
+                else
+                {
+                    auto& mesh = meshes.getMesh(sms[i].m_StaticMeshVisual);
+
+                    if ((mask & Components::PositionComponent::MASK) != 0)
+                    {
+                        // Set model matrix for rendering.
+                        bgfx::setTransform(pos.m);
+                    }
+
+                    if (mesh.mesh.m_IndexBufferHandle.idx != bgfx::kInvalidHandle)
+                    {
+                        bgfx::setVertexBuffer(0, mesh.mesh.m_VertexBufferHandle);
+                        bgfx::setIndexBuffer(mesh.mesh.m_IndexBufferHandle,
+                                             r.submesh.m_StartIndex,
+                                             r.submesh.m_NumIndices);
+                    }
+                    else
+                    {
+                        bgfx::setVertexBuffer(0, mesh.mesh.m_VertexBufferHandle,
+                                              r.submesh.m_StartIndex,
+                                              r.submesh.m_NumIndices);
+                    }
+
+                    bgfx::submit(RenderViewList::DEFAULT, config.programs.mainWorldProgram, depth);
+                }
             }
+
+            system.getFrameStats().numProgramChanges = numProgramChanges;
+            system.getFrameStats().numTextureChanges = numTextureChanges;
+            system.getFrameStats().numMeshChanges = numMeshChanges;
+            system.getFrameStats().numRenderStateChanges = numRenderStateChanges;
         }
 
 // Now draw instances
@@ -441,6 +640,14 @@ namespace Render
 		}
 #endif
 
+        system.getFrameStats().numDrawcalls = numDrawcalls;
+        system.getFrameStats().numTriangles = numIndices / 3;
+        system.getFrameStats().numSubmeshesDrawn = numSubmeshesDrawn;
+        system.getFrameStats().numWorldCellsCulled = numWorldCellsCulled;
+        system.getFrameStats().numWorldTrianglesCulled = numWorldTrianglesCulled;
+        system.getFrameStats().numWorldTrianglesDrawn = numWorldTrianglesDrawn;
+        system.getFrameStats().numTrianglesSavedByLod = numTrianglesSavedByLod;
+
         //bgfx::dbgTextPrintf(0, 3, 0x0f, "Num Triangles:    %d", numIndices/3);
         //bgfx::dbgTextPrintf(0, 4, 0x0f, "Num Drawcalls:    %d", numDrawcalls);
         //bgfx::dbgTextPrintf(0, 5, 0x0f, "Num Meshes drawn: %d", numSubmeshesDrawn);
@@ -523,52 +730,51 @@ void Render::debugDrawPath(const World::Waynet::WaynetInstance& waynet, const st
 void ::Render::drawPfx(World::WorldInstance& world, Components::PfxComponent& pfx, const Render::RenderConfig& config)
 {
     // TODO: Could optimize this into a global vertexbuffer
+    RE_PROFILE_SCOPE("Render::drawPfx");
 
     if (!bgfx::isValid(pfx.m_ParticleVB))
         return;
 
-    // Cache
-    static std::vector<Meshes::WorldStaticMeshVertex> quadVertices;
-
     Math::float3 right = config.state.cameraWorld.Rotate(Math::float3(1, 0, 0)).normalize() * -0.5f;  // 0.5 because they get extended into both directions. We want size 1 in total.
     Math::float3 up = config.state.cameraWorld.Rotate(Math::float3(0, 1, 0)).normalize() * 0.5f;
 
-    quadVertices.resize(pfx.m_Particles.size() * 6);
-
-    ddPush();
-    for (size_t i = 0; i < pfx.m_Particles.size(); i++)
+    if (!pfx.m_Particles.empty())
     {
-        Components::PfxComponent::Particle& p = pfx.m_Particles[i];
-
-        //ddDrawAxis(pfx.m_Particles[i].position.x, pfx.m_Particles[i].position.y, pfx.m_Particles[i].position.z);
-
-        Utils::billboardQuad(quadVertices[6 * i + 0].Position,
-                             quadVertices[6 * i + 1].Position,
-                             quadVertices[6 * i + 2].Position,
-                             quadVertices[6 * i + 3].Position,
-                             quadVertices[6 * i + 4].Position,
-                             quadVertices[6 * i + 5].Position,
-                             p.position,
-                             right * p.size.x,
-                             up * p.size.y);
+        // Build the quads right inside the frame-memory of bgfx, instead of copying them there afterwards
+        const bgfx::Memory* mem = bgfx::alloc(static_cast<uint32_t>(sizeof(Meshes::WorldStaticMeshVertex) * pfx.m_Particles.size() * 6));
+        Meshes::WorldStaticMeshVertex* quadVertices = reinterpret_cast<Meshes::WorldStaticMeshVertex*>(mem->data);
 
-        quadVertices[6 * i + 0].TexCoord = Math::float2(0, 1);
-        quadVertices[6 * i + 1].TexCoord = Math::float2(1, 1);
-        quadVertices[6 * i + 2].TexCoord = Math::float2(0, 0);
-
-        quadVertices[6 * i + 3].TexCoord = Math::float2(0, 0);
-        quadVertices[6 * i + 4].TexCoord = Math::float2(1, 1);
-        quadVertices[6 * i + 5].TexCoord = Math::float2(1, 0);
-
-        for (int j = 0; j < 6; j++)
+        for (size_t i = 0; i < pfx.m_Particles.size(); i++)
         {
-            quadVertices[6 * i + j].Color = p.particleColorU8;
+            Components::PfxComponent::Particle& p = pfx.m_Particles[i];
+
+            Utils::billboardQuad(quadVertices[6 * i + 0].Position,
+                                 quadVertices[6 * i + 1].Position,
+                                 quadVertices[6 * i + 2].Position,
+                                 quadVertices[6 * i + 3].Position,
+                                 quadVertices[6 * i + 4].Position,
+                                 quadVertices[6 * i + 5].Position,
+                                 p.position,
+                                 right * p.size.x,
+                                 up * p.size.y);
+
+            quadVertices[6 * i + 0].TexCoord = Math::float2(0, 1);
+            quadVertices[6 * i + 1].TexCoord = Math::float2(1, 1);
+            quadVertices[6 * i + 2].TexCoord = Math::float2(0, 0);
+
+            quadVertices[6 * i + 3].TexCoord = Math::float2(0, 0);
+            quadVertices[6 * i + 4].TexCoord = Math::float2(1, 1);
+            quadVertices[6 * i + 5].TexCoord = Math::float2(1, 0);
+
+            for (int j = 0; j < 6; j++)
+            {
+                quadVertices[6 * i + j].Normal = Math::float3(0, 0, 0);
+                quadVertices[6 * i + j].Color = p.particleColorU8;
+            }
         }
-    }
-    ddPop();
 
-    if (!pfx.m_Particles.empty())
-        bgfx::updateDynamicVertexBuffer(pfx.m_ParticleVB, 0, bgfx::copy(quadVertices.data(), sizeof(Meshes::WorldStaticMeshVertex) * quadVertices.size()));
+        bgfx::updateDynamicVertexBuffer(pfx.m_ParticleVB, 0, mem);
+    }
 
     // Do the actual rendering
     // TODO: Support animated textures
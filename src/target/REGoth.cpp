@@ -3,23 +3,32 @@
  * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
  */
 
+#include <algorithm>
 #include <fstream>
 #include "rgconfig.h"
 #include <common.h>
 #include <json.hpp>
 #include <ZenLib/utils/logger.h>
+#include <bx/timer.h>
 #include <bx/uint32_t.h>
 #include <components/VobClasses.h>
 #include <content/StaticLevelMesh.h>
 #include <content/VertexTypes.h>
+#include <engine/VobStreamer.h>
 #include <debugdraw/debugdraw.h>
 #include <imgui/imgui.h>
 #include <logic/Console.h>
 #include <logic/NpcScriptState.h>
 #include <logic/PlayerController.h>
 #include <logic/MusicController.h>
+#include <logic/NpcAIScheduler.h>
+#include <logic/NpcRoutineScheduler.h>
+#include <logic/messages/MessagePool.h>
+#include <logic/PerceptionSystem.h>
 #include <logic/SavegameManager.h>
 #include <logic/visuals/ModelVisual.h>
+#include <memory/AllocationTracker.h>
+#include <memory/FrameArena.h>
 #include <render/RenderSystem.h>
 #include <render/WorldRender.h>
 #include <target/REGoth.h>
@@ -30,6 +39,8 @@
 #include <ui/Menu.h>
 #include <ui/Menu_Main.h>
 #include <utils/cli.h>
+#include <utils/EngineLog.h>
+#include <utils/FrameProfiler.h>
 #include <utils/zTools.h>
 #include <vdfs/fileIndex.h>
 #include <zenload/zCMesh.h>
@@ -39,8 +50,7 @@
 #include <logic/ScriptEngine.h>
 #include <logic/DialogManager.h>
 #include <content/AnimationAllocator.h>
-#include <content/StaticMeshAllocator.h>
-#include <content/SkeletalMeshAllocator.h>
+#include <content/AssetCache.h>
 
 using json = nlohmann::json;
 
@@ -48,6 +58,8 @@ namespace Flags
 {
     Cli::Flag help("h", "help", 0, "Prints this message");
     Cli::Flag vsync("vsync", "vertical-sync", 0, "Enables vertical sync", {"0"}, "Rendering");
+    Cli::Flag noopRenderer("", "noop-renderer", 0, "Uses bgfx's Noop-renderer, which draws nothing. Allows benchmarking on machines without a GPU");
+    Cli::Flag allocationReport("", "allocation-report", 1, "File to write the memory used per subsystem to on exit. Only available when built with REGOTH_TRACK_ALLOCATIONS", {"allocations.txt"});
 }
 
 void REGoth::init(int _argc, char** _argv)
@@ -67,7 +79,7 @@ void REGoth::init(int _argc, char** _argv)
     m_Height = getWindowHeight();
     m_HUDMode = 2;
 
-    bgfx::init();
+    bgfx::init(Flags::noopRenderer.isSet() ? bgfx::RendererType::Noop : bgfx::RendererType::Count);
     bgfx::reset(m_Width, m_Height, m_reset);
 
     // Enable debug text.
@@ -86,6 +98,8 @@ void REGoth::init(int _argc, char** _argv)
     Meshes::PositionUVVertex2D::init();
     Meshes::SkeletalVertex::init();
 
+    Utils::EngineLog::init();
+
     VDFS::FileIndex::initVDFS(_argv[0]);
     m_pEngine = new Engine::GameEngine;
 
@@ -104,7 +118,17 @@ void REGoth::init(int _argc, char** _argv)
     // Init SavegameManager
     Engine::SavegameManager::init(*m_pEngine);
 
-    if (m_pEngine->getEngineArgs().startNewGame)
+    if (Engine::Benchmark::isRequested())
+    {
+        m_pBenchmark = std::make_unique<Engine::Benchmark>(*m_pEngine);
+        if (!m_pBenchmark->init())
+        {
+            LogError() << "Failed to initialize the benchmark, quitting";
+            setQuit(true);
+        }
+    }
+
+    if (m_pEngine->getEngineArgs().startNewGame || m_pBenchmark)
     {
         menuMain.onCustomAction("NEW_GAME");
     }
@@ -146,7 +170,7 @@ void REGoth::initConsole()
         World::WorldInstance& world = m_pEngine->getMainWorld().get();
 
         std::stringstream ss;
-        ss << "Current world GPU Memory Consumption (Rough estimate!):" << std::endl
+        ss << "GPU Memory Consumption of loaded assets (Rough estimate!):" << std::endl
            << "   - Textures: " << world.getTextureAllocator().getEstimatedGPUMemoryConsumption() / 1024 / 1024 << " mb" << std::endl
            << "   - SkeletalMeshes: " << world.getSkeletalMeshAllocator().getEstimatedGPUMemoryConsumption() / 1024 / 1024 << " mb" << std::endl
            << "   - StaticMeshes: " << world.getStaticMeshAllocator().getEstimatedGPUMemoryConsumption() / 1024 / 1024 << " mb" << std::endl;
@@ -164,6 +188,17 @@ void REGoth::initConsole()
             return ss.str();
         });
 
+        console.registerCommand("assetcache", [this](const std::vector<std::string>& args) -> std::string {
+            Content::AssetCache::Stats stats = m_pEngine->getAssetCache().getStats();
+
+            std::stringstream ss;
+            ss << "Shared assets: " << stats.numTextures << " textures, " << stats.numStaticMeshes << " static meshes, "
+               << stats.numSkeletalMeshes << " skeletal meshes. " << stats.numUnreferenced << " unused, "
+               << stats.numFreedLastCollection << " freed on the last world-change";
+
+            return ss.str();
+        });
+
         console.registerCommand("kf", [&](const std::vector<std::string>& args) -> std::string {
             if(args.size() < 2)
                 return "Missing argument. Usage: kf <idx>";
@@ -187,6 +222,40 @@ void REGoth::initConsole()
         });
 
 
+    console.registerCommand("savekf", [this](const std::vector<std::string>& args) -> std::string {
+        if (args.size() < 2)
+            return "Missing argument. Usage: savekf <file> [duration]";
+
+        json path;
+        m_pEngine->getMainWorld().get().getCameraController()->exportKeyframes(path);
+        path["duration"] = args.size() >= 3 ? atof(args[2].c_str()) : 1.0;
+
+        std::ofstream f(args[1]);
+        if (!f.is_open())
+            return "Failed to open file: " + args[1];
+
+        f << path.dump(4);
+        return "Keyframes saved to: " + args[1];
+    });
+
+    console.registerCommand("loadkf", [this](const std::vector<std::string>& args) -> std::string {
+        if (args.size() < 2)
+            return "Missing argument. Usage: loadkf <file>";
+
+        std::ifstream f(args[1]);
+        if (!f.is_open())
+            return "Failed to open file: " + args[1];
+
+        std::stringstream pathData;
+        pathData << f.rdbuf();
+
+        json path = json::parse(pathData);
+        if (!m_pEngine->getMainWorld().get().getCameraController()->importKeyframes(path))
+            return "No valid keyframes found in: " + args[1];
+
+        return "Keyframes loaded from: " + args[1];
+    });
+
     console.registerCommand("stats", [](const std::vector<std::string>& args) -> std::string {
         static bool s_Stats = false;
         s_Stats = !s_Stats;
@@ -195,6 +264,218 @@ void REGoth::initConsole()
         return "Toggled stats";
         });
 
+    console.registerCommand("profiler overlay", [](const std::vector<std::string>& args) -> std::string {
+        Utils::FrameProfiler::setOverlayEnabled(!Utils::FrameProfiler::isOverlayEnabled());
+        return Utils::FrameProfiler::isOverlayEnabled() ? "Profiler overlay enabled" : "Profiler overlay disabled";
+    }).setRequiresWorld(false);
+
+    console.registerCommand("profiler capture", [](const std::vector<std::string>& args) -> std::string {
+        if (args.size() < 3)
+            return "Missing argument. Usage: profiler capture <numFrames> [file]";
+
+        int numFrames = std::atoi(args[2].c_str());
+        if (numFrames <= 0)
+            return "Invalid number of frames: " + args[2];
+
+        std::string file = args.size() >= 4 ? args[3] : "profile.json";
+        if (!Utils::FrameProfiler::startCapture(static_cast<size_t>(numFrames), file))
+            return "A capture is already running";
+
+        return "Capturing " + std::to_string(numFrames) + " frames to " + file;
+    }).setRequiresWorld(false);
+
+    console.registerCommand("scriptstats", [this](const std::vector<std::string>& args) -> std::string {
+        auto& s = m_pEngine->getMainWorld().get().getScriptEngine();
+
+        return "Symbol-lookups by name during the last frame: " + std::to_string(s.getNumNameLookupsLastFrame());
+    });
+
+    console.registerCommand("aistats", [this](const std::vector<std::string>& args) -> std::string {
+        auto& scheduler = m_pEngine->getMainWorld().get().getAIScheduler();
+        const auto& stats = scheduler.getLastFrameStats();
+
+        std::stringstream ss;
+        ss << "NPC-AI during the last frame (scheduler " << (scheduler.isEnabled() ? "enabled" : "disabled") << "): "
+           << stats.numTicked << " ticked (" << stats.numForced << " over budget), "
+           << stats.numSkipped << " skipped, " << stats.numDeferred << " deferred, " << stats.timeMs << "ms";
+
+        return ss.str();
+    });
+
+    console.registerCommand("aischeduler", [this](const std::vector<std::string>& args) -> std::string {
+        auto& scheduler = m_pEngine->getMainWorld().get().getAIScheduler();
+
+        if (args.size() < 2)
+            return "Missing argument. Usage: aischeduler <on|off>";
+
+        scheduler.setEnabled(args[1] == "on");
+        return scheduler.isEnabled() ? "NPC-AI is now scheduled by distance" : "NPC-AI is now ticked every frame";
+    });
+
+    console.registerCommand("routinestats", [this](const std::vector<std::string>& args) -> std::string {
+        const auto& stats = m_pEngine->getMainWorld().get().getRoutineScheduler().getLastFrameStats();
+
+        std::stringstream ss;
+        ss << "Daily routines during the last frame: " << stats.numWoken << " NPCs checked, "
+           << stats.numStale << " outdated checks dropped, " << stats.numPending << " checks pending";
+
+        return ss.str();
+    });
+
+    console.registerCommand("streamstats", [this](const std::vector<std::string>& args) -> std::string {
+        if (!World::VobStreamer::isEnabled())
+            return "Vob-streaming is disabled, see --stream-vobs";
+
+        const auto& stats = m_pEngine->getMainWorld().get().getVobStreamer().getStats();
+
+        std::stringstream ss;
+        ss << "Streamed vobs: " << stats.numResidentVobs << "/" << stats.numVobs << " created in "
+           << stats.numResidentCells << "/" << stats.numCells << " cells, " << stats.numRemovedVobs << " removed. "
+           << "Last frame: " << stats.numCreated << " created, " << stats.numEvicted << " evicted";
+
+        return ss.str();
+    });
+
+    console.registerCommand("msgstats", [this](const std::vector<std::string>& args) -> std::string {
+        const auto& stats = Logic::EventMessages::MessagePools::getLastFrameStats();
+
+        std::stringstream ss;
+        ss << "Event-messages during the last frame: " << stats.numMessages << " sent, " << stats.numQueued << " queued, "
+           << stats.numPoolHits << " from pools, " << stats.numAllocations << " heap-allocations";
+
+        return ss.str();
+    }).setRequiresWorld(false);
+
+    console.registerCommand("arenastats", [this](const std::vector<std::string>& args) -> std::string {
+        const auto& stats = Memory::FrameArena::getLastFrameStats();
+
+        std::stringstream ss;
+        ss << "Frame-arenas during the last frame: " << stats.numAllocations << " allocations kept off the heap ("
+           << stats.numBytes / 1024 << " KB), " << stats.numHeapBlocks << " heap-allocations to grow the arenas";
+
+        return ss.str();
+    }).setRequiresWorld(false);
+
+    console.registerCommand("allocstats", [this](const std::vector<std::string>& args) -> std::string {
+        return Memory::AllocationTracker::getReport();
+    }).setRequiresWorld(false);
+
+    console.registerCommand("loglevel", [this](const std::vector<std::string>& args) -> std::string {
+        using namespace Utils::EngineLog;
+
+        if (args.size() == 3)
+        {
+            ELevel level;
+            if (!findLevel(args[2], level))
+                return "Unknown level: " + args[2];
+
+            if (Utils::lowered(args[1]) == "all")
+            {
+                for (int i = 0; i < Cat_Count; i++)
+                    setLevel(static_cast<ECategory>(i), level);
+            }
+            else
+            {
+                ECategory category;
+                if (!findCategory(args[1], category))
+                    return "Unknown category: " + args[1];
+
+                setLevel(category, level);
+            }
+        }
+        else if (args.size() != 1)
+        {
+            return "Usage: loglevel [category|all level]";
+        }
+
+        std::stringstream ss;
+        ss << "Log-levels:";
+        for (int i = 0; i < Cat_Count; i++)
+            ss << " " << getCategoryName(static_cast<ECategory>(i)) << "=" << getLevelName(getLevel(static_cast<ECategory>(i)));
+
+        return ss.str();
+    }).setRequiresWorld(false);
+
+    console.registerCommand("logstats", [this](const std::vector<std::string>& args) -> std::string {
+        auto stats = Utils::EngineLog::getStats();
+
+        std::stringstream ss;
+        ss << "Engine-log: " << stats.numWritten << " messages written, " << stats.numDropped << " dropped because the buffer was full, "
+           << stats.numSuppressed << " suppressed by rate-limits";
+
+        return ss.str();
+    }).setRequiresWorld(false);
+
+    console.registerCommand("sleepingworlds", [this](const std::vector<std::string>& args) -> std::string {
+        auto& session = m_pEngine->getSession();
+
+        std::stringstream ss;
+        ss << session.getInactiveWorlds().size() << " inactive worlds, " << session.getInactiveWorldsMemory() / 1024 << " KB";
+
+        for (const auto& pair : session.getInactiveWorlds())
+            ss << std::endl << " - " << pair.first << ": " << pair.second.size() / 1024 << " KB";
+
+        return ss.str();
+    }).setRequiresWorld(false);
+
+    console.registerCommand("preloadstats", [this](const std::vector<std::string>& args) -> std::string {
+        auto& world = m_pEngine->getMainWorld().get();
+
+        std::stringstream ss;
+        ss << m_pEngine->getSession().getWorldPreloader().getStatus() << std::endl
+           << world.getLevelChangeTriggers().size() << " level-changes in this world";
+
+        for (const auto& trigger : world.getLevelChangeTriggers())
+            ss << std::endl << " - " << trigger.zenFile << " (" << trigger.startVob << ")";
+
+        return ss.str();
+    });
+
+    console.registerCommand("percstats", [this](const std::vector<std::string>& args) -> std::string {
+        auto& perception = m_pEngine->getMainWorld().get().getPerceptionSystem();
+        const auto& stats = perception.getLastTickStats();
+
+        std::stringstream ss;
+        ss << "Last perception-tick (" << (perception.isEnabled() ? "enabled" : "disabled") << ", every "
+           << perception.getConfig().tickInterval << "s): " << stats.numPerceivers << " perceivers, "
+           << stats.numPairsTested << " pairs tested, " << stats.numPairsInRange << " in range, "
+           << stats.numRaysCast << " rays, " << stats.numDispatched << " dispatched, " << stats.timeMs << "ms";
+
+        return ss.str();
+    });
+
+    console.registerCommand("perception", [this](const std::vector<std::string>& args) -> std::string {
+        auto& perception = m_pEngine->getMainWorld().get().getPerceptionSystem();
+
+        if (args.size() < 2)
+            return "Missing argument. Usage: perception <on|off>";
+
+        perception.setEnabled(args[1] == "on");
+        return perception.isEnabled() ? "NPC-perceptions enabled" : "NPC-perceptions disabled";
+    });
+
+    console.registerCommand("scriptprofiler start", [this](const std::vector<std::string>& args) -> std::string {
+        auto& profiler = m_pEngine->getMainWorld().get().getScriptEngine().getProfiler();
+        profiler.setEnabled(false);
+        profiler.setEnabled(true);
+        return "Script-profiler started";
+    });
+
+    console.registerCommand("scriptprofiler stop", [this](const std::vector<std::string>& args) -> std::string {
+        m_pEngine->getMainWorld().get().getScriptEngine().getProfiler().setEnabled(false);
+        return "Script-profiler stopped. Recorded data is kept until the next start.";
+    });
+
+    console.registerCommand("scriptprofiler dump", [this](const std::vector<std::string>& args) -> std::string {
+        auto& s = m_pEngine->getMainWorld().get().getScriptEngine();
+        std::string file = args.size() >= 3 ? args[2] : "scriptprofile.folded";
+
+        if (!s.getProfiler().writeFlameGraph(file, s.getVM().getDATFile()))
+            return "Failed to write " + file;
+
+        return s.getProfiler().getSummary(s.getVM().getDATFile(), 5) + "Full report written to " + file;
+    });
+
     console.registerCommand("hud", [this](const std::vector<std::string>& args) -> std::string {
 
             if(args.size() < 2)
@@ -558,7 +839,15 @@ void REGoth::initConsole()
 
         // better do saving at frame end and not between entity updates
         this->m_pEngine->getJobManager().queueJob([index, saveGameName](Engine::BaseEngine* engine){
-            Engine::SavegameManager::saveToSlot(index, saveGameName);
+            Engine::SavegameManager::saveToSlot(index, saveGameName, [engine](const Engine::SavegameManager::SaveProgress& progress) {
+                if (!progress.done)
+                    return;
+
+                if (progress.success)
+                    engine->getConsole().outputAdd("Saved world to slot: " + std::to_string(progress.slot));
+                else
+                    engine->getConsole().outputAdd("Failed to save world to slot: " + std::to_string(progress.slot));
+            });
         });
 
         return "Saving world to slot: " + std::to_string(index) + "...";
@@ -756,9 +1045,9 @@ void REGoth::initConsole()
         if (args.size() == 1)
         {
             VobTypes::NpcVobInformation player = VobTypes::asNpcVob(worldInstance, scriptEngine.getPlayerEntity());
-            std::set<Handle::EntityHandle> nearNPCs = scriptEngine.getNPCsInRadius(player.position->m_WorldMatrix.Translation(), 3.0f);
+            Memory::FrameVector<Handle::EntityHandle> nearNPCs = scriptEngine.getNPCsInRadius(player.position->m_WorldMatrix.Translation(), 3.0f);
             // don't kill the play
-            nearNPCs.erase(scriptEngine.getPlayerEntity());
+            nearNPCs.erase(std::remove(nearNPCs.begin(), nearNPCs.end(), scriptEngine.getPlayerEntity()), nearNPCs.end());
 
             if (nearNPCs.empty())
                 return "No NPCs in range!";
@@ -1052,6 +1341,79 @@ void REGoth::initConsole()
     console.registerCommand("giveitem", giveitemCallback).registerAutoComplete(itemNamesGen);
     console.registerCommand("removeitem", removeitemCallback).registerAutoComplete(itemNamesGen);
 
+    console.registerCommand("invbench", [this](const std::vector<std::string>& args) -> std::string {
+        // Compares lookups through the inventory-index against walking the item-list, using the largest
+        // inventory in the world (usually a trader). Doesn't change any inventory.
+        size_t numLookups = args.size() >= 2 ? std::stoul(args[1]) : 100000;
+
+        auto& world = m_pEngine->getMainWorld().get();
+        auto& se = world.getScriptEngine();
+
+        VobTypes::NpcVobInformation largest;
+        largest.entity.invalidate();
+        size_t numItems = 0;
+        for (Handle::EntityHandle e : se.getWorldNPCs())
+        {
+            VobTypes::NpcVobInformation npc = VobTypes::asNpcVob(world, e);
+            if (npc.isValid() && npc.playerController->getInventory().getItems().size() > numItems)
+            {
+                largest = npc;
+                numItems = npc.playerController->getInventory().getItems().size();
+            }
+        }
+
+        if (numItems == 0)
+            return "No NPC with items found";
+
+        Logic::Inventory& inv = largest.playerController->getInventory();
+
+        // Half of the lookups hit, half look for instances the NPC doesn't have
+        std::vector<size_t> symbols;
+        for (Daedalus::GameState::ItemHandle h : inv.getItems())
+            symbols.push_back(inv.getItem(h).instanceSymbol);
+
+        se.getVM().getDATFile().iterateSymbolsOfClass("C_ITEM", [&](size_t i, Daedalus::PARSymbol&) {
+            if (symbols.size() < numItems * 2 && !inv.getItem(i).isValid())
+                symbols.push_back(i);
+        });
+
+        size_t found = 0;
+        int64_t start = bx::getHPCounter();
+        for (size_t i = 0; i < numLookups; i++)
+        {
+            size_t sym = symbols[i % symbols.size()];
+            for (Daedalus::GameState::ItemHandle h : inv.getItems())
+            {
+                if (se.getGameState().getItem(h).instanceSymbol == sym)
+                {
+                    found++;
+                    break;
+                }
+            }
+        }
+        int64_t linear = bx::getHPCounter() - start;
+
+        size_t foundIndexed = 0;
+        start = bx::getHPCounter();
+        for (size_t i = 0; i < numLookups; i++)
+        {
+            if (inv.getItemCount(symbols[i % symbols.size()]) > 0)
+                foundIndexed++;
+        }
+        int64_t indexed = bx::getHPCounter() - start;
+
+        auto toNs = [](int64_t ticks, size_t n) {
+            return double(ticks) * 1e9 / double(bx::getHPFrequency()) / double(std::max<size_t>(n, 1));
+        };
+
+        std::stringstream ss;
+        ss << numLookups << " lookups in the " << numItems << " items of " << largest.playerController->getScriptInstance().name[0]
+           << ": list-walk " << toNs(linear, numLookups) << "ns, index " << toNs(indexed, numLookups) << "ns per lookup"
+           << (found == foundIndexed ? "" : " (RESULTS DIFFER!)");
+
+        return ss.str();
+    });
+
     console.registerCommand("playsegment", [this](const auto& args) -> std::string {
         if (args.size() < 2)
             return "Usage: playsegment [segmentname]";
@@ -1087,6 +1449,7 @@ int REGoth::shutdown()
     // remove all worlds so that it shuts down properly
     m_pEngine->resetSession();
 
+    m_pBenchmark.reset();
     delete m_pEngine;
 
     ddShutdown();
@@ -1100,6 +1463,18 @@ int REGoth::shutdown()
 
     bgfx::shutdown();
 
+    Utils::EngineLog::shutdown();
+
+    // Whatever is still alive at this point was either leaked or is freed by static destructors
+    if (Memory::AllocationTracker::isEnabled())
+    {
+        std::string file = Flags::allocationReport.getParam(0);
+        if (Memory::AllocationTracker::writeReport(file))
+            LogInfo() << "Wrote allocation-report to " << file;
+        else
+            LogWarn() << "Could not write allocation-report to " << file;
+    }
+
     return REGothPlatform::shutdown();
 }
 
@@ -1148,7 +1523,11 @@ bool REGoth::update()
     const double toMs = 1000.0 / freq;
 
     float time = (float)((now - m_timeOffset) / double(bx::getHPFrequency()));
-    const float dt = float(frameTime / freq);
+    float dt = float(frameTime / freq);
+
+    // Benchmarks have to be reproducible, so they must not depend on the real frametime
+    if (m_pBenchmark)
+        dt = m_pBenchmark->getTimestep();
 
     Engine::Input::MouseState ms;
     Engine::Input::getMouseState(ms);
@@ -1163,8 +1542,18 @@ bool REGoth::update()
             uint16_t xOffset = static_cast<uint16_t>(m_pEngine->getConsole().isOpen() ? 100 : 0);
             bgfx::dbgTextPrintf(xOffset, 1, 0x4f, "REGoth-Engine (%s)", m_pEngine->getEngineArgs().startupZEN.c_str());
             bgfx::dbgTextPrintf(xOffset, 2, 0x0f, "Frame: % 7.3f[ms] %.1f[fps]", 1000.0 * dt, 1.0f / (double(dt)));
+
+            const Render::FrameStats& stats = m_pEngine->getDefaultRenderSystem().getFrameStats();
+            bgfx::dbgTextPrintf(xOffset, 3, 0x0f, "Worldmesh: %zu triangles drawn, %zu culled (%zu cells)",
+                                stats.numWorldTrianglesDrawn, stats.numWorldTrianglesCulled, stats.numWorldCellsCulled);
+            bgfx::dbgTextPrintf(xOffset, 4, 0x0f, "Triangles: %zu drawn, %zu saved by LOD. Changes: %zu programs, %zu textures, %zu meshes, %zu states",
+                                stats.numTriangles, stats.numTrianglesSavedByLod, stats.numProgramChanges, stats.numTextureChanges,
+                                stats.numMeshChanges, stats.numRenderStateChanges);
         }
 
+    // Timings of the last finished frame
+    Utils::FrameProfiler::drawOverlay(static_cast<uint16_t>(m_pEngine->getConsole().isOpen() ? 100 : 0), 5);
+
     // This dummy draw call is here to make sure that view 0 is cleared
     // if no other draw callvm.getDATFile().getSymbolByIndex(self)s are submitted to view 0.
     //bgfx::touch(0);
@@ -1180,6 +1569,7 @@ bool REGoth::update()
         // Set render states.
 
         {
+            RE_PROFILE_SCOPE("UI::update");
             auto& cfg = m_pEngine->getDefaultRenderSystem().getConfig();
             float gameSpeed = m_pEngine->getGameClock().getGameEngineSpeedFactor();
             if(m_HUDMode == 0)
@@ -1222,7 +1612,15 @@ bool REGoth::update()
 
     // Advance to next frame. Rendering thread will be kicked to
     // process submitted rendering primitives.
-    bgfx::frame();
+    {
+        RE_PROFILE_SCOPE("bgfx::frame");
+        bgfx::frame();
+    }
+
+    Utils::FrameProfiler::onFrameEnd();
+
+    if (m_pBenchmark && m_pBenchmark->onFrameEnd())
+        setQuit(true);
 
     return true;
 }
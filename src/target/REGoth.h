@@ -1,5 +1,6 @@
 #pragma once
 #include "bgfx_utils.h"
+#include <engine/Benchmark.h>
 #include <engine/GameEngine.h>
 #include <engine/World.h>
 #include <utils/bgfx_lib.h>
@@ -24,6 +25,7 @@ public:
     void showSplash();
 
         Engine::GameEngine* m_pEngine;
+        std::unique_ptr<Engine::Benchmark> m_pBenchmark;
         uint32_t m_debug;
         uint32_t m_reset;
         uint32_t m_Width, m_Height;
@@ -84,7 +84,13 @@ void Menu_Save::onCustomAction(const std::string& action)
         else
         {
             m_isWaitingForSaveName = false;
-            Engine::SavegameManager::saveToSlot(index, m_SaveName);
+
+            // better do saving at frame end and not between entity updates
+            std::string saveName = m_SaveName;
+            m_Engine.getJobManager().queueJob([index, saveName](Engine::BaseEngine* engine) {
+                Engine::SavegameManager::saveToSlot(index, saveName);
+            });
+
             // close menus after saving
             getHud().popAllMenus();
         }
@@ -0,0 +1,517 @@
+#include "EngineLog.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utils/cli.h>
+#include <utils/logger.h>
+#include <utils/Utils.h>
+
+using namespace Utils;
+
+namespace Flags
+{
+    Cli::Flag logLevels("", "log-levels", 1, "Comma-separated list of category=level, ie. script=trace,world=debug. Categories: engine, world, script, content, savegame, physics, render, audio, all. Levels: trace, debug, info, warn, error, off", {""});
+}
+
+/**
+ * Formats straight into a fixed array, anything past its end is cut off. Messages don't allocate this way.
+ */
+struct EngineLog::LineBuffer : public std::streambuf
+{
+    LineBuffer()
+        : stream(this)
+    {
+        reset();
+    }
+
+    void reset()
+    {
+        setp(text, text + sizeof(text) - 1);
+        stream.clear();
+    }
+
+    /**
+     * @return Text written so far, null-terminated
+     */
+    const char* terminate()
+    {
+        *pptr() = '\0';
+        return text;
+    }
+
+    size_t length() const
+    {
+        return static_cast<size_t>(pptr() - pbase());
+    }
+
+    char text[480 + 1];
+    std::ostream stream;
+    bool inUse = false;
+};
+
+std::atomic<uint8_t> EngineLog::s_Levels[Cat_Count] = {
+    {Level_Info},
+    {Level_Info},
+    {Level_Info},
+    {Level_Info},
+    {Level_Info},
+    {Level_Info},
+    {Level_Info},
+    {Level_Info},
+};
+
+namespace
+{
+    /**
+     * Must be a power of two
+     */
+    const size_t NUM_SLOTS = 1024;
+
+    /**
+     * Longer messages are cut off
+     */
+    const size_t MAX_MESSAGE_LENGTH = sizeof(EngineLog::LineBuffer::text) - 1;
+
+    /**
+     * How long the writer sleeps once the buffer is empty
+     */
+    const auto WRITER_IDLE_TIME = std::chrono::milliseconds(5);
+
+    struct Slot
+    {
+        /**
+         * Position in the queue this slot is ready for. Equal to the position: free to write. One more: written.
+         */
+        std::atomic<size_t> sequence;
+
+        EngineLog::ECategory category;
+        EngineLog::ELevel level;
+        const char* file;
+        int line;
+        char text[MAX_MESSAGE_LENGTH + 1];
+    };
+
+    /**
+     * Bounded multi-producer/single-consumer queue. Producers claim a position with a single compare-and-swap,
+     * the sequence-number of the slot tells them whether the consumer is done with it.
+     */
+    class RingBuffer
+    {
+    public:
+        RingBuffer()
+            : m_Slots(new Slot[NUM_SLOTS])
+            , m_WritePos(0)
+            , m_ReadPos(0)
+        {
+            for (size_t i = 0; i < NUM_SLOTS; i++)
+                m_Slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        /**
+         * @return Slot to fill in, nullptr if the buffer is full. Must be handed to commit() afterwards.
+         */
+        Slot* claim(size_t& pos)
+        {
+            pos = m_WritePos.load(std::memory_order_relaxed);
+            while (true)
+            {
+                Slot& slot = m_Slots[pos & (NUM_SLOTS - 1)];
+                intptr_t diff = static_cast<intptr_t>(slot.sequence.load(std::memory_order_acquire)) - static_cast<intptr_t>(pos);
+
+                if (diff == 0)
+                {
+                    if (m_WritePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        return &slot;
+                }
+                else if (diff < 0)
+                {
+                    return nullptr;
+                }
+                else
+                {
+                    pos = m_WritePos.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        void commit(Slot* slot, size_t pos)
+        {
+            slot->sequence.store(pos + 1, std::memory_order_release);
+        }
+
+        /**
+         * @return Oldest written slot, nullptr if there is none. Must be handed to release() afterwards. Consumer only.
+         */
+        Slot* peek()
+        {
+            Slot& slot = m_Slots[m_ReadPos & (NUM_SLOTS - 1)];
+            if (slot.sequence.load(std::memory_order_acquire) != m_ReadPos + 1)
+                return nullptr;
+
+            return &slot;
+        }
+
+        void release(Slot* slot)
+        {
+            slot->sequence.store(m_ReadPos + NUM_SLOTS, std::memory_order_release);
+            m_ReadPos++;
+        }
+
+    private:
+        std::unique_ptr<Slot[]> m_Slots;
+        std::atomic<size_t> m_WritePos;
+        size_t m_ReadPos;
+    };
+
+    RingBuffer s_Buffer;
+
+    std::atomic<uint64_t> s_NumWritten(0);
+    std::atomic<uint64_t> s_NumDropped(0);
+
+    /**
+     * Dropped messages the writer hasn't told about yet
+     */
+    std::atomic<uint64_t> s_NumDroppedUnreported(0);
+    std::atomic<uint64_t> s_NumSuppressed(0);
+
+    /**
+     * Writer-thread. Started with the first message.
+     */
+    std::mutex s_WriterMutex;
+    std::thread s_Writer;
+    std::atomic<bool> s_WriterRunning(false);
+    std::atomic<bool> s_ShutDown(false);
+
+    void write(EngineLog::ECategory category, EngineLog::ELevel level, const char* file, int line, const char* text)
+    {
+        // The file of the call-site is lost when going through the regular logger, so add it to the message
+        const char* name = file;
+        for (const char* c = file; *c; c++)
+        {
+            if (*c == '/' || *c == '\\')
+                name = c + 1;
+        }
+
+        switch (level)
+        {
+            case EngineLog::Level_Warn:
+                LogWarn() << "[" << EngineLog::getCategoryName(category) << "] " << text << " (" << name << ":" << line << ")";
+                break;
+
+            case EngineLog::Level_Error:
+                LogError() << "[" << EngineLog::getCategoryName(category) << "] " << text << " (" << name << ":" << line << ")";
+                break;
+
+            default:
+                LogInfo() << "[" << EngineLog::getCategoryName(category) << "/" << EngineLog::getLevelName(level) << "] "
+                          << text << " (" << name << ":" << line << ")";
+                break;
+        }
+
+        s_NumWritten.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @return Whether anything was written
+     */
+    bool drain()
+    {
+        bool any = false;
+        while (Slot* slot = s_Buffer.peek())
+        {
+            write(slot->category, slot->level, slot->file, slot->line, slot->text);
+            s_Buffer.release(slot);
+            any = true;
+        }
+
+        // Only reported once there is room again
+        uint64_t dropped = s_NumDroppedUnreported.exchange(0, std::memory_order_relaxed);
+        if (dropped > 0)
+            LogWarn() << "Log-buffer was full, dropped " << dropped << " messages";
+
+        return any;
+    }
+
+    void writerThread()
+    {
+        while (s_WriterRunning.load(std::memory_order_acquire))
+        {
+            if (!drain())
+                std::this_thread::sleep_for(WRITER_IDLE_TIME);
+        }
+
+        drain();
+    }
+
+    void startWriter()
+    {
+        if (s_WriterRunning.load(std::memory_order_acquire))
+            return;
+
+        std::lock_guard<std::mutex> guard(s_WriterMutex);
+        if (s_WriterRunning.load(std::memory_order_relaxed) || s_ShutDown.load(std::memory_order_relaxed))
+            return;
+
+        s_WriterRunning.store(true, std::memory_order_release);
+        s_Writer = std::thread(writerThread);
+    }
+
+    /**
+     * Stops the writer if the program exits without calling shutdown(), so the thread isn't destroyed while running
+     */
+    struct WriterGuard
+    {
+        ~WriterGuard()
+        {
+            EngineLog::shutdown();
+        }
+    } s_WriterGuard;
+
+    /**
+     * @return Milliseconds since an arbitrary point
+     */
+    int64_t nowMs()
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    EngineLog::LineBuffer& getThreadBuffer()
+    {
+        static thread_local EngineLog::LineBuffer b;
+        return b;
+    }
+}
+
+void EngineLog::setLevel(ECategory category, ELevel level)
+{
+    s_Levels[category].store(level, std::memory_order_relaxed);
+}
+
+EngineLog::ELevel EngineLog::getLevel(ECategory category)
+{
+    return static_cast<ELevel>(s_Levels[category].load(std::memory_order_relaxed));
+}
+
+const char* EngineLog::getCategoryName(ECategory category)
+{
+    switch (category)
+    {
+        case Cat_Engine:
+            return "engine";
+        case Cat_World:
+            return "world";
+        case Cat_Script:
+            return "script";
+        case Cat_Content:
+            return "content";
+        case Cat_Savegame:
+            return "savegame";
+        case Cat_Physics:
+            return "physics";
+        case Cat_Render:
+            return "render";
+        case Cat_Audio:
+            return "audio";
+        default:
+            return "unknown";
+    }
+}
+
+const char* EngineLog::getLevelName(ELevel level)
+{
+    switch (level)
+    {
+        case Level_Trace:
+            return "trace";
+        case Level_Debug:
+            return "debug";
+        case Level_Info:
+            return "info";
+        case Level_Warn:
+            return "warn";
+        case Level_Error:
+            return "error";
+        case Level_Off:
+            return "off";
+        default:
+            return "unknown";
+    }
+}
+
+bool EngineLog::findCategory(const std::string& name, ECategory& out)
+{
+    std::string lower = Utils::lowered(name);
+    for (int i = 0; i < Cat_Count; i++)
+    {
+        if (lower == getCategoryName(static_cast<ECategory>(i)))
+        {
+            out = static_cast<ECategory>(i);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool EngineLog::findLevel(const std::string& name, ELevel& out)
+{
+    std::string lower = Utils::lowered(name);
+    for (int i = 0; i <= Level_Off; i++)
+    {
+        if (lower == getLevelName(static_cast<ELevel>(i)))
+        {
+            out = static_cast<ELevel>(i);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void EngineLog::init()
+{
+    std::stringstream ss(Flags::logLevels.getParam(0));
+    std::string entry;
+    while (std::getline(ss, entry, ','))
+    {
+        if (entry.empty())
+            continue;
+
+        size_t eq = entry.find('=');
+        std::string category = entry.substr(0, eq);
+
+        ELevel level;
+        if (eq == std::string::npos || !findLevel(entry.substr(eq + 1), level))
+        {
+            LogWarn() << "--log-levels: Invalid entry '" << entry << "'";
+            continue;
+        }
+
+        ECategory cat;
+        if (Utils::lowered(category) == "all")
+        {
+            for (int i = 0; i < Cat_Count; i++)
+                setLevel(static_cast<ECategory>(i), level);
+        }
+        else if (findCategory(category, cat))
+        {
+            setLevel(cat, level);
+        }
+        else
+        {
+            LogWarn() << "--log-levels: Unknown category '" << category << "'";
+        }
+    }
+}
+
+void EngineLog::shutdown()
+{
+    std::lock_guard<std::mutex> guard(s_WriterMutex);
+    s_ShutDown.store(true, std::memory_order_relaxed);
+
+    if (!s_WriterRunning.exchange(false, std::memory_order_acq_rel))
+        return;
+
+    s_Writer.join();
+}
+
+EngineLog::Stats EngineLog::getStats()
+{
+    Stats s;
+    s.numWritten = s_NumWritten.load(std::memory_order_relaxed);
+    s.numDropped = s_NumDropped.load(std::memory_order_relaxed);
+    s.numSuppressed = s_NumSuppressed.load(std::memory_order_relaxed);
+
+    return s;
+}
+
+EngineLog::RateLimiter::RateLimiter(uint32_t perSecond)
+    : m_PerSecond(perSecond)
+    , m_WindowStart(nowMs())
+    , m_NumInWindow(0)
+    , m_NumSuppressed(0)
+{
+}
+
+EngineLog::RateLimiter::Pass EngineLog::RateLimiter::pass()
+{
+    int64_t now = nowMs();
+    int64_t start = m_WindowStart.load(std::memory_order_relaxed);
+
+    // Whichever thread moves the window on, resets the count
+    if (now - start >= 1000 && m_WindowStart.compare_exchange_strong(start, now, std::memory_order_relaxed))
+        m_NumInWindow.store(0, std::memory_order_relaxed);
+
+    Pass p;
+    if (m_NumInWindow.fetch_add(1, std::memory_order_relaxed) < m_PerSecond)
+    {
+        p.allowed = true;
+        p.numSuppressed = m_NumSuppressed.exchange(0, std::memory_order_relaxed);
+    }
+    else
+    {
+        m_NumSuppressed.fetch_add(1, std::memory_order_relaxed);
+        s_NumSuppressed.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return p;
+}
+
+EngineLog::Message::Message(ECategory category, ELevel level, const char* file, int line, uint32_t numSuppressed)
+    : m_Category(category)
+    , m_Level(level)
+    , m_File(file)
+    , m_Line(line)
+    , m_NumSuppressed(numSuppressed)
+{
+    LineBuffer& tb = getThreadBuffer();
+    m_OwnsBuffer = tb.inUse;
+
+    // Something streamed into another message logs as well
+    m_pBuffer = m_OwnsBuffer ? new LineBuffer : &tb;
+    m_pBuffer->inUse = true;
+    m_pBuffer->reset();
+
+    m_pStream = &m_pBuffer->stream;
+}
+
+EngineLog::Message::~Message()
+{
+    if (m_NumSuppressed > 0)
+        *m_pStream << " (" << m_NumSuppressed << " more suppressed)";
+
+    const char* text = m_pBuffer->terminate();
+
+    if (s_ShutDown.load(std::memory_order_relaxed))
+    {
+        write(m_Category, m_Level, m_File, m_Line, text);
+    }
+    else
+    {
+        startWriter();
+
+        size_t pos;
+        if (Slot* slot = s_Buffer.claim(pos))
+        {
+            slot->category = m_Category;
+            slot->level = m_Level;
+            slot->file = m_File;
+            slot->line = m_Line;
+            memcpy(slot->text, text, m_pBuffer->length() + 1);
+
+            s_Buffer.commit(slot, pos);
+        }
+        else
+        {
+            s_NumDropped.fetch_add(1, std::memory_order_relaxed);
+            s_NumDroppedUnreported.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    m_pBuffer->inUse = false;
+    if (m_OwnsBuffer)
+        delete m_pBuffer;
+}
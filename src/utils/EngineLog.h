@@ -0,0 +1,203 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+/**
+ * Levels below this are compiled out entirely, including the expressions streamed into them.
+ * 0 keeps everything, so all levels can be switched on at runtime.
+ */
+#ifndef RE_LOG_MIN_LEVEL
+#define RE_LOG_MIN_LEVEL 0
+#endif
+
+#define RE_LOG_IS_ENABLED(category, level)                     \
+    (Utils::EngineLog::Level_##level >= RE_LOG_MIN_LEVEL && \
+     Utils::EngineLog::isEnabled(Utils::EngineLog::Cat_##category, Utils::EngineLog::Level_##level))
+
+/**
+ * Logs a message of the given category and level, ie. RE_LOG(World, Debug) << "Loaded " << name;
+ * Nothing after the macro is evaluated if the level is disabled.
+ */
+#define RE_LOG(category, level)               \
+    if (!RE_LOG_IS_ENABLED(category, level)) \
+        ;                                     \
+    else                                      \
+        Utils::EngineLog::Message(Utils::EngineLog::Cat_##category, Utils::EngineLog::Level_##level, __FILE__, __LINE__)
+
+/**
+ * Like RE_LOG, but lets through at most perSecond messages per second from this call-site. The number of
+ * messages dropped in between is appended to the next one let through.
+ */
+#define RE_LOG_LIMITED(category, level, perSecond)                                                                      \
+    for (Utils::EngineLog::RateLimiter::Pass _reLogPass = RE_LOG_IS_ENABLED(category, level)                           \
+                                                              ? []() -> Utils::EngineLog::RateLimiter& {               \
+                                                                    static Utils::EngineLog::RateLimiter l(perSecond); \
+                                                                    return l;                                          \
+                                                                }().pass()                                             \
+                                                              : Utils::EngineLog::RateLimiter::Pass();                 \
+         _reLogPass.allowed;                                                                                            \
+         _reLogPass.allowed = false)                                                                                    \
+    Utils::EngineLog::Message(Utils::EngineLog::Cat_##category, Utils::EngineLog::Level_##level, __FILE__, __LINE__, _reLogPass.numSuppressed)
+
+#define RE_LOG_TRACE(category) RE_LOG(category, Trace)
+#define RE_LOG_DEBUG(category) RE_LOG(category, Debug)
+#define RE_LOG_INFO(category) RE_LOG(category, Info)
+#define RE_LOG_WARN(category) RE_LOG(category, Warn)
+#define RE_LOG_ERROR(category) RE_LOG(category, Error)
+
+namespace Utils
+{
+    /**
+     * Log-sink for the engine, meant for hot paths.
+     *
+     * The calling thread only formats its message into a slot of a lock-free ring-buffer. A background-thread drains
+     * the buffer and hands the messages to the regular logger, so writing to the console and log-file happens off the
+     * calling thread. Should the buffer ever run full, messages are dropped instead of blocking the caller, and the
+     * number of dropped messages is logged once there is room again.
+     *
+     * Every category has its own level, which can be changed at runtime via the console-command "loglevel" or at
+     * startup via --log-levels. Levels below RE_LOG_MIN_LEVEL are removed at compile time.
+     */
+    namespace EngineLog
+    {
+        enum ECategory : uint8_t
+        {
+            Cat_Engine,
+            Cat_World,
+            Cat_Script,
+            Cat_Content,
+            Cat_Savegame,
+            Cat_Physics,
+            Cat_Render,
+            Cat_Audio,
+
+            Cat_Count
+        };
+
+        enum ELevel : uint8_t
+        {
+            Level_Trace,
+            Level_Debug,
+            Level_Info,
+            Level_Warn,
+            Level_Error,
+            Level_Off,
+        };
+
+        /**
+         * Current level per category, don't access directly
+         */
+        extern std::atomic<uint8_t> s_Levels[Cat_Count];
+
+        /**
+         * @return Whether messages of the given level are let through for the given category
+         */
+        inline bool isEnabled(ECategory category, ELevel level)
+        {
+            return level >= s_Levels[category].load(std::memory_order_relaxed);
+        }
+
+        void setLevel(ECategory category, ELevel level);
+        ELevel getLevel(ECategory category);
+
+        const char* getCategoryName(ECategory category);
+        const char* getLevelName(ELevel level);
+
+        /**
+         * Looks up a category or level by its name, case insensitive
+         * @return false, if there is none with that name
+         */
+        bool findCategory(const std::string& name, ECategory& out);
+        bool findLevel(const std::string& name, ELevel& out);
+
+        /**
+         * Applies the levels given by --log-levels. To be called once the commandline was parsed.
+         */
+        void init();
+
+        /**
+         * Writes out everything still in the buffer and stops the background-thread. Messages logged afterwards are
+         * written directly.
+         */
+        void shutdown();
+
+        struct Stats
+        {
+            uint64_t numWritten = 0;
+            uint64_t numDropped = 0;
+            uint64_t numSuppressed = 0;
+        };
+
+        /**
+         * @return Counters since the start of the program
+         */
+        Stats getStats();
+
+        /**
+         * Per call-site limit, see RE_LOG_LIMITED
+         */
+        class RateLimiter
+        {
+        public:
+            struct Pass
+            {
+                bool allowed = false;
+
+                // Messages dropped since the last one let through
+                uint32_t numSuppressed = 0;
+            };
+
+            RateLimiter(uint32_t perSecond);
+
+            /**
+             * Counts a message of this call-site
+             */
+            Pass pass();
+
+        private:
+            uint32_t m_PerSecond;
+            std::atomic<int64_t> m_WindowStart;
+            std::atomic<uint32_t> m_NumInWindow;
+            std::atomic<uint32_t> m_NumSuppressed;
+        };
+
+        /**
+         * Fixed-size buffer a message is formatted into
+         */
+        struct LineBuffer;
+
+        /**
+         * Collects a single message and queues it once destroyed. Use through the RE_LOG-macros.
+         */
+        class Message
+        {
+        public:
+            Message(ECategory category, ELevel level, const char* file, int line, uint32_t numSuppressed = 0);
+            ~Message();
+
+            template <typename T>
+            Message& operator<<(const T& value)
+            {
+                *m_pStream << value;
+                return *this;
+            }
+
+        private:
+            ECategory m_Category;
+            ELevel m_Level;
+            const char* m_File;
+            int m_Line;
+            uint32_t m_NumSuppressed;
+
+            /**
+             * Buffer reused by all messages of the thread. Only messages created while another one is still being
+             * streamed into get one of their own.
+             */
+            LineBuffer* m_pBuffer;
+            bool m_OwnsBuffer;
+            std::ostream* m_pStream;
+        };
+    }
+}
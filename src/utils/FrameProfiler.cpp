@@ -0,0 +1,340 @@
+#include "FrameProfiler.h"
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <bgfx/bgfx.h>
+#include <bx/timer.h>
+#include <json.hpp>
+#include <utils/logger.h>
+
+using namespace Utils;
+using json = nlohmann::json;
+
+namespace
+{
+    /**
+     * Events recorded by a single thread. The owning thread only ever contends with the main thread
+     * collecting the buffer at frame end, so the lock is practically always free.
+     */
+    struct ThreadBuffer
+    {
+        std::mutex mutex;
+        std::vector<FrameProfiler::Event> events;
+        std::string name;
+        uint32_t threadId = 0;
+
+        // Only touched by the owning thread
+        uint32_t depth = 0;
+    };
+
+    /**
+     * Internal version of ScopeStat, also knowing its parent
+     */
+    struct StatNode
+    {
+        FrameProfiler::ScopeStat stat;
+        int parent;
+    };
+
+    std::mutex s_RegistryMutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> s_ThreadBuffers;
+    std::atomic<uint32_t> s_NextThreadId(0);
+
+    /**
+     * Whether scopes should record anything at all
+     */
+    std::atomic<bool> s_Recording(false);
+    bool s_OverlayEnabled = false;
+
+    /**
+     * Capture state. Only touched by the main thread, except for s_Capturing.
+     */
+    std::atomic<bool> s_Capturing(false);
+    size_t s_CaptureFramesLeft = 0;
+    std::string s_CaptureFile;
+    std::vector<FrameProfiler::Event> s_CapturedEvents;
+    std::vector<int64_t> s_CapturedFrameEnds;
+
+    std::vector<FrameProfiler::ScopeStat> s_LastFrameStats;
+
+    ThreadBuffer& getThreadBuffer()
+    {
+        thread_local std::shared_ptr<ThreadBuffer> s_Buffer;
+
+        if (!s_Buffer)
+        {
+            s_Buffer = std::make_shared<ThreadBuffer>();
+            s_Buffer->threadId = s_NextThreadId++;
+            s_Buffer->name = "Thread " + std::to_string(s_Buffer->threadId);
+
+            std::lock_guard<std::mutex> guard(s_RegistryMutex);
+            s_ThreadBuffers.push_back(s_Buffer);
+        }
+
+        return *s_Buffer;
+    }
+
+    void updateRecordingState()
+    {
+        s_Recording = s_OverlayEnabled || s_Capturing;
+    }
+
+    /**
+     * Moves the events of all threads into the given vector. Buffers of threads which have ended get dropped.
+     */
+    void collectEvents(std::vector<FrameProfiler::Event>& out)
+    {
+        std::lock_guard<std::mutex> guard(s_RegistryMutex);
+
+        for (auto& buffer : s_ThreadBuffers)
+        {
+            std::lock_guard<std::mutex> bufferGuard(buffer->mutex);
+            out.insert(out.end(), buffer->events.begin(), buffer->events.end());
+            buffer->events.clear();
+        }
+
+        // Only the registry is holding a reference -> thread is gone
+        s_ThreadBuffers.erase(std::remove_if(s_ThreadBuffers.begin(), s_ThreadBuffers.end(), [](const std::shared_ptr<ThreadBuffer>& b) {
+                                  return b.use_count() == 1;
+                              }),
+                              s_ThreadBuffers.end());
+    }
+
+    /**
+     * Aggregates the events of the given thread into a tree of scopes, in depth-first order
+     */
+    void buildFrameStats(std::vector<FrameProfiler::Event> events, uint32_t threadId)
+    {
+        const double toMs = 1000.0 / double(bx::getHPFrequency());
+
+        events.erase(std::remove_if(events.begin(), events.end(), [&](const FrameProfiler::Event& e) {
+                         return e.threadId != threadId;
+                     }),
+                     events.end());
+
+        // Parents start before (or together with) their children
+        std::sort(events.begin(), events.end(), [](const FrameProfiler::Event& a, const FrameProfiler::Event& b) {
+            return a.start != b.start ? a.start < b.start : a.depth < b.depth;
+        });
+
+        std::vector<StatNode> nodes;
+        std::vector<int> openNodeByDepth;
+        for (const FrameProfiler::Event& e : events)
+        {
+            openNodeByDepth.resize(e.depth + 1, -1);
+            int parent = e.depth > 0 ? openNodeByDepth[e.depth - 1] : -1;
+
+            auto it = std::find_if(nodes.begin(), nodes.end(), [&](const StatNode& n) {
+                return n.parent == parent && n.stat.depth == e.depth && std::string(n.stat.name) == e.name;
+            });
+
+            if (it == nodes.end())
+            {
+                nodes.push_back({{e.name, e.depth, 0, 0.0}, parent});
+                it = nodes.end() - 1;
+            }
+
+            it->stat.numCalls++;
+            it->stat.milliseconds += (e.end - e.start) * toMs;
+            openNodeByDepth[e.depth] = (int)(it - nodes.begin());
+        }
+
+        // Flatten in depth-first order, so children show up below their parents
+        s_LastFrameStats.clear();
+        std::function<void(int)> emitChildren = [&](int parent) {
+            for (size_t i = 0; i < nodes.size(); i++)
+            {
+                if (nodes[i].parent != parent)
+                    continue;
+
+                s_LastFrameStats.push_back(nodes[i].stat);
+                emitChildren((int)i);
+            }
+        };
+        emitChildren(-1);
+    }
+
+    void writeCapture()
+    {
+        if (s_CapturedEvents.empty())
+        {
+            LogWarn() << "Profiler: Nothing was recorded, not writing " << s_CaptureFile;
+            return;
+        }
+
+        const double toUs = 1000000.0 / double(bx::getHPFrequency());
+
+        int64_t base = s_CapturedEvents.front().start;
+        for (const FrameProfiler::Event& e : s_CapturedEvents)
+            base = std::min(base, e.start);
+
+        json trace;
+        json& traceEvents = trace["traceEvents"];
+
+        {
+            std::lock_guard<std::mutex> guard(s_RegistryMutex);
+            for (auto& buffer : s_ThreadBuffers)
+            {
+                std::lock_guard<std::mutex> bufferGuard(buffer->mutex);
+                traceEvents.push_back({{"name", "thread_name"},
+                                       {"ph", "M"},
+                                       {"pid", 0},
+                                       {"tid", buffer->threadId},
+                                       {"args", {{"name", buffer->name}}}});
+            }
+        }
+
+        for (const FrameProfiler::Event& e : s_CapturedEvents)
+        {
+            traceEvents.push_back({{"name", e.name},
+                                   {"cat", "REGoth"},
+                                   {"ph", "X"},
+                                   {"pid", 0},
+                                   {"tid", e.threadId},
+                                   {"ts", (e.start - base) * toUs},
+                                   {"dur", (e.end - e.start) * toUs}});
+        }
+
+        for (int64_t frameEnd : s_CapturedFrameEnds)
+        {
+            traceEvents.push_back({{"name", "FrameEnd"},
+                                   {"ph", "i"},
+                                   {"s", "g"},
+                                   {"pid", 0},
+                                   {"tid", 0},
+                                   {"ts", (frameEnd - base) * toUs}});
+        }
+
+        std::ofstream f(s_CaptureFile);
+        if (!f.is_open())
+        {
+            LogError() << "Profiler: Failed to open " << s_CaptureFile << " for writing";
+            return;
+        }
+
+        f << trace.dump();
+        LogInfo() << "Profiler: Wrote " << s_CapturedEvents.size() << " events of " << s_CapturedFrameEnds.size()
+                  << " frames to " << s_CaptureFile;
+    }
+}
+
+FrameProfiler::Scope::Scope(const char* name)
+    : m_Name(name)
+    , m_Start(0)
+    , m_Active(s_Recording.load(std::memory_order_relaxed))
+{
+    if (!m_Active)
+        return;
+
+    getThreadBuffer().depth++;
+    m_Start = bx::getHPCounter();
+}
+
+FrameProfiler::Scope::~Scope()
+{
+    if (!m_Active)
+        return;
+
+    int64_t end = bx::getHPCounter();
+    ThreadBuffer& buffer = getThreadBuffer();
+    buffer.depth--;
+
+    std::lock_guard<std::mutex> guard(buffer.mutex);
+    buffer.events.push_back({m_Name, m_Start, end, buffer.depth, buffer.threadId});
+}
+
+void FrameProfiler::onFrameEnd()
+{
+    if (!s_Recording)
+        return;
+
+    const int64_t frameEnd = bx::getHPCounter();
+    const uint32_t mainThreadId = getThreadBuffer().threadId;
+
+    std::vector<Event> events;
+    collectEvents(events);
+
+    if (s_OverlayEnabled)
+        buildFrameStats(events, mainThreadId);
+
+    if (s_Capturing)
+    {
+        s_CapturedEvents.insert(s_CapturedEvents.end(), events.begin(), events.end());
+        s_CapturedFrameEnds.push_back(frameEnd);
+
+        s_CaptureFramesLeft--;
+        if (s_CaptureFramesLeft == 0)
+        {
+            writeCapture();
+
+            s_CapturedEvents.clear();
+            s_CapturedFrameEnds.clear();
+            s_Capturing = false;
+            updateRecordingState();
+        }
+    }
+}
+
+bool FrameProfiler::startCapture(size_t numFrames, const std::string& file)
+{
+    if (s_Capturing || numFrames == 0)
+        return false;
+
+    setThreadName("Main");
+
+    s_CaptureFramesLeft = numFrames;
+    s_CaptureFile = file;
+    s_CapturedEvents.clear();
+    s_CapturedFrameEnds.clear();
+    s_Capturing = true;
+    updateRecordingState();
+
+    return true;
+}
+
+bool FrameProfiler::isCapturing()
+{
+    return s_Capturing;
+}
+
+void FrameProfiler::setOverlayEnabled(bool enabled)
+{
+    s_OverlayEnabled = enabled;
+    s_LastFrameStats.clear();
+    updateRecordingState();
+}
+
+bool FrameProfiler::isOverlayEnabled()
+{
+    return s_OverlayEnabled;
+}
+
+void FrameProfiler::drawOverlay(uint16_t x, uint16_t y)
+{
+    if (!s_OverlayEnabled)
+        return;
+
+    bgfx::dbgTextPrintf(x, y, 0x4f, "Profiler [ms]%s", s_Capturing ? " (capturing)" : "");
+
+    uint16_t row = y + 1;
+    for (const ScopeStat& s : s_LastFrameStats)
+    {
+        bgfx::dbgTextPrintf(x, row++, 0x0f, "%*s%s: %.3f (%u)", (int)s.depth * 2, "", s.name, s.milliseconds, s.numCalls);
+    }
+}
+
+const std::vector<FrameProfiler::ScopeStat>& FrameProfiler::getLastFrameStats()
+{
+    return s_LastFrameStats;
+}
+
+void FrameProfiler::setThreadName(const std::string& name)
+{
+    ThreadBuffer& buffer = getThreadBuffer();
+
+    std::lock_guard<std::mutex> guard(buffer.mutex);
+    buffer.name = name;
+}
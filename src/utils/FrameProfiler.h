@@ -0,0 +1,102 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Opens a profiling-scope which lasts until the end of the current block.
+ * Name must be a string-literal (or otherwise outlive the profiler).
+ */
+#define RE_PROFILE_CONCAT_INNER(a, b) a##b
+#define RE_PROFILE_CONCAT(a, b) RE_PROFILE_CONCAT_INNER(a, b)
+#define RE_PROFILE_SCOPE(name) Utils::FrameProfiler::Scope RE_PROFILE_CONCAT(_profileScope, __LINE__)(name)
+
+namespace Utils
+{
+    /**
+     * Lightweight, thread-aware scoped profiler. Scopes are recorded into per-thread buffers and collected
+     * once per frame by the main thread. Recording is disabled unless the overlay is shown or a capture is running,
+     * so an idle scope costs a single atomic load.
+     */
+    namespace FrameProfiler
+    {
+        /**
+         * A single timed scope as recorded by one thread
+         */
+        struct Event
+        {
+            const char* name;
+            int64_t start;  // bx::getHPCounter() ticks
+            int64_t end;
+            uint32_t depth;
+            uint32_t threadId;
+        };
+
+        /**
+         * Aggregated timing of one scope of the main thread, used by the overlay
+         */
+        struct ScopeStat
+        {
+            const char* name;
+            uint32_t depth;
+            uint32_t numCalls;
+            double milliseconds;
+        };
+
+        /**
+         * RAII-helper, see RE_PROFILE_SCOPE
+         */
+        class Scope
+        {
+        public:
+            Scope(const char* name);
+            ~Scope();
+
+        private:
+            const char* m_Name;
+            int64_t m_Start;
+            bool m_Active;
+        };
+
+        /**
+         * Must be called once per frame by the main thread, after all frame-work has been done.
+         * Collects the events of all threads, updates the overlay-data and feeds running captures.
+         */
+        void onFrameEnd();
+
+        /**
+         * Starts capturing the next numFrames frames. Once done, they are written to the given file
+         * in the Chrome trace-event format (load via chrome://tracing).
+         * @return false, if a capture is already running
+         */
+        bool startCapture(size_t numFrames, const std::string& file);
+
+        /**
+         * @return Whether a capture is currently in progress
+         */
+        bool isCapturing();
+
+        /**
+         * Enables/Disables collection of data for the in-game overlay
+         */
+        void setOverlayEnabled(bool enabled);
+        bool isOverlayEnabled();
+
+        /**
+         * Prints the scopes of the last frame using the bgfx debug-text
+         * @param x Column to start at
+         * @param y Row to start at
+         */
+        void drawOverlay(uint16_t x, uint16_t y);
+
+        /**
+         * @return Aggregated main-thread scopes of the last finished frame
+         */
+        const std::vector<ScopeStat>& getLastFrameStats();
+
+        /**
+         * Names the calling thread inside the trace-output
+         */
+        void setThreadName(const std::string& name);
+    }
+}
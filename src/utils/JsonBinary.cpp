@@ -0,0 +1,365 @@
+#include "JsonBinary.h"
+#include <cstring>
+#include <deque>
+#include <string>
+#include <unordered_map>
+
+using json = nlohmann::json;
+
+namespace
+{
+    const uint8_t FORMAT_VERSION = 1;
+
+    /**
+     * Type of the value following in the stream
+     */
+    enum ETag : uint8_t
+    {
+        T_Null,
+        T_False,
+        T_True,
+        T_Int,        // Zigzag-encoded varint
+        T_Unsigned,   // Varint
+        T_Float32,
+        T_Float64,
+        T_String,     // Length as varint + characters, appended to the string-table
+        T_StringRef,  // Index into the string-table as varint
+        T_Array,      // Number of elements as varint + elements
+        T_Object,     // Number of members as varint + pairs of key-strings and values
+    };
+
+    class Encoder
+    {
+    public:
+        Encoder(std::vector<uint8_t>& out)
+            : m_Out(out)
+        {
+        }
+
+        void writeValue(const json& j)
+        {
+            switch (j.type())
+            {
+                case json::value_t::boolean:
+                    m_Out.push_back(j.get<bool>() ? T_True : T_False);
+                    break;
+
+                case json::value_t::number_integer:
+                {
+                    int64_t v = j.get<json::number_integer_t>();
+                    m_Out.push_back(T_Int);
+                    writeVarint((static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63));
+                }
+                break;
+
+                case json::value_t::number_unsigned:
+                    m_Out.push_back(T_Unsigned);
+                    writeVarint(j.get<json::number_unsigned_t>());
+                    break;
+
+                case json::value_t::number_float:
+                {
+                    double v = j.get<json::number_float_t>();
+                    float f = static_cast<float>(v);
+
+                    // Most floats come from the engine as 32-bit values in the first place
+                    if (static_cast<double>(f) == v)
+                    {
+                        m_Out.push_back(T_Float32);
+                        writeRaw(&f, sizeof(f));
+                    }
+                    else
+                    {
+                        m_Out.push_back(T_Float64);
+                        writeRaw(&v, sizeof(v));
+                    }
+                }
+                break;
+
+                case json::value_t::string:
+                    writeString(j.get_ref<const json::string_t&>());
+                    break;
+
+                case json::value_t::array:
+                    m_Out.push_back(T_Array);
+                    writeVarint(j.size());
+
+                    for (const json& e : j)
+                        writeValue(e);
+                    break;
+
+                case json::value_t::object:
+                    m_Out.push_back(T_Object);
+                    writeVarint(j.size());
+
+                    for (auto it = j.begin(); it != j.end(); ++it)
+                    {
+                        writeString(it.key());
+                        writeValue(it.value());
+                    }
+                    break;
+
+                default:  // null and discarded
+                    m_Out.push_back(T_Null);
+                    break;
+            }
+        }
+
+    private:
+        void writeVarint(uint64_t v)
+        {
+            while (v >= 0x80)
+            {
+                m_Out.push_back(static_cast<uint8_t>(v | 0x80));
+                v >>= 7;
+            }
+
+            m_Out.push_back(static_cast<uint8_t>(v));
+        }
+
+        void writeRaw(const void* data, size_t size)
+        {
+            const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
+            m_Out.insert(m_Out.end(), p, p + size);
+        }
+
+        void writeString(const std::string& s)
+        {
+            auto it = m_StringIndices.find(s);
+            if (it != m_StringIndices.end())
+            {
+                m_Out.push_back(T_StringRef);
+                writeVarint((*it).second);
+                return;
+            }
+
+            m_StringIndices.emplace(s, static_cast<uint32_t>(m_StringIndices.size()));
+
+            m_Out.push_back(T_String);
+            writeVarint(s.size());
+            writeRaw(s.data(), s.size());
+        }
+
+        std::vector<uint8_t>& m_Out;
+        std::unordered_map<std::string, uint32_t> m_StringIndices;
+    };
+
+    class Decoder
+    {
+    public:
+        Decoder(const uint8_t* data, size_t size)
+            : m_Read(data)
+            , m_End(data + size)
+        {
+        }
+
+        bool readValue(json& out)
+        {
+            uint8_t tag;
+            if (!readByte(tag))
+                return false;
+
+            switch (tag)
+            {
+                case T_Null:
+                    out = nullptr;
+                    return true;
+
+                case T_False:
+                case T_True:
+                    out = (tag == T_True);
+                    return true;
+
+                case T_Int:
+                {
+                    uint64_t v;
+                    if (!readVarint(v))
+                        return false;
+
+                    out = static_cast<json::number_integer_t>((v >> 1) ^ (~(v & 1) + 1));
+                    return true;
+                }
+
+                case T_Unsigned:
+                {
+                    uint64_t v;
+                    if (!readVarint(v))
+                        return false;
+
+                    out = static_cast<json::number_unsigned_t>(v);
+                    return true;
+                }
+
+                case T_Float32:
+                {
+                    float f;
+                    if (!readRaw(&f, sizeof(f)))
+                        return false;
+
+                    out = static_cast<json::number_float_t>(f);
+                    return true;
+                }
+
+                case T_Float64:
+                {
+                    double d;
+                    if (!readRaw(&d, sizeof(d)))
+                        return false;
+
+                    out = static_cast<json::number_float_t>(d);
+                    return true;
+                }
+
+                case T_String:
+                case T_StringRef:
+                {
+                    const std::string* s = readString(tag);
+                    if (!s)
+                        return false;
+
+                    out = *s;
+                    return true;
+                }
+
+                case T_Array:
+                {
+                    uint64_t num;
+                    if (!readVarint(num) || num > remaining())  // Every element takes at least one byte
+                        return false;
+
+                    out = json::array();
+                    for (uint64_t i = 0; i < num; i++)
+                    {
+                        json e;
+                        if (!readValue(e))
+                            return false;
+
+                        out.push_back(std::move(e));
+                    }
+                    return true;
+                }
+
+                case T_Object:
+                {
+                    uint64_t num;
+                    if (!readVarint(num) || num > remaining())
+                        return false;
+
+                    out = json::object();
+                    for (uint64_t i = 0; i < num; i++)
+                    {
+                        uint8_t keyTag;
+                        if (!readByte(keyTag))
+                            return false;
+
+                        const std::string* key = readString(keyTag);
+                        if (!key)
+                            return false;
+
+                        json value;
+                        if (!readValue(value))
+                            return false;
+
+                        out[*key] = std::move(value);
+                    }
+                    return true;
+                }
+
+                default:
+                    return false;
+            }
+        }
+
+        bool readByte(uint8_t& b)
+        {
+            if (m_Read == m_End)
+                return false;
+
+            b = *m_Read++;
+            return true;
+        }
+
+        bool atEnd() const { return m_Read == m_End; }
+
+    private:
+        size_t remaining() const { return static_cast<size_t>(m_End - m_Read); }
+
+        bool readVarint(uint64_t& v)
+        {
+            v = 0;
+            for (unsigned shift = 0; shift < 64; shift += 7)
+            {
+                uint8_t b;
+                if (!readByte(b))
+                    return false;
+
+                v |= static_cast<uint64_t>(b & 0x7F) << shift;
+
+                if (!(b & 0x80))
+                    return true;
+            }
+
+            return false;
+        }
+
+        bool readRaw(void* out, size_t size)
+        {
+            if (remaining() < size)
+                return false;
+
+            memcpy(out, m_Read, size);
+            m_Read += size;
+            return true;
+        }
+
+        /**
+         * @return String read from the stream, nullptr on error
+         */
+        const std::string* readString(uint8_t tag)
+        {
+            uint64_t v;
+            if (!readVarint(v))
+                return nullptr;
+
+            if (tag == T_StringRef)
+                return v < m_Strings.size() ? &m_Strings[v] : nullptr;
+
+            if (tag != T_String || v > remaining())
+                return nullptr;
+
+            m_Strings.emplace_back(reinterpret_cast<const char*>(m_Read), static_cast<size_t>(v));
+            m_Read += v;
+
+            return &m_Strings.back();
+        }
+
+        const uint8_t* m_Read;
+        const uint8_t* m_End;
+        /**
+         * Strings read so far. A deque, so pointers to them stay valid while more are read.
+         */
+        std::deque<std::string> m_Strings;
+    };
+}
+
+std::vector<uint8_t> Utils::JsonBinary::encode(const json& j)
+{
+    std::vector<uint8_t> out;
+    out.push_back(FORMAT_VERSION);
+
+    Encoder(out).writeValue(j);
+
+    out.shrink_to_fit();
+    return out;
+}
+
+bool Utils::JsonBinary::decode(const std::vector<uint8_t>& data, json& out)
+{
+    Decoder d(data.data(), data.size());
+
+    uint8_t version;
+    if (!d.readByte(version) || version != FORMAT_VERSION)
+        return false;
+
+    return d.readValue(out) && d.atEnd();
+}
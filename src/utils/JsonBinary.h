@@ -0,0 +1,31 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <json/json.hpp>
+
+namespace Utils
+{
+    /**
+     * Compact binary encoding of json-documents, for keeping large documents in memory without the overhead of a
+     * json-tree, which needs a heap-allocation for every single value.
+     *
+     * Every string (keys included) is only stored the first time it occurs, later occurrences refer back to it.
+     * Integers are stored as varints, floats as 32-bit whenever that is lossless. Decoding gives back the exact
+     * same document.
+     */
+    namespace JsonBinary
+    {
+        /**
+         * @return The given document in binary form
+         */
+        std::vector<uint8_t> encode(const nlohmann::json& j);
+
+        /**
+         * Decodes a document created by encode()
+         * @param data Encoded document
+         * @param out Decoded document
+         * @return false, if the data is invalid or truncated
+         */
+        bool decode(const std::vector<uint8_t>& data, nlohmann::json& out);
+    }
+}
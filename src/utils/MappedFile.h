@@ -0,0 +1,44 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Utils
+{
+    /**
+     * Read-only view of a whole file, mapped into memory. The data is only paged in once it is accessed.
+     */
+    class MappedFile
+    {
+    public:
+        MappedFile();
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /**
+         * Maps the given file, unmapping the previous one
+         * @return false, if the file could not be opened or is empty
+         */
+        bool open(const std::string& file);
+
+        /**
+         * Unmaps the file. All pointers into it become invalid.
+         */
+        void close();
+
+        bool isOpen() const { return m_Data != nullptr; }
+        const uint8_t* getData() const { return m_Data; }
+        size_t getSize() const { return m_Size; }
+
+    private:
+        const uint8_t* m_Data;
+        size_t m_Size;
+
+#ifdef _WIN32
+        void* m_File;
+        void* m_Mapping;
+#endif
+    };
+}
@@ -1,6 +1,7 @@
 #include "Utils.h"
 #include <algorithm>
 #include <cctype>
+#include <cstdio>
 #include <fstream>
 #include <tinydir.h>
 #include <bgfx/bgfx.h>
@@ -253,6 +254,20 @@ bool Utils::mkdir(const std::string& dir)
     return nError == 0 || (nError == -1 && errorCode == EEXIST);
 }
 
+bool Utils::removeDirectory(const std::string& dir)
+{
+#if defined(_WIN32)
+    return ::_rmdir(dir.c_str()) == 0 || errno == ENOENT;
+#else
+    return ::rmdir(dir.c_str()) == 0 || errno == ENOENT;
+#endif
+}
+
+bool Utils::renamePath(const std::string& from, const std::string& to)
+{
+    return std::rename(from.c_str(), to.c_str()) == 0;
+}
+
 std::string Utils::getUserDataLocation()
 {
 #ifdef _WIN32
@@ -469,6 +469,18 @@ namespace Utils
      */
     bool mkdir(const std::string& dir);
 
+    /**
+     * Removes the given directory, which has to be empty
+     * @return True, if the directory is gone afterwards. Also true if it didn't exist in the first place.
+     */
+    bool removeDirectory(const std::string& dir);
+
+    /**
+     * Renames/moves a file or directory. The target must not exist.
+     * @return Whether the file or directory could be renamed
+     */
+    bool renamePath(const std::string& from, const std::string& to);
+
     /**
      * Grabs the directory where to put userdata like config-files or savegames.
      * Will be something like %APPDATA% on windows or $HOME on unix-based systems. Everything else will default to the current directory.